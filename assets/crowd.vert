@@ -0,0 +1,30 @@
+#version 430
+
+// default.vert for instanced draws: the model matrix of each instance comes
+// from a shader storage buffer (filled by crowd_update.comp or the CPU).
+
+layout( location = 0 ) in vec3 iPosition;
+layout( location = 1 ) in vec3 iColor;
+layout( location = 2 ) in vec3 iNormal;
+layout( location = 3 ) in vec2 iTexCoord;
+
+layout ( location = 0 ) uniform mat4 uProjCamera;
+
+layout ( std430, binding = 3 ) readonly buffer InstanceMatrices { mat4 instanceModel[]; };
+
+out vec3 v2fColor;
+out vec3 v2fNormal;
+out vec3 v2fPosition;
+out vec2 v2fTexCoord;
+
+void main()
+{
+	mat4 model = instanceModel[gl_InstanceID];
+	vec4 worldPosition = model * vec4(iPosition.xyz, 1.0);
+
+	v2fColor = iColor;
+	v2fNormal = normalize(mat3(model) * iNormal);
+	v2fPosition = worldPosition.xyz;
+	v2fTexCoord = iTexCoord;
+	gl_Position = uProjCamera * worldPosition;
+}
@@ -23,6 +23,9 @@ layout ( location = 2 ) uniform vec3 uCameraPosition;
 layout ( location = 3 ) uniform mat4 uMaterialData;
 layout ( location = 4 ) uniform pointLight uPointLightData[POINT_LIGHT_COUNT];
 uniform sampler2D uTexture;
+// scene textures; uTextureLayer selects the layer, or uTexture if negative
+layout ( binding = 1 ) uniform sampler2DArray uTextureArray;
+layout ( location = 13 ) uniform int uTextureLayer = -1;
 
 layout ( location = 0 ) out vec4 oColor;
 
@@ -71,10 +74,17 @@ vec3 pointLightContribution() {
 	return lightingOutput;
 }
 
+vec4 sample_texture(vec2 uv) {
+	if (uTextureLayer < 0) {
+		return texture(uTexture, uv);
+	}
+	return texture(uTextureArray, vec3(uv, float(uTextureLayer)));
+}
+
 void main()
 {
 	// full blinn-phong
-	oColor = (vec4(v2fNormal, 1.0) *1)+ (texture(uTexture, v2fTexCoord) *0 ) * (0 *vec4(pointLightContribution(), 1.0));
+	oColor = (vec4(v2fNormal, 1.0) *1)+ (sample_texture(v2fTexCoord) *0 ) * (0 *vec4(pointLightContribution(), 1.0));
 	
 	// normals debug view
 	// oColor = (vec4(v2fTexCoord.xy, 0.0, 0.0) *0)+ (texture(uTexture, v2fTexCoord) *0 ) + (1 *vec4(((pointLightContribution() * 0 + normalize(v2fNormal)) + (kE * v2fColor)), 1.0));
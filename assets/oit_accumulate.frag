@@ -0,0 +1,90 @@
+#version 430
+
+// Accumulation pass of weighted blended order-independent transparency
+// (McGuire & Bavoil 2013). Lighting matches correct_blinn-phong.frag.
+//
+// Blending (set up by the application):
+//   oAccum:  GL_ONE, GL_ONE
+//   oReveal: GL_ZERO, GL_ONE_MINUS_SRC_COLOR
+
+const float kPI = 3.1415926;
+#define POINT_LIGHT_COUNT 3
+
+struct pointLight {
+	vec3 position;
+	vec3 color;
+	float brightness;
+};
+
+in vec3 v2fColor;
+in vec3 v2fNormal;
+in vec3 v2fPosition;
+in vec2 v2fTexCoord;
+
+layout ( location = 2 ) uniform vec3 uCameraPosition;
+layout ( location = 3 ) uniform mat4 uMaterialData;
+layout ( location = 4 ) uniform pointLight uPointLightData[POINT_LIGHT_COUNT];
+uniform sampler2D uTexture;
+// scene textures; uTextureLayer selects the layer, or uTexture if negative
+layout ( binding = 1 ) uniform sampler2DArray uTextureArray;
+layout ( location = 13 ) uniform int uTextureLayer = -1;
+
+layout ( location = 0 ) out vec4 oAccum;
+layout ( location = 1 ) out float oReveal;
+
+vec3 kA = uMaterialData[0].xyz;
+vec3 kD = uMaterialData[1].xyz;
+vec3 kS = uMaterialData[2].xyz;
+vec3 kE = uMaterialData[3].xyz;
+float kAlphaPrime = uMaterialData[3].w;
+
+
+vec3 calculate_pointLight_contribution(pointLight light) {
+
+	vec3 L = normalize(light.position - v2fPosition);
+	vec3 V = normalize(uCameraPosition - v2fPosition);
+	vec3 N = normalize(v2fNormal);
+	vec3 H = normalize(L + V);
+
+	float dist = distance(v2fPosition, light.position);
+	float factorTerm = max( dot(N, L), 0 );
+	float specularTerm = max( dot(H, N), 0 );
+
+	vec3 ambient = kA;
+	vec3 diffuse = kD / kPI;
+	vec3 specular = kS * ((kAlphaPrime + 2) / 8) * pow( specularTerm, kAlphaPrime);
+
+	float falloff = 1 / (dist * dist);
+
+	return light.color * falloff * (ambient + (factorTerm * (diffuse + specular)));
+}
+
+vec3 pointLightContribution() {
+	vec3 lightingOutput = vec3(0.0);
+	for (int i = 0; i < POINT_LIGHT_COUNT; i++) {
+		lightingOutput += calculate_pointLight_contribution(uPointLightData[i]);
+	}
+	return lightingOutput;
+}
+
+vec4 sample_texture(vec2 uv) {
+	if (uTextureLayer < 0) {
+		return texture(uTexture, uv);
+	}
+	return texture(uTextureArray, vec3(uv, float(uTextureLayer)));
+}
+
+void main()
+{
+	vec4 texel = sample_texture(v2fTexCoord);
+	vec3 color = texel.rgb * ((pointLightContribution() * v2fColor) + (kE * v2fColor));
+	float alpha = texel.a;
+
+	// depth weight, equation (10) of the paper; favours surfaces close to
+	// the camera without needing any sorting
+	float weight = clamp(pow(min(1.0, alpha * 10.0) + 0.01, 3.0) * 1e8
+		* pow(1.0 - gl_FragCoord.z * 0.9, 3.0), 1e-2, 3e3);
+
+	oAccum = vec4(color * alpha, alpha) * weight;
+	oReveal = alpha;
+}
@@ -0,0 +1,28 @@
+#version 430
+
+// Composite pass of weighted blended order-independent transparency. Drawn
+// over the opaque image with blending GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA.
+
+layout ( binding = 0 ) uniform sampler2D uAccum;
+layout ( binding = 1 ) uniform sampler2D uReveal;
+
+layout ( location = 0 ) out vec4 oColor;
+
+void main()
+{
+	ivec2 texel = ivec2(gl_FragCoord.xy);
+	float revealage = texelFetch(uReveal, texel, 0).r;
+
+	// nothing translucent covers this pixel
+	if (revealage >= 1.0)
+		discard;
+
+	vec4 accum = texelFetch(uAccum, texel, 0);
+
+	// avoid overflow to inf in the accumulation target
+	if (isinf(max(max(abs(accum.r), abs(accum.g)), abs(accum.b))))
+		accum.rgb = vec3(accum.a);
+
+	vec3 averageColor = accum.rgb / max(accum.a, 1e-5);
+	oColor = vec4(averageColor, revealage);
+}
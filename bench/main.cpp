@@ -0,0 +1,219 @@
+#include <array>
+#include <random>
+#include <typeinfo>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../support/error.hpp"
+
+#include "../vmlib/vec3.hpp"
+#include "../vmlib/vec4.hpp"
+#include "../vmlib/mat44.hpp"
+#include "../vmlib/quat.hpp"
+#include "../vmlib/constants.hpp"
+
+#include "../main/easing.hpp"
+#include "../main/animation_system.hpp"
+#include "../main/loadobj.hpp"
+
+#include "micro_bench.hpp"
+
+// Micro-benchmarks of CPU kernels: vmlib, the OBJ loader and the animation
+// code. Nothing here creates a window or GL context, so it runs on headless
+// machines. Usage:
+//
+//   bench [filter] [--samples N] [--quick] [--assets DIR]
+//
+// Only kernels whose name contains the filter are run. Run from the
+// repository root (or pass --assets) for the loader benchmarks.
+namespace
+{
+	// inputs are cycled through, so that nothing is a compile-time constant
+	// and all of them stay in L1
+	constexpr size_t kInputs = 256;
+	constexpr size_t kInputMask = kInputs - 1;
+
+	// AnimationObj::interpolate() is ease() with the object's style
+	char const* const kEaseNames[kInterpolationStyleCount] = {
+		"ease(LINEAR)", "ease(S_CURVE)", "ease(CUBIC)",
+		"ease(SINUSOIDAL)", "ease(INVERSE)", "ease(RECIPROCAL)"
+	};
+	char const* const kEaseBatchNames[kInterpolationStyleCount] = {
+		"ease_batch(LINEAR) per value", "ease_batch(S_CURVE) per value", "ease_batch(CUBIC) per value",
+		"ease_batch(SINUSOIDAL) per value", "ease_batch(INVERSE) per value", "ease_batch(RECIPROCAL) per value"
+	};
+
+	struct Inputs_
+	{
+		std::array<Mat44f, kInputs> matrices;
+		std::array<Vec4f, kInputs> points;
+		std::array<Vec3f, kInputs> vectors;
+		std::array<Vec3f, kInputs> angles;
+		std::array<Quatf, kInputs> rotations;
+		std::array<float, kInputs> factors;
+	};
+
+	Inputs_ make_inputs_()
+	{
+		std::mt19937 random(3811);
+		std::uniform_real_distribution<float> unit(-1.f, 1.f);
+		std::uniform_real_distribution<float> angle(-kPi, kPi);
+
+		Inputs_ inputs;
+		for (size_t i = 0; i < kInputs; i++)
+		{
+			for (auto& v : inputs.matrices[i].v) v = unit(random);
+			inputs.points[i] = { unit(random), unit(random), unit(random), 1.f };
+			inputs.vectors[i] = { unit(random), unit(random), unit(random) + 2.f };
+			inputs.angles[i] = { angle(random), angle(random), angle(random) };
+			inputs.rotations[i] = make_quat_euler(inputs.angles[i]);
+			inputs.factors[i] = 0.5f * (unit(random) + 1.f);
+		}
+		return inputs;
+	}
+
+	void run_vmlib_(MicroBench& aBench, const Inputs_& aIn)
+	{
+		aBench.run("Mat44f * Mat44f", [&] (std::uint64_t i) {
+			do_not_optimize(aIn.matrices[i & kInputMask] * aIn.matrices[(i + 1) & kInputMask]);
+		});
+		aBench.run("Mat44f * Vec4f", [&] (std::uint64_t i) {
+			do_not_optimize(aIn.matrices[i & kInputMask] * aIn.points[(i + 1) & kInputMask]);
+		});
+		aBench.run("normalize(Vec3f)", [&] (std::uint64_t i) {
+			do_not_optimize(normalize(aIn.vectors[i & kInputMask]));
+		});
+		aBench.run("make_perspective_projection", [&] (std::uint64_t i) {
+			float const fov = 0.5f + aIn.factors[i & kInputMask];
+			do_not_optimize(make_perspective_projection(fov, 16.f / 9.f, 0.1f, 100.f));
+		});
+		aBench.run("make_rotation_z * _y * _x (Euler)", [&] (std::uint64_t i) {
+			Vec3f const a = aIn.angles[i & kInputMask];
+			do_not_optimize(make_rotation_z(a.z) * make_rotation_y(a.y) * make_rotation_x(a.x));
+		});
+		aBench.run("make_quat_euler", [&] (std::uint64_t i) {
+			do_not_optimize(make_quat_euler(aIn.angles[i & kInputMask]));
+		});
+		aBench.run("make_rotation(Quatf)", [&] (std::uint64_t i) {
+			do_not_optimize(make_rotation(aIn.rotations[i & kInputMask]));
+		});
+		aBench.run("slerp(Quatf)", [&] (std::uint64_t i) {
+			do_not_optimize(slerp(aIn.rotations[i & kInputMask], aIn.rotations[(i + 1) & kInputMask], aIn.factors[i & kInputMask]));
+		});
+	}
+
+	void run_animation_(MicroBench& aBench, const Inputs_& aIn)
+	{
+		for (size_t style = 0; style < kInterpolationStyleCount; style++)
+		{
+			aBench.run(kEaseNames[style], [&] (std::uint64_t i) {
+				do_not_optimize(ease(INTERPOLATION_STYLE(style), aIn.factors[i & kInputMask]));
+			});
+		}
+
+		std::vector<float> eased(kInputs);
+		for (size_t style = 0; style < kInterpolationStyleCount; style++)
+		{
+			aBench.run(kEaseBatchNames[style], [&] (std::uint64_t) {
+				ease_batch(INTERPOLATION_STYLE(style), aIn.factors.data(), eased.data(), kInputs);
+				do_not_optimize(eased.front());
+			}, kInputs);
+		}
+
+		// channels as SceneSimulation adds them for the stress test
+		constexpr size_t kChannels = 10000;
+		AnimationSystem system;
+		for (size_t i = 0; i < kChannels; i++)
+		{
+			AnimationChannel channel;
+			channel.positionEnd = { float(i % 100), 0.f, float(i / 100) };
+			channel.rotationEnd = make_quat_rotation_y(0.5f * kPi);
+			channel.duration = float(100 + i % 300) / kAnimationStepsPerSecond;
+			channel.interpolationStyle = INTERPOLATION_STYLE(i % kInterpolationStyleCount);
+			channel.animationStyle = (i % 2) ? BOUNCE : REPEAT;
+			system.add(channel);
+		}
+		aBench.run("AnimationSystem::update per channel", [&] (std::uint64_t i) {
+			system.update(float(i) * (1.f / 60.f));
+			do_not_optimize(system.get(AnimationHandle(i % kChannels)));
+		}, kChannels);
+	}
+
+	void run_loaders_(MicroBench& aBench, const std::string& aAssets)
+	{
+		char const* const kModels[] = { "globe-sphere.obj", "Armadillo.obj" };
+		char const* const kNames[] = { "load_wavefront_obj(globe-sphere.obj)", "load_wavefront_obj(Armadillo.obj)" };
+
+		for (size_t i = 0; i < 2; i++)
+		{
+			std::string const path = aAssets + "/" + kModels[i];
+			if (std::FILE* file = std::fopen(path.c_str(), "rb"))
+			{
+				std::fclose(file);
+			}
+			else
+			{
+				std::fprintf(stderr, "Skipping %s: '%s' not found\n", kNames[i], path.c_str());
+				continue;
+			}
+
+			aBench.runOnce(kNames[i], [&] {
+				SimpleMeshData const mesh = load_wavefront_obj(path.c_str());
+				do_not_optimize(mesh.positions.size());
+			}, 10);
+		}
+	}
+}
+
+int main(int aArgc, char** aArgv) try
+{
+	MicroBenchOptions options;
+	std::string assets = "assets";
+
+	for (int i = 1; i < aArgc; i++)
+	{
+		if (std::strcmp(aArgv[i], "--quick") == 0)
+		{
+			options.warmupSeconds = 0.01;
+			options.sampleSeconds = 0.002;
+			options.samples = 10;
+		}
+		else if (std::strcmp(aArgv[i], "--samples") == 0 && i + 1 < aArgc)
+		{
+			options.samples = std::max(1, std::atoi(aArgv[++i]));
+		}
+		else if (std::strcmp(aArgv[i], "--assets") == 0 && i + 1 < aArgc)
+		{
+			assets = aArgv[++i];
+		}
+		else if (aArgv[i][0] == '-')
+		{
+			throw Error("Unknown argument '%s'", aArgv[i]);
+		}
+		else
+		{
+			options.filter = aArgv[i];
+		}
+	}
+
+	Inputs_ const inputs = make_inputs_();
+
+	MicroBench bench(options);
+	run_vmlib_(bench, inputs);
+	run_animation_(bench, inputs);
+	run_loaders_(bench, assets);
+	bench.print();
+
+	return 0;
+}
+catch( std::exception const& eErr )
+{
+	std::fprintf( stderr, "Top-level Exception (%s):\n", typeid(eErr).name() );
+	std::fprintf( stderr, "%s\n", eErr.what() );
+	std::fprintf( stderr, "Bye.\n" );
+	return 1;
+}
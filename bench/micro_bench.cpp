@@ -0,0 +1,80 @@
+#include "micro_bench.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+	MicroBenchResult summarise_(const char* aName, std::uint64_t aOperations, std::vector<double> aNs, std::vector<double> aCycles)
+	{
+		MicroBenchResult result;
+		result.name = aName;
+		result.operations = aOperations;
+		result.samples = int(aNs.size());
+		if (aNs.empty()) return result;
+
+		std::sort(aNs.begin(), aNs.end());
+		std::sort(aCycles.begin(), aCycles.end());
+
+		double sum = 0.0;
+		for (double ns : aNs) sum += ns;
+		double const mean = sum / double(aNs.size());
+		double squares = 0.0;
+		for (double ns : aNs) squares += (ns - mean) * (ns - mean);
+
+		size_t const p95 = std::min(aNs.size() - 1, size_t(std::ceil(0.95 * double(aNs.size()))) - 1);
+
+		result.minNs = aNs.front();
+		result.medianNs = aNs[aNs.size() / 2];
+		result.meanNs = mean;
+		result.stddevNs = aNs.size() > 1 ? std::sqrt(squares / double(aNs.size() - 1)) : 0.0;
+		result.p95Ns = aNs[p95];
+		result.cycles = aCycles[aCycles.size() / 2];
+		return result;
+	}
+}
+
+bool MicroBench::skip(const char* aName) const
+{
+	return !options.filter.empty() && std::string(aName).find(options.filter) == std::string::npos;
+}
+
+void MicroBench::record(const char* aName, std::uint64_t aOperations, std::vector<double> aNs, std::vector<double> aCycles)
+{
+	results.push_back(summarise_(aName, aOperations, std::move(aNs), std::move(aCycles)));
+}
+
+void MicroBench::runOnce(const char* aName, const std::function<void()>& aOperation, int aSamples)
+{
+	if (skip(aName)) return;
+
+	aOperation();
+
+	std::vector<double> ns, cycles;
+	for (int s = 0; s < aSamples; s++)
+	{
+		auto const start = Clock::now();
+		std::uint64_t const startCycles = read_cycle_counter();
+		aOperation();
+		std::uint64_t const endCycles = read_cycle_counter();
+
+		ns.push_back(secondsSince(start) * 1e9);
+		cycles.push_back(double(endCycles - startCycles));
+	}
+
+	record(aName, 1, std::move(ns), std::move(cycles));
+}
+
+void MicroBench::print() const
+{
+	std::printf("%-40s %10s %12s %12s %12s %12s %12s %12s\n",
+		"kernel", "ops/sample", "min ns", "median ns", "mean ns", "stddev ns", "p95 ns", "cycles");
+
+	for (auto const& r : results)
+	{
+		std::printf("%-40s %10llu %12.3f %12.3f %12.3f %12.3f %12.3f ",
+			r.name.c_str(), static_cast<unsigned long long>(r.operations), r.minNs, r.medianNs, r.meanNs, r.stddevNs, r.p95Ns);
+		if (r.cycles > 0.0) std::printf("%12.1f\n", r.cycles);
+		else std::printf("%12s\n", "n/a");
+	}
+}
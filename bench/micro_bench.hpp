@@ -0,0 +1,143 @@
+#ifndef MICRO_BENCH_HEADER_FILE
+#define MICRO_BENCH_HEADER_FILE
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#if defined(_MSC_VER)
+#	include <intrin.h>
+#endif
+
+// Keeps the compiler from optimising away a result that is otherwise unused.
+template< typename tType >
+inline void do_not_optimize(tType const& aValue)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(aValue) : "memory");
+#else
+	static void const* volatile sink;
+	sink = &aValue;
+	_ReadWriteBarrier();
+#endif
+}
+
+// Time stamp counter, or 0 where there is none. On current x86 CPUs it
+// counts at a constant rate, so these are reference cycles: comparable
+// between runs on one machine, but not the same as core clock cycles while
+// the CPU boosts or throttles.
+inline std::uint64_t read_cycle_counter()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	return __rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	return __builtin_ia32_rdtsc();
+#else
+	return 0;
+#endif
+}
+
+struct MicroBenchOptions
+{
+	// time spent running a kernel before measuring; also used to pick the
+	// batch size, so that one sample takes about sampleSeconds
+	double warmupSeconds = 0.05;
+	double sampleSeconds = 0.01;
+	int samples = 30;
+	// only run kernels whose name contains this
+	std::string filter;
+};
+
+// Per-operation times over all samples of one kernel.
+struct MicroBenchResult
+{
+	std::string name;
+	// operations timed per sample
+	std::uint64_t operations = 0;
+	int samples = 0;
+	double minNs = 0.0;
+	double medianNs = 0.0;
+	double meanNs = 0.0;
+	double stddevNs = 0.0;
+	double p95Ns = 0.0;
+	// median; 0 without a cycle counter
+	double cycles = 0.0;
+};
+
+// Runs kernels and prints a table of their results. A kernel does one
+// operation per call of aOperation(i), where i counts the calls, and passes
+// its result to do_not_optimize(). Each sample times a batch of calls, so
+// the clock overhead is spread over many operations; the kernel is a
+// template argument so that the calls are inlined.
+class MicroBench
+{
+	using Clock = std::chrono::steady_clock;
+
+	MicroBenchOptions options;
+	std::vector<MicroBenchResult> results;
+
+	bool skip(const char* aName) const;
+	void record(const char* aName, std::uint64_t aOperations, std::vector<double> aNs, std::vector<double> aCycles);
+
+	static double secondsSince(Clock::time_point aStart)
+	{
+		return std::chrono::duration<double>(Clock::now() - aStart).count();
+	}
+
+public:
+	explicit MicroBench(MicroBenchOptions aOptions) : options(std::move(aOptions)) {}
+
+	// aOperationsPerCall scales the results for kernels that do a whole
+	// array of operations per call
+	template< typename tOperation >
+	void run(const char* aName, tOperation&& aOperation, std::uint64_t aOperationsPerCall = 1)
+	{
+		if (skip(aName)) return;
+
+		// warm up caches, branch predictors and clocks, and count how many
+		// calls fit into one sample
+		std::uint64_t calls = 0;
+		auto const warmupStart = Clock::now();
+		while (secondsSince(warmupStart) < options.warmupSeconds)
+		{
+			for (std::uint64_t i = 0; i < 64; i++) aOperation(calls + i);
+			calls += 64;
+		}
+		double const perCall = secondsSince(warmupStart) / double(calls);
+		std::uint64_t const batch = std::max<std::uint64_t>(1, std::uint64_t(options.sampleSeconds / perCall));
+		double const operations = double(batch) * double(aOperationsPerCall);
+
+		std::vector<double> ns, cycles;
+		for (int s = 0; s < options.samples; s++)
+		{
+			auto const start = Clock::now();
+			std::uint64_t const startCycles = read_cycle_counter();
+			for (std::uint64_t i = 0; i < batch; i++)
+			{
+				aOperation(calls + i);
+			}
+			std::uint64_t const endCycles = read_cycle_counter();
+			double const elapsed = secondsSince(start);
+			calls += batch;
+
+			ns.push_back(elapsed * 1e9 / operations);
+			cycles.push_back(double(endCycles - startCycles) / operations);
+		}
+
+		record(aName, batch * aOperationsPerCall, std::move(ns), std::move(cycles));
+	}
+
+	// for kernels too slow to batch, e.g. loading a file: one untimed call,
+	// then aSamples timed ones
+	void runOnce(const char* aName, const std::function<void()>& aOperation, int aSamples);
+
+	const std::vector<MicroBenchResult>& all() const { return results; }
+	void print() const;
+};
+
+#endif//MICRO_BENCH_HEADER_FILE
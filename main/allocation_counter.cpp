@@ -0,0 +1,108 @@
+#include "allocation_counter.hpp"
+
+#include <cstdio>
+
+#if defined(COUNT_ALLOCATIONS)
+#	include <new>
+#	include <atomic>
+#	include <cstdlib>
+
+namespace
+{
+	std::atomic<std::size_t> gAllocations{ 0 };
+	std::atomic<std::size_t> gBytes{ 0 };
+
+	void* counted_allocate_(std::size_t aSize)
+	{
+		gAllocations.fetch_add(1, std::memory_order_relaxed);
+		gBytes.fetch_add(aSize, std::memory_order_relaxed);
+		return std::malloc(aSize ? aSize : 1);
+	}
+
+	void* counted_allocate_aligned_(std::size_t aSize, std::align_val_t aAlignment)
+	{
+		gAllocations.fetch_add(1, std::memory_order_relaxed);
+		gBytes.fetch_add(aSize, std::memory_order_relaxed);
+
+		std::size_t const alignment = std::size_t(aAlignment);
+#	if defined(_MSC_VER)
+		return _aligned_malloc(aSize ? aSize : 1, alignment);
+#	else
+		// aligned_alloc() needs a multiple of the alignment
+		std::size_t const size = (aSize + alignment - 1) / alignment * alignment;
+		return std::aligned_alloc(alignment, size ? size : alignment);
+#	endif
+	}
+
+	void release_aligned_(void* aPointer)
+	{
+#	if defined(_MSC_VER)
+		_aligned_free(aPointer);
+#	else
+		std::free(aPointer);
+#	endif
+	}
+}
+
+void* operator new(std::size_t aSize)
+{
+	if (void* pointer = counted_allocate_(aSize)) return pointer;
+	throw std::bad_alloc();
+}
+void* operator new[](std::size_t aSize)
+{
+	return operator new(aSize);
+}
+void* operator new(std::size_t aSize, std::nothrow_t const&) noexcept
+{
+	return counted_allocate_(aSize);
+}
+void* operator new[](std::size_t aSize, std::nothrow_t const&) noexcept
+{
+	return counted_allocate_(aSize);
+}
+void* operator new(std::size_t aSize, std::align_val_t aAlignment)
+{
+	if (void* pointer = counted_allocate_aligned_(aSize, aAlignment)) return pointer;
+	throw std::bad_alloc();
+}
+void* operator new[](std::size_t aSize, std::align_val_t aAlignment)
+{
+	return operator new(aSize, aAlignment);
+}
+
+void operator delete(void* aPointer) noexcept { std::free(aPointer); }
+void operator delete[](void* aPointer) noexcept { std::free(aPointer); }
+void operator delete(void* aPointer, std::size_t) noexcept { std::free(aPointer); }
+void operator delete[](void* aPointer, std::size_t) noexcept { std::free(aPointer); }
+void operator delete(void* aPointer, std::nothrow_t const&) noexcept { std::free(aPointer); }
+void operator delete[](void* aPointer, std::nothrow_t const&) noexcept { std::free(aPointer); }
+void operator delete(void* aPointer, std::align_val_t) noexcept { release_aligned_(aPointer); }
+void operator delete[](void* aPointer, std::align_val_t) noexcept { release_aligned_(aPointer); }
+void operator delete(void* aPointer, std::size_t, std::align_val_t) noexcept { release_aligned_(aPointer); }
+void operator delete[](void* aPointer, std::size_t, std::align_val_t) noexcept { release_aligned_(aPointer); }
+
+AllocationCounts allocation_counts()
+{
+	return { gAllocations.load(std::memory_order_relaxed), gBytes.load(std::memory_order_relaxed) };
+}
+#else
+AllocationCounts allocation_counts()
+{
+	return {};
+}
+#endif
+
+ScopedAllocationReport::ScopedAllocationReport(char const* aLabel)
+	: label(aLabel)
+	, start(allocation_counts())
+{
+}
+
+ScopedAllocationReport::~ScopedAllocationReport()
+{
+	if (!kCountAllocations) return;
+
+	AllocationCounts const used = allocation_counts() - start;
+	std::printf("allocations: %s: %zu allocations, %zu bytes\n", label, used.allocations, used.bytes);
+}
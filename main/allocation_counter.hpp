@@ -0,0 +1,46 @@
+#ifndef ALLOCATION_COUNTER_HEADER_FILE
+#define ALLOCATION_COUNTER_HEADER_FILE
+
+#include <cstddef>
+
+// Heap allocation statistics. In builds with COUNT_ALLOCATIONS defined
+// (premake5 --count-allocs ...) the global operator new/delete are replaced
+// by counting versions; otherwise all counts stay zero and the reports
+// below compile to nothing.
+
+#if defined(COUNT_ALLOCATIONS)
+constexpr bool kCountAllocations = true;
+#else
+constexpr bool kCountAllocations = false;
+#endif
+
+struct AllocationCounts
+{
+	std::size_t allocations = 0;
+	std::size_t bytes = 0;
+};
+
+// totals since program start, over all threads
+AllocationCounts allocation_counts();
+
+inline AllocationCounts operator-(AllocationCounts aLeft, AllocationCounts aRight)
+{
+	return { aLeft.allocations - aRight.allocations, aLeft.bytes - aRight.bytes };
+}
+
+// Prints the allocations made (by all threads) during its lifetime, e.g.
+// "allocations: assets/streetlamp.obj: 1234 allocations, 5678 bytes".
+class ScopedAllocationReport
+{
+	char const* label;
+	AllocationCounts start;
+
+public:
+	explicit ScopedAllocationReport(char const* aLabel);
+	~ScopedAllocationReport();
+
+	ScopedAllocationReport(const ScopedAllocationReport&) = delete;
+	ScopedAllocationReport& operator=(const ScopedAllocationReport&) = delete;
+};
+
+#endif//ALLOCATION_COUNTER_HEADER_FILE
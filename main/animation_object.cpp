@@ -1,61 +1,23 @@
 #include "animation_object.hpp"
 
+#include <algorithm>
+
 float AnimationObj::interpolate(float in)
 {
-	if (in < 0) in = 0;
-	else if (in > 1) in = 1;
-
-	float out = 0;
-
-	switch (this->interpolationStyle)
-	{
-	case LINEAR:
-		{
-			out = in;
-			break;
-		}
-	case S_CURVE:
-		{
-			const float kEuler = 2.718281828;
-			float denom = 1 + powf(kEuler, -10.f * (in - 0.5f));
-			out = 1 / denom;
-			break;
-		}
-	case CUBIC:
-		{
-			out = in;
-			break;
-		}
-	case SINUSOIDAL:
-		{
-			const float u = (3 * in) - 1.5f;
-			out = u - (0.166666f * powf(u, 3.f)) + (0.008333f * powf(u, 5.f));
-			out = (0.5f * out) + 0.5f;
-			break;
-		}
-	case INVERSE:
-		{
-			float denom = 1.f - (0.5f * in);
-			out = (1.f / denom) - 1.f;
-			break;
-		}
-	case RECIPROCAL:
-		{
-			float denom = -(2.f * in + 0.74f);
-			out = (1.f / denom) + 1.36f;
-			break;
-		}
-	}
-
-	if (out > 1) out = 1;
-	else if (out < 0) out = 0;
-	return out;
+	return ease(this->interpolationStyle, in);
 }
 
 void AnimationObj::setRotationAnchors(std::optional<Vec3f> aRotStart, std::optional<Vec3f> aRotEnd)
 {
-	if (aRotStart) rotationStart = *aRotStart;
-	if (aRotEnd) rotationEnd = *aRotEnd;
+	if (aRotStart) rotationStart = make_quat_euler(*aRotStart);
+	if (aRotEnd) rotationEnd = make_quat_euler(*aRotEnd);
+	rotationSet = true;
+}
+
+void AnimationObj::setRotationAnchors(Quatf aRotStart, Quatf aRotEnd)
+{
+	rotationStart = aRotStart;
+	rotationEnd = aRotEnd;
 	rotationSet = true;
 }
 
@@ -76,45 +38,30 @@ void AnimationObj::setScaleAnchors(std::optional<Vec3f> aScaleStart, std::option
 
 void AnimationObj::setupAnimation(size_t aSteps, INTERPOLATION_STYLE aIntStyle, ANIMATION_STYLE aAnimStyle)
 {
-	currentStep = 0;
-	totalSteps = aSteps;
+	duration = float(std::max<size_t>(aSteps, 1)) / kAnimationStepsPerSecond;
 
 	interpolationStyle = aIntStyle;
 	animationStyle = aAnimStyle;
 }
 
-void AnimationObj::updateAnimation(int speed)
+void AnimationObj::updateAnimation(float aTime)
 {
-	currentStep += speed;
+	bool reversed;
+	float const progress = animation_progress(animationStyle, aTime / duration, reversed);
 
-	if (currentStep >= totalSteps)
-	{
-		switch (animationStyle)
-		{
-			case STOP: return;
-			case BOUNCE:
-				{
-					if (rotationSet) std::swap(rotationStart, rotationEnd);
-					if (positionSet) std::swap(positionStart, positionEnd);
-					if (scaleSet) std::swap(scaleStart, scaleEnd);
-					// falls thru on purpose
-					[[clang::fallthrough]];
-				}
-			case REPEAT:
-				{
-					currentStep = 0;
-				}
-		}
-	}
-	
+	// running backwards is the same curve with the anchors swapped
+	float const t = interpolate(progress);
+	applyAnchors(reversed ? 1.f - t : t);
+}
 
-	float input = static_cast<float>(currentStep) / static_cast<float>(totalSteps);
-	float t = interpolate(input);
+void AnimationObj::applyAnchors(float aFactor)
+{
+	float const t = aFactor;
 
 	if (rotationSet)
 	{
 		this->transform.setRotation(
-			(1-t) * rotationStart + (t) * rotationEnd
+			slerp(rotationStart, rotationEnd, t)
 		);
 	}
 	if (positionSet)
@@ -130,3 +77,41 @@ void AnimationObj::updateAnimation(int speed)
 		);
 	}
 }
+
+AnimationChannel AnimationObj::channel()
+{
+	AnimationChannel channel;
+
+	channel.positionStart = channel.positionEnd = this->transform.getPosition();
+	channel.rotationStart = channel.rotationEnd = this->transform.getRotation();
+	channel.scaleStart = channel.scaleEnd = this->transform.getScale();
+
+	if (rotationSet)
+	{
+		channel.rotationStart = rotationStart;
+		channel.rotationEnd = rotationEnd;
+	}
+	if (positionSet)
+	{
+		channel.positionStart = positionStart;
+		channel.positionEnd = positionEnd;
+	}
+	if (scaleSet)
+	{
+		channel.scaleStart = scaleStart;
+		channel.scaleEnd = scaleEnd;
+	}
+
+	channel.duration = duration;
+	channel.interpolationStyle = interpolationStyle;
+	channel.animationStyle = animationStyle;
+
+	return channel;
+}
+
+void AnimationObj::applyAnimation(const AnimatedTransform& aTransform)
+{
+	this->transform.setPosition(aTransform.position);
+	this->transform.setRotation(aTransform.rotation);
+	this->transform.setScale(aTransform.scale);
+}
@@ -2,23 +2,8 @@
 #define ANIMATION_OBJECT_HEADER_FILE
 
 #include "scene_object.hpp"
-
-enum INTERPOLATION_STYLE
-{
-	LINEAR,
-	S_CURVE,
-	CUBIC,
-	SINUSOIDAL,
-	INVERSE,
-	RECIPROCAL
-};
-
-enum ANIMATION_STYLE
-{
-	STOP,
-	REPEAT,
-	BOUNCE
-};
+#include "easing.hpp"
+#include "animation_system.hpp"
 
 class AnimationObj : public SceneObj
 {
@@ -30,18 +15,34 @@ class AnimationObj : public SceneObj
 	float interpolate(float in);
 
 protected:
-	Vec3f rotationStart, rotationEnd;
+	// slerped, so they always turn the shorter way round
+	Quatf rotationStart = kIdentityQuatf, rotationEnd = kIdentityQuatf;
 	Vec3f positionStart, positionEnd;
 	Vec3f scaleStart, scaleEnd;
-	size_t currentStep = 0;
-	size_t totalSteps = 1;
+	// length of one cycle, in seconds
+	float duration = 1.f;
 	ANIMATION_STYLE animationStyle;
+
+	// sets the transform to the anchors interpolated by aFactor
+	void applyAnchors(float aFactor);
 public:
+	// Euler angles, as for Transform::setRotation(); anchors half a turn or
+	// more apart are blended the shorter way, not the way the angles count
 	void setRotationAnchors(std::optional<Vec3f> aRotStart = std::nullopt, std::optional<Vec3f> aRotEnd = std::nullopt);
+	void setRotationAnchors(Quatf aRotStart, Quatf aRotEnd);
 	void setPositionAnchors(std::optional<Vec3f> aPosStart = std::nullopt, std::optional<Vec3f> aPosEnd = std::nullopt);
 	void setScaleAnchors(std::optional<Vec3f> aScaleStart = std::nullopt, std::optional<Vec3f> aScaleEnd = std::nullopt);
+	// aSteps is the length of one cycle in steps of kAnimationStepsPerSecond
 	void setupAnimation(size_t aSteps, INTERPOLATION_STYLE aIntStyle, ANIMATION_STYLE aAnimStyle = STOP);
-	void updateAnimation(int speed);
+	// evaluate the animation at aTime seconds after it started. Any time can
+	// be evaluated, in any order.
+	void updateAnimation(float aTime);
+
+	// the animation as set up above, for evaluation by an AnimationSystem
+	// instead of updateAnimation()
+	AnimationChannel channel();
+	// take the result of evaluating channel()
+	void applyAnimation(const AnimatedTransform& aTransform);
 
 };
 
@@ -0,0 +1,193 @@
+#include "animation_system.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+	// sin() on [0, pi/2] from its Taylor series up to x^11; the remainder
+	// is below 6e-8 there, and near 0 the relative error stays at float
+	// rounding. Unlike std::sin() it vectorises.
+	inline float sin_quadrant_(float aX)
+	{
+		float const x2 = aX * aX;
+		return aX * (1.f + x2 * (-1.f / 6.f + x2 * (1.f / 120.f + x2 * (-1.f / 5040.f
+			+ x2 * (1.f / 362880.f + x2 * (-1.f / 39916800.f))))));
+	}
+
+	// std::floor() for aX >= 0. Without -fno-trapping-math, GCC keeps
+	// std::floor() scalar; adding and taking away 2^23 rounds to an integer
+	// instead, and from 2^23 on every float is one.
+	inline float floor_non_negative_(float aX)
+	{
+		float const rounded = (aX + 8388608.f) - 8388608.f;
+		float const floored = rounded > aX ? rounded - 1.f : rounded;
+		return aX < 8388608.f ? floored : aX;
+	}
+}
+
+AnimationHandle AnimationSystem::add(const AnimationChannel& aChannel)
+{
+	auto& group = groups[aChannel.interpolationStyle];
+
+	slots.push_back({ std::uint32_t(aChannel.interpolationStyle), std::uint32_t(group.size()) });
+
+	group.rate.push_back(1.f / std::max(aChannel.duration, 1e-3f));
+	group.stop.push_back(aChannel.animationStyle == STOP ? 1.f : 0.f);
+	group.bounce.push_back(aChannel.animationStyle == BOUNCE ? 1.f : 0.f);
+	group.reversed.push_back(0.f);
+	group.eased.push_back(0.f);
+	group.weightFrom.push_back(1.f);
+	group.weightTo.push_back(0.f);
+
+	Vec3f const starts[] = { aChannel.positionStart, aChannel.scaleStart };
+	Vec3f const ends[] = { aChannel.positionEnd, aChannel.scaleEnd };
+
+	for (size_t i = 0; i < 2; i++)
+	{
+		Vec3f const delta = ends[i] - starts[i];
+		float const startComponents[] = { starts[i].x, starts[i].y, starts[i].z };
+		float const deltaComponents[] = { delta.x, delta.y, delta.z };
+
+		for (size_t j = 0; j < 3; j++)
+		{
+			group.start[i * 3 + j].push_back(startComponents[j]);
+			group.delta[i * 3 + j].push_back(deltaComponents[j]);
+			group.value[i * 3 + j].push_back(startComponents[j]);
+			group.animated[i * 3 + j] = group.animated[i * 3 + j] || deltaComponents[j] != 0.f;
+		}
+	}
+
+	// as slerp(), including the shorter way round, but the arc comes from
+	// atan2() rather than acos(), which loses most of its precision for
+	// short arcs. Below 1e-3 a plain lerp is used; it is then unit length
+	// to within 1.3e-7, so get() need not normalize.
+	Quatf const from = aChannel.rotationStart;
+	Quatf to = aChannel.rotationEnd;
+	if (dot(from, to) < 0.f)
+	{
+		to = -to;
+	}
+	Quatf const difference = from + -to, sum = from + to;
+	float const arc = 2.f * std::atan2(std::sqrt(dot(difference, difference)), std::sqrt(dot(sum, sum)));
+
+	float const fromComponents[] = { from.x, from.y, from.z, from.w };
+	float const toComponents[] = { to.x, to.y, to.z, to.w };
+	for (size_t j = 0; j < 4; j++)
+	{
+		group.rotationFrom[j].push_back(fromComponents[j]);
+		group.rotationTo[j].push_back(toComponents[j]);
+		group.rotation[j].push_back(fromComponents[j]);
+		group.rotates = group.rotates || fromComponents[j] != toComponents[j];
+	}
+	group.arc.push_back(arc);
+	group.inverseSinArc.push_back(arc < 1e-3f ? 0.f : 1.f / std::sin(arc));
+
+	return AnimationHandle(slots.size() - 1);
+}
+
+void AnimationSystem::clear()
+{
+	groups = {};
+	slots.clear();
+}
+
+void AnimationSystem::update(float aTime)
+{
+	for (size_t style = 0; style < kInterpolationStyleCount; style++)
+	{
+		if (groups[style].size() > 0)
+		{
+			updateGroup(INTERPOLATION_STYLE(style), std::max(aTime, 0.f));
+		}
+	}
+}
+
+void AnimationSystem::updateGroup(INTERPOLATION_STYLE aStyle, float aTime)
+{
+	auto& group = groups[aStyle];
+	size_t const count = group.size();
+
+	float* __restrict reversed = group.reversed.data();
+	float* __restrict eased = group.eased.data();
+	float const* __restrict rate = group.rate.data();
+	float const* __restrict stop = group.stop.data();
+	float const* __restrict bounce = group.bounce.data();
+
+	// progress within the current cycle; same as animation_progress(), but
+	// branch-free
+	for_each_lane_batched(count, [&] (size_t i) {
+		float const cycles = aTime * rate[i];
+		float const cycle = floor_non_negative_(cycles);
+		float const odd = cycle - 2.f * floor_non_negative_(0.5f * cycle);
+		float const fraction = cycles - cycle;
+
+		eased[i] = stop[i] > 0.f ? std::min(cycles, 1.f) : fraction;
+		reversed[i] = bounce[i] * odd;
+	});
+
+	ease_batch(aStyle, eased, eased, count);
+
+	// running backwards is the same curve mirrored: lerp(end, start, t)
+	for_each_lane_batched(count, [&] (size_t i) {
+		eased[i] = eased[i] + reversed[i] * (1.f - 2.f * eased[i]);
+	});
+
+	for (size_t c = 0; c < kComponents; c++)
+	{
+		if (!group.animated[c]) continue;
+
+		float const* __restrict start = group.start[c].data();
+		float const* __restrict delta = group.delta[c].data();
+		float* __restrict value = group.value[c].data();
+
+		for_each_lane_batched(count, [&] (size_t i) {
+			value[i] = start[i] + eased[i] * delta[i];
+		});
+	}
+
+	// rotations stay at from, which is also to
+	if (!group.rotates) return;
+
+	// slerp weights, in place of (1 - t) and t; both arcs are within
+	// [0, pi/2], as the arc between the anchors is the shorter one
+	float* __restrict weightFrom = group.weightFrom.data();
+	float* __restrict weightTo = group.weightTo.data();
+	float const* __restrict arc = group.arc.data();
+	float const* __restrict inverseSinArc = group.inverseSinArc.data();
+
+	for_each_lane_batched(count, [&] (size_t i) {
+		float const t = eased[i];
+		bool const slerped = inverseSinArc[i] > 0.f;
+		float const sinFrom = sin_quadrant_((1.f - t) * arc[i]) * inverseSinArc[i];
+		float const sinTo = sin_quadrant_(t * arc[i]) * inverseSinArc[i];
+		weightFrom[i] = slerped ? sinFrom : 1.f - t;
+		weightTo[i] = slerped ? sinTo : t;
+	});
+
+	for (size_t c = 0; c < 4; c++)
+	{
+		float const* __restrict from = group.rotationFrom[c].data();
+		float const* __restrict to = group.rotationTo[c].data();
+		float* __restrict value = group.rotation[c].data();
+
+		for_each_lane_batched(count, [&] (size_t i) {
+			value[i] = weightFrom[i] * from[i] + weightTo[i] * to[i];
+		});
+	}
+}
+
+AnimatedTransform AnimationSystem::get(AnimationHandle aHandle) const
+{
+	auto const& slot = slots[aHandle];
+	auto const& value = groups[slot.group].value;
+	size_t const i = slot.index;
+
+	auto const& rotation = groups[slot.group].rotation;
+
+	return {
+		{ value[0][i], value[1][i], value[2][i] },
+		Quatf{ rotation[0][i], rotation[1][i], rotation[2][i], rotation[3][i] },
+		{ value[3][i], value[4][i], value[5][i] }
+	};
+}
@@ -0,0 +1,114 @@
+#ifndef ANIMATION_SYSTEM_HEADER_FILE
+#define ANIMATION_SYSTEM_HEADER_FILE
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include "../vmlib/vec3.hpp"
+#include "../vmlib/quat.hpp"
+
+#include "easing.hpp"
+
+// Start and end of an anchor animation, as set up on an AnimationObj.
+// Components that are not animated have equal start and end values.
+struct AnimationChannel
+{
+	Vec3f positionStart = {0.f, 0.f, 0.f}, positionEnd = {0.f, 0.f, 0.f};
+	Quatf rotationStart = kIdentityQuatf, rotationEnd = kIdentityQuatf;
+	Vec3f scaleStart = {1.f, 1.f, 1.f}, scaleEnd = {1.f, 1.f, 1.f};
+
+	// length of one cycle, in seconds
+	float duration = 1.f;
+	INTERPOLATION_STYLE interpolationStyle = LINEAR;
+	ANIMATION_STYLE animationStyle = STOP;
+};
+
+struct AnimatedTransform
+{
+	Vec3f position;
+	Quatf rotation;
+	Vec3f scale;
+};
+
+using AnimationHandle = std::uint32_t;
+
+// Evaluates many anchor animations at once. Channels are stored as structure
+// of arrays, one group per interpolation style, so that each update is a few
+// branch-free loops over contiguous floats (see ease_batch()) instead of a
+// virtual-ish call, a switch and powf() per object. Results are read back per
+// handle with get().
+//
+// Rotations are slerped like AnimationObj does, but the arc between the two
+// anchors is worked out once in add(), leaving two sin() per channel and
+// update. Those come from a polynomial, so that the loop vectorises; the
+// weights match slerp() to within float rounding.
+//
+// Most channels only move a few components (a position, or a scale), so
+// components that no channel of a group animates are skipped.
+//
+// Semantics match AnimationObj::updateAnimation(): channels are evaluated at
+// an absolute time, so updates do not depend on the previous frame. REPEAT
+// restarts, BOUNCE runs every other cycle backwards and STOP holds the end
+// value.
+class AnimationSystem
+{
+public:
+	static constexpr size_t kComponents = 6; // position, scale (xyz)
+
+private:
+	struct Group
+	{
+		std::vector<float> rate;		// cycles per second
+		std::vector<float> stop;		// 1 for STOP, 0 otherwise
+		std::vector<float> bounce;		// 1 for BOUNCE, 0 otherwise
+		std::vector<float> reversed;	// 1 while a BOUNCE runs backwards
+		std::vector<float> eased;
+
+		std::array<std::vector<float>, kComponents> start;
+		std::array<std::vector<float>, kComponents> delta;
+		std::array<std::vector<float>, kComponents> value;
+		// false while no channel of the group moves the component; its
+		// values then stay at start and are not updated
+		std::array<bool, kComponents> animated{};
+
+		// rotation: from, and to on the same side as from (xyzw), and the
+		// angle between them
+		std::array<std::vector<float>, 4> rotationFrom;
+		std::array<std::vector<float>, 4> rotationTo;
+		std::vector<float> arc;
+		std::vector<float> inverseSinArc;	// 0 if the arc is too short to slerp
+		std::vector<float> weightFrom;
+		std::vector<float> weightTo;
+		// false while every channel of the group has from == to; the
+		// rotations then stay at from and are not updated
+		bool rotates = false;
+		std::array<std::vector<float>, 4> rotation;
+
+		size_t size() const { return rate.size(); }
+	};
+
+	struct Slot
+	{
+		std::uint32_t group;
+		std::uint32_t index;
+	};
+
+	std::array<Group, kInterpolationStyleCount> groups;
+	std::vector<Slot> slots;
+
+	void updateGroup(INTERPOLATION_STYLE aStyle, float aTime);
+
+public:
+	AnimationHandle add(const AnimationChannel& aChannel);
+	// drops all channels; previously returned handles become invalid
+	void clear();
+
+	// evaluate all channels at aTime seconds
+	void update(float aTime);
+
+	AnimatedTransform get(AnimationHandle aHandle) const;
+	size_t size() const { return slots.size(); }
+};
+
+#endif//ANIMATION_SYSTEM_HEADER_FILE
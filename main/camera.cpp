@@ -2,6 +2,8 @@
 
 #include <GLFW/glfw3.h>
 
+#include "../vmlib/constants.hpp"
+
 inline void _cam_handle_keyaction(bool* aCameraAction, int aAction)
 {
 	*aCameraAction = aAction == GLFW_PRESS ? true : (aAction == GLFW_RELEASE ? false : *aCameraAction);
@@ -22,8 +24,6 @@ void cam_handle_key(cameraControl* aCamera, int aKey, int aAction)
 	}
 }
 
-constexpr float kPi = 3.1415926;
-
 void cam_handle_mouse(cameraControl* aCamera, const float aMouseSensitivity, double aX, double aY)
 {
 	if( aCamera->cameraActive )
@@ -0,0 +1,35 @@
+#include "command_list.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+void CommandList::begin(const SortKeyContext& aContext)
+{
+	if (!sharedArena)
+	{
+		ownArena.reset();
+	}
+	entries.clear();
+	context = aContext;
+}
+
+void CommandList::record(const DrawItem& aItem)
+{
+	float* uniforms = arena().allocate<float>(DrawPacket::kUniformFloats);
+	std::memcpy(uniforms, aItem.model.v, sizeof(aItem.model.v));
+	std::memcpy(uniforms + 16, aItem.material.v, sizeof(aItem.material.v));
+
+	DrawPacket* packet = arena().allocate<DrawPacket>();
+	packet->pass = aItem.pass;
+	packet->translucent = aItem.translucent;
+	packet->program = aItem.program;
+	packet->vertexArray = aItem.vertexArray;
+	packet->texture = aItem.texture;
+	packet->textureLayer = aItem.textureLayer;
+	packet->indexType = aItem.indexType;
+	packet->first = aItem.first;
+	packet->count = aItem.count;
+	packet->uniforms = uniforms;
+
+	entries.push_back({ make_sort_key(aItem, context), packet });
+}
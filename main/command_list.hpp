@@ -0,0 +1,53 @@
+#ifndef COMMAND_LIST_HEADER_FILE
+#define COMMAND_LIST_HEADER_FILE
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "draw_item.hpp"
+#include "memory_arena.hpp"
+
+// Draws recorded by one thread. Recording does no GL calls: the sort key is
+// computed and the uniforms are packed into the list's arena, so any number
+// of lists can be recorded in parallel. The GL thread then hands them to
+// RenderQueue::merge(), which sorts them together with the directly
+// submitted draws and replays them.
+//
+// A list must not be recorded into while a queue it was merged into is
+// still being flushed.
+class CommandList
+{
+public:
+	struct Entry
+	{
+		std::uint64_t key;
+		const DrawPacket* packet;
+	};
+
+private:
+	LinearArena ownArena;
+	// not owned; reset by whoever owns it instead of by begin()
+	LinearArena* sharedArena = nullptr;
+	std::vector<Entry> entries;
+	SortKeyContext context;
+
+	LinearArena& arena() { return sharedArena ? *sharedArena : ownArena; }
+
+public:
+	CommandList() = default;
+	// record into aArena, which must be reset only after the list has
+	// been replayed (e.g. once per frame)
+	explicit CommandList(LinearArena& aArena) : sharedArena(&aArena) {}
+
+	// drop the previous recording; keys are computed with aContext
+	void begin(const SortKeyContext& aContext);
+	void record(const DrawItem& aItem);
+
+	const std::vector<Entry>& recorded() const { return entries; }
+	size_t size() const { return entries.size(); }
+	size_t arenaBytes() const { return sharedArena ? sharedArena->bytesUsed() : ownArena.bytesUsed(); }
+};
+
+#endif//COMMAND_LIST_HEADER_FILE
@@ -1,5 +1,7 @@
 #include "cone.hpp"
 
+#include "../vmlib/constants.hpp"
+
 SimpleMeshData make_cone( bool aCapped, std::size_t aSubdivs, Vec3f aColor, Mat44f aPreTransform )
 {
 	// TODO: Implement cone shell generation
@@ -14,7 +16,7 @@ SimpleMeshData make_cone( bool aCapped, std::size_t aSubdivs, Vec3f aColor, Mat4
 	// Start from the tip of the cone, then draw the base as segments of the cone's base
 	for (std::size_t i = 0; i < aSubdivs; ++i)
 	{
-		float const angle = (i + 1) / float(aSubdivs) * 2.f * 3.1415926f;
+		float const angle = (i + 1) / float(aSubdivs) * 2.f * kPi;
 
 		float y = std::cos(angle);
 		float z = std::sin(angle);
@@ -41,7 +43,7 @@ SimpleMeshData make_cone( bool aCapped, std::size_t aSubdivs, Vec3f aColor, Mat4
 		// draw bottom cap, should be a triangle fan of aSubdiv no. triangles
 		for (std::size_t i = 0; i < aSubdivs; ++i)
 		{
-			float const angle = (i + 1) / float(aSubdivs) * 2.f * 3.1415926f;
+			float const angle = (i + 1) / float(aSubdivs) * 2.f * kPi;
 
 			float y = std::cos(angle);
 			float z = std::sin(angle);
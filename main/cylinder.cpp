@@ -1,5 +1,7 @@
 #include "cylinder.hpp"
 
+#include "../vmlib/constants.hpp"
+
 SimpleMeshData make_cylinder( bool aCapped, std::size_t aSubdivs, Vec3f aColor, Mat44f aPreTransform )
 {
 	// DONE: Implement cylinder shell generation
@@ -11,7 +13,7 @@ SimpleMeshData make_cylinder( bool aCapped, std::size_t aSubdivs, Vec3f aColor,
 	// Generate vertices for the triangles that make the sides of the cylinder
 	for(std::size_t i = 0; i < aSubdivs; ++i)
 	{
-		float const angle = (i + 1) / float(aSubdivs) * 2.f * 3.1415926f;
+		float const angle = (i + 1) / float(aSubdivs) * 2.f * kPi;
 			
 		float y = std::cos(angle);
 		float z = std::sin(angle);
@@ -41,7 +43,7 @@ SimpleMeshData make_cylinder( bool aCapped, std::size_t aSubdivs, Vec3f aColor,
 		// draw top cap, should be a triangle fan of aSubdiv no. triangles
 		for (std::size_t i = 0; i < aSubdivs; ++i)
 		{
-			float const angle = (i + 1) / float(aSubdivs) * 2.f * 3.1415926f;
+			float const angle = (i + 1) / float(aSubdivs) * 2.f * kPi;
 
 			float y = std::cos(angle);
 			float z = std::sin(angle);
@@ -61,7 +63,7 @@ SimpleMeshData make_cylinder( bool aCapped, std::size_t aSubdivs, Vec3f aColor,
 		// draw bottom cap, should be a triangle fan of aSubdiv no. triangles
 		for (std::size_t i = 0; i < aSubdivs; ++i)
 		{
-			float const angle = (i + 1) / float(aSubdivs) * 2.f * 3.1415926f;
+			float const angle = (i + 1) / float(aSubdivs) * 2.f * kPi;
 
 			float y = std::cos(angle);
 			float z = std::sin(angle);
@@ -0,0 +1,86 @@
+#ifndef DRAW_ITEM_HEADER_FILE
+#define DRAW_ITEM_HEADER_FILE
+
+#include <glad.h>
+
+#include <cstdint>
+
+#include "../vmlib/vec3.hpp"
+#include "../vmlib/mat44.hpp"
+
+enum RENDER_PASS
+{
+	PASS_WORLD = 0,
+	PASS_OVERLAY = 1
+};
+
+enum TRANSPARENCY_MODE
+{
+	// translucent draws are sorted back-to-front and alpha blended
+	TRANSPARENCY_SORTED,
+	// translucent draws are grouped by state only; blending is order
+	// independent (see WeightedBlendedOIT)
+	TRANSPARENCY_WEIGHTED_BLENDED
+};
+
+// Everything needed to issue one draw call. Scene code fills these in, in
+// whatever order is convenient; the queue decides the actual draw order.
+struct DrawItem
+{
+	RENDER_PASS pass = PASS_WORLD;
+	bool translucent = false;
+
+	GLuint program = 0;
+	GLuint vertexArray = 0;
+	GLuint texture = 0;
+	// if not negative, texture is a GL_TEXTURE_2D_ARRAY and this is the layer
+	// to sample. Draws using different layers of one array share a binding.
+	GLint textureLayer = -1;
+
+	// GL_NONE for glDrawArrays(). Otherwise the vertex array has an element
+	// buffer of this type, and first and count are in indices.
+	GLenum indexType = GL_NONE;
+	GLint first = 0;
+	GLsizei count = 0;
+
+	Mat44f model = kIdentity44f;
+	Mat44f material = kIdentity44f;
+};
+
+// Recorded form of a DrawItem. The matrices are packed into one uniform
+// blob (model, then material) that lives next to the packet in a
+// CommandList's arena.
+struct DrawPacket
+{
+	static constexpr size_t kUniformFloats = 32;
+
+	RENDER_PASS pass;
+	bool translucent;
+
+	GLuint program;
+	GLuint vertexArray;
+	GLuint texture;
+	GLint textureLayer;
+
+	GLenum indexType;
+	GLint first;
+	GLsizei count;
+
+	const float* uniforms;
+
+	const float* model() const { return uniforms; }
+	const float* material() const { return uniforms + 16; }
+};
+
+// Per-frame inputs of the sort key; see RenderQueue for the key layout.
+struct SortKeyContext
+{
+	Vec3f cameraPosition{ 0.f, 0.f, 0.f };
+	float depthRange = 100.f;
+	TRANSPARENCY_MODE transparencyMode = TRANSPARENCY_SORTED;
+};
+
+// Pure function of its arguments, so it can be called from any thread.
+std::uint64_t make_sort_key(const DrawItem& aItem, const SortKeyContext& aContext);
+
+#endif//DRAW_ITEM_HEADER_FILE
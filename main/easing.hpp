@@ -0,0 +1,78 @@
+#ifndef EASING_HEADER_FILE
+#define EASING_HEADER_FILE
+
+#include <cstddef>
+
+enum INTERPOLATION_STYLE
+{
+	LINEAR,
+	S_CURVE,
+	CUBIC,
+	SINUSOIDAL,
+	INVERSE,
+	RECIPROCAL
+};
+
+constexpr size_t kInterpolationStyleCount = size_t(RECIPROCAL) + 1;
+
+enum ANIMATION_STYLE
+{
+	STOP,
+	REPEAT,
+	BOUNCE
+};
+
+// Animations are authored in steps (frames at the refresh rate they were
+// tuned for) but evaluated in seconds.
+constexpr float kAnimationStepsPerSecond = 60.f;
+
+// Maps absolute time, in units of the animation's duration, to progress in
+// [0, 1] of the current cycle. Sets aReversed for the backward half of a
+// BOUNCE cycle.
+float animation_progress(ANIMATION_STYLE aStyle, float aCycles, bool& aReversed);
+
+// Easing curves mapping animation progress in [0, 1] to an interpolation
+// factor in [0, 1]. None of them call powf() or expf(): SINUSOIDAL is a
+// polynomial, and INVERSE, RECIPROCAL and S_CURVE (a logistic curve) are
+// rational.
+float ease(INTERPOLATION_STYLE aStyle, float aIn);
+
+// Calls aFn(i) for i in [0, aCount). The bulk of the range is split into
+// blocks of a fixed number of lanes, which compilers turn into SIMD code even
+// at -O2, where loops with unknown trip counts are usually left scalar.
+// Calls for different i must not depend on each other: the lanes of a block
+// are assumed not to overlap in memory, as -O2 does not check at run time
+// and the __restrict of pointers captured by aFn is lost.
+template< typename tFn >
+inline void for_each_lane_batched(size_t aCount, tFn&& aFn)
+{
+	constexpr size_t kLanes = 16;
+
+	size_t i = 0;
+	for (; i + kLanes <= aCount; i += kLanes)
+	{
+#		if defined(__clang__)
+#		pragma clang loop vectorize(assume_safety)
+#		elif defined(__GNUC__)
+#		pragma GCC ivdep
+#		elif defined(_MSC_VER)
+#		pragma loop(ivdep)
+#		endif
+		for (size_t lane = 0; lane < kLanes; lane++)
+		{
+			aFn(i + lane);
+		}
+	}
+	for (; i < aCount; i++)
+	{
+		aFn(i);
+	}
+}
+
+// Same as ease(), over arrays. The loops are branch-free per style so that
+// the compiler can vectorise them; with aIn != aOut the input is copied to
+// aOut first. aIn and aOut may be the same array, but must not otherwise
+// overlap.
+void ease_batch(INTERPOLATION_STYLE aStyle, const float* aIn, float* aOut, size_t aCount);
+
+#endif//EASING_HEADER_FILE
@@ -0,0 +1,123 @@
+#include "entity_bench.hpp"
+
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+
+#include "../vmlib/constants.hpp"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	float elapsed_ms_(Clock::time_point aStart)
+	{
+		return std::chrono::duration<float, std::milli>(Clock::now() - aStart).count();
+	}
+
+	// bounding sphere of the cube, relative to its scale
+	constexpr float kCubeRadius = 1.74f;
+}
+
+void EntityBenchmark::build(size_t aCount, const DrawItem& aCube)
+{
+	store.clear();
+	objects.clear();
+	cube = aCube;
+
+	size_t const perRow = size_t(std::ceil(std::sqrt(float(aCount))));
+	float const spacing = 36.f / float(std::max<size_t>(perRow, 1));
+	float const size = std::min(0.05f, 0.3f * spacing);
+
+	objects.reserve(aCount);
+	for (size_t i = 0; i < aCount; i++)
+	{
+		Vec3f const base = {
+			-18.f + spacing * float(i % perRow),
+			1.f,
+			-18.f + spacing * float(i / perRow)
+		};
+
+		// cubes bob up and down and turn, at a few different rates and
+		// with different easing. Rotations are blended the shorter way, so
+		// a full turn would not move at all; a quarter turn back and forth
+		// still needs the same work every frame.
+		size_t const steps = 60 + 30 * (i % 5);
+		INTERPOLATION_STYLE const style = INTERPOLATION_STYLE(i % kInterpolationStyleCount);
+		Vec3f const low = base, high = base + Vec3f{ 0.f, 0.5f + 0.1f * float(i % 7), 0.f };
+		Vec3f const spinStart = { 0.f, 0.f, 0.f }, spinEnd = { 0.f, 0.5f * kPi, 0.f };
+		Vec3f const scale = { size, size, size };
+
+		auto& object = objects.emplace_back(std::make_unique<AnimationObj>());
+		object->scale(scale);
+		object->setPositionAnchors(low, high);
+		object->setRotationAnchors(spinStart, spinEnd);
+		object->setupAnimation(steps, style, BOUNCE);
+
+		Entity const entity = store.create(base, spinStart, scale);
+		store.setRender(entity, &cube, 1);
+		store.setBounds(entity, { 0.f, 0.f, 0.f }, kCubeRadius);
+		store.setAnimation(entity, object->channel());
+	}
+}
+
+EntityBenchStats EntityBenchmark::run(bool aUseStore, float aTime, const Frustum& aFrustum, RenderQueue& aQueue, GLuint aProgram)
+{
+	return aUseStore
+		? runStore(aTime, aFrustum, aQueue, aProgram)
+		: runObjects(aTime, aFrustum, aQueue, aProgram);
+}
+
+EntityBenchStats EntityBenchmark::runStore(float aTime, const Frustum& aFrustum, RenderQueue& aQueue, GLuint aProgram)
+{
+	EntityBenchStats stats;
+	stats.entities = store.size();
+
+	auto const start = Clock::now();
+	store.animate(aTime);
+	stats.animateMs = elapsed_ms_(start);
+
+	auto const transformStart = Clock::now();
+	store.updateTransforms();
+	stats.transformMs = elapsed_ms_(transformStart);
+
+	auto const cullStart = Clock::now();
+	stats.visible = store.cull(aFrustum);
+	stats.cullMs = elapsed_ms_(cullStart);
+
+	auto const submitStart = Clock::now();
+	store.submit(aQueue, aProgram);
+	stats.submitMs = elapsed_ms_(submitStart);
+
+	stats.totalMs = elapsed_ms_(start);
+	return stats;
+}
+
+EntityBenchStats EntityBenchmark::runObjects(float aTime, const Frustum& aFrustum, RenderQueue& aQueue, GLuint aProgram)
+{
+	EntityBenchStats stats;
+	stats.entities = objects.size();
+
+	auto const start = Clock::now();
+
+	DrawItem item = cube;
+	if (item.program == 0) item.program = aProgram;
+
+	for (auto& object : objects)
+	{
+		object->updateAnimation(aTime);
+		Mat44f const model = object->modelMatrix();
+
+		// scaling is uniform, so the first column's length is the scale
+		Vec3f const centre = { model(0, 3), model(1, 3), model(2, 3) };
+		float const scale = std::sqrt(model(0, 0) * model(0, 0) + model(1, 0) * model(1, 0) + model(2, 0) * model(2, 0));
+		if (!sphere_in_frustum(aFrustum, centre, kCubeRadius * scale)) continue;
+
+		stats.visible++;
+		item.model = model;
+		aQueue.submit(item);
+	}
+
+	stats.totalMs = elapsed_ms_(start);
+	return stats;
+}
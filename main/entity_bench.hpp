@@ -0,0 +1,44 @@
+#ifndef ENTITY_BENCH_HEADER_FILE
+#define ENTITY_BENCH_HEADER_FILE
+
+#include <memory>
+#include <vector>
+
+#include "entity_store.hpp"
+#include "animation_object.hpp"
+
+struct EntityBenchStats
+{
+	size_t entities = 0;
+	size_t visible = 0;
+	// per system; the object graph does everything in one pass (totalMs)
+	float animateMs = 0.f;
+	float transformMs = 0.f;
+	float cullMs = 0.f;
+	float submitMs = 0.f;
+	float totalMs = 0.f;
+};
+
+// The same field of animated cubes held once as an EntityStore and once as
+// individually allocated AnimationObjs, to compare the two layouts. Each
+// frame either runs animate -> transform -> cull -> submit over the store,
+// or visits every object through its pointer and does the same work.
+class EntityBenchmark
+{
+	EntityStore store;
+	std::vector<std::unique_ptr<AnimationObj>> objects;
+	DrawItem cube;
+
+	EntityBenchStats runStore(float aTime, const Frustum& aFrustum, RenderQueue& aQueue, GLuint aProgram);
+	EntityBenchStats runObjects(float aTime, const Frustum& aFrustum, RenderQueue& aQueue, GLuint aProgram);
+
+public:
+	// aCube draws a cube of unit half-size; its model matrix is ignored,
+	// and program 0 means the program passed to run()
+	void build(size_t aCount, const DrawItem& aCube);
+	size_t size() const { return objects.size(); }
+
+	EntityBenchStats run(bool aUseStore, float aTime, const Frustum& aFrustum, RenderQueue& aQueue, GLuint aProgram);
+};
+
+#endif//ENTITY_BENCH_HEADER_FILE
@@ -0,0 +1,152 @@
+#include "entity_store.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+Entity EntityStore::create(Vec3f aPosition, Vec3f aRotation, Vec3f aScale)
+{
+	Entity const entity = Entity(components.size());
+
+	components.push_back(0);
+
+	position.push_back(aPosition);
+	rotation.push_back(make_quat_euler(aRotation));
+	scale.push_back(aScale);
+	world.push_back(kIdentity44f);
+
+	localCentre.push_back({ 0.f, 0.f, 0.f });
+	localRadius.push_back(0.f);
+	worldCentre.push_back(aPosition);
+	worldRadius.push_back(0.f);
+	visible.push_back(1);
+
+	renderFirst.push_back(0);
+	renderCount.push_back(0);
+
+	animation.push_back(0);
+
+	return entity;
+}
+
+void EntityStore::clear()
+{
+	components.clear();
+	position.clear();
+	rotation.clear();
+	scale.clear();
+	world.clear();
+	localCentre.clear();
+	localRadius.clear();
+	worldCentre.clear();
+	worldRadius.clear();
+	visible.clear();
+	renderFirst.clear();
+	renderCount.clear();
+	renderParts.clear();
+	animation.clear();
+	animations.clear();
+}
+
+void EntityStore::setRender(Entity aEntity, const DrawItem* aParts, size_t aCount)
+{
+	// parts of a replaced render component are left unused
+	renderFirst[aEntity] = std::uint32_t(renderParts.size());
+	renderCount[aEntity] = std::uint32_t(aCount);
+	renderParts.insert(renderParts.end(), aParts, aParts + aCount);
+	components[aEntity] |= COMPONENT_RENDER;
+}
+
+void EntityStore::setBounds(Entity aEntity, Vec3f aCentre, float aRadius)
+{
+	localCentre[aEntity] = aCentre;
+	localRadius[aEntity] = aRadius;
+	components[aEntity] |= COMPONENT_BOUNDS;
+}
+
+void EntityStore::setAnimation(Entity aEntity, const AnimationChannel& aChannel)
+{
+	animation[aEntity] = animations.add(aChannel);
+	components[aEntity] |= COMPONENT_ANIMATION;
+}
+
+void EntityStore::animate(float aTime)
+{
+	animations.update(aTime);
+
+	for (size_t i = 0; i < components.size(); i++)
+	{
+		if (!(components[i] & COMPONENT_ANIMATION)) continue;
+
+		AnimatedTransform const animated = animations.get(animation[i]);
+		position[i] = animated.position;
+		rotation[i] = animated.rotation;
+		scale[i] = animated.scale;
+	}
+}
+
+void EntityStore::updateTransforms()
+{
+	// translation * scaling * rotation, as in Transform::matrix(), but
+	// written out instead of two 4x4 products
+	for (size_t i = 0; i < components.size(); i++)
+	{
+		Quatf const q = rotation[i];
+		Vec3f const s = scale[i];
+		Vec3f const p = position[i];
+
+		float const x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+		float const xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+		float const xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+		float const wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+
+		world[i] = { {
+			s.x * (1.f - (yy + zz)), s.x * (xy - wz),         s.x * (xz + wy),         p.x,
+			s.y * (xy + wz),         s.y * (1.f - (xx + zz)), s.y * (yz - wx),         p.y,
+			s.z * (xz - wy),         s.z * (yz + wx),         s.z * (1.f - (xx + yy)), p.z,
+			0.f,                     0.f,                     0.f,                     1.f
+		} };
+	}
+
+	for (size_t i = 0; i < components.size(); i++)
+	{
+		Mat44f const& m = world[i];
+		Vec3f const c = localCentre[i];
+		worldCentre[i] = {
+			m.v[0] * c.x + m.v[1] * c.y + m.v[2] * c.z + m.v[3],
+			m.v[4] * c.x + m.v[5] * c.y + m.v[6] * c.z + m.v[7],
+			m.v[8] * c.x + m.v[9] * c.y + m.v[10] * c.z + m.v[11]
+		};
+
+		float const maxScale = std::max({ std::abs(scale[i].x), std::abs(scale[i].y), std::abs(scale[i].z) });
+		worldRadius[i] = localRadius[i] * maxScale;
+	}
+}
+
+size_t EntityStore::cull(const Frustum& aFrustum)
+{
+	size_t count = 0;
+	for (size_t i = 0; i < components.size(); i++)
+	{
+		bool const inside = !(components[i] & COMPONENT_BOUNDS)
+			|| sphere_in_frustum(aFrustum, worldCentre[i], worldRadius[i]);
+		visible[i] = inside ? 1 : 0;
+		count += inside ? 1 : 0;
+	}
+	return count;
+}
+
+void EntityStore::submit(RenderQueue& aQueue, GLuint aProgram) const
+{
+	for (size_t i = 0; i < components.size(); i++)
+	{
+		if (!visible[i] || !(components[i] & COMPONENT_RENDER)) continue;
+
+		for (std::uint32_t part = 0; part < renderCount[i]; part++)
+		{
+			DrawItem item = renderParts[renderFirst[i] + part];
+			item.model = world[i];
+			if (item.program == 0) item.program = aProgram;
+			aQueue.submit(item);
+		}
+	}
+}
@@ -0,0 +1,92 @@
+#ifndef ENTITY_STORE_HEADER_FILE
+#define ENTITY_STORE_HEADER_FILE
+
+#include <vector>
+#include <cstdint>
+
+#include "../vmlib/vec3.hpp"
+#include "../vmlib/mat44.hpp"
+#include "../vmlib/quat.hpp"
+
+#include "draw_item.hpp"
+#include "frustum.hpp"
+#include "render_queue.hpp"
+#include "animation_system.hpp"
+
+using Entity = std::uint32_t;
+
+enum ENTITY_COMPONENT
+{
+	COMPONENT_RENDER = 1 << 0,
+	COMPONENT_ANIMATION = 1 << 1,
+	COMPONENT_BOUNDS = 1 << 2
+};
+
+// Entities and their components as structure of arrays. Every entity has a
+// slot in every array, so an entity is just an index and each system is a
+// linear pass over the few arrays it needs, in this order:
+//
+//   animate(time)         animation channels -> position/rotation/scale
+//   updateTransforms()    position/rotation/scale -> world matrix, world bounds
+//   cull(frustum)         world bounds -> visible
+//   submit(queue)         visible, world matrix, render parts -> draws
+//
+// Compare this to SceneObj/AnimationObj, where each object carries its own
+// transform, meshes and animation state and is visited through a pointer.
+//
+// A render component is a run of DrawItems (one per mesh range, like
+// SceneObj::submit() produces) whose model matrix is filled in from the
+// entity's world matrix. Parts with program 0 are drawn with the program
+// passed to submit(), so they survive shader reloads.
+class EntityStore
+{
+	std::vector<std::uint8_t> components;
+
+	// transform
+	std::vector<Vec3f> position;
+	std::vector<Quatf> rotation;
+	std::vector<Vec3f> scale;
+	std::vector<Mat44f> world;
+
+	// bounds: object space sphere, and the same in world space
+	std::vector<Vec3f> localCentre;
+	std::vector<float> localRadius;
+	std::vector<Vec3f> worldCentre;
+	std::vector<float> worldRadius;
+	std::vector<std::uint8_t> visible;
+
+	// render: parts [renderFirst, renderFirst + renderCount)
+	std::vector<std::uint32_t> renderFirst;
+	std::vector<std::uint32_t> renderCount;
+	std::vector<DrawItem> renderParts;
+
+	// animation
+	std::vector<AnimationHandle> animation;
+	AnimationSystem animations;
+
+public:
+	// aRotation in Euler angles, see Transform::setRotation()
+	Entity create(Vec3f aPosition, Vec3f aRotation = { 0.f, 0.f, 0.f }, Vec3f aScale = { 1.f, 1.f, 1.f });
+	// drops all entities and components
+	void clear();
+
+	// the model matrices of aParts are ignored
+	void setRender(Entity aEntity, const DrawItem* aParts, size_t aCount);
+	// object space bounding sphere; entities without bounds are never culled
+	void setBounds(Entity aEntity, Vec3f aCentre, float aRadius);
+	// position/rotation/scale follow aChannel from then on
+	void setAnimation(Entity aEntity, const AnimationChannel& aChannel);
+
+	void animate(float aTime);
+	void updateTransforms();
+	// returns the number of visible entities
+	size_t cull(const Frustum& aFrustum);
+	void submit(RenderQueue& aQueue, GLuint aProgram) const;
+
+	size_t size() const { return components.size(); }
+	Vec3f getPosition(Entity aEntity) const { return position[aEntity]; }
+	const Mat44f& getWorld(Entity aEntity) const { return world[aEntity]; }
+	bool isVisible(Entity aEntity) const { return visible[aEntity] != 0; }
+};
+
+#endif//ENTITY_STORE_HEADER_FILE
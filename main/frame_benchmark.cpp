@@ -0,0 +1,321 @@
+#include "frame_benchmark.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include "../support/error.hpp"
+
+#include "../vmlib/constants.hpp"
+
+namespace
+{
+	int parse_count_(const char* aOption, const char* aValue)
+	{
+		char* end = nullptr;
+		long const value = aValue ? std::strtol(aValue, &end, 10) : 0;
+		if (!aValue || *end != '\0' || value < 0 || value > 10000000)
+			throw Error("%s expects a count, got '%s'", aOption, aValue ? aValue : "");
+		return int(value);
+	}
+
+	struct Summary_
+	{
+		size_t count = 0;
+		double average = 0.0;
+		double p50 = 0.0, p95 = 0.0, p99 = 0.0;
+		double max = 0.0;
+	};
+
+	// nearest-rank percentiles
+	Summary_ summarise_(std::vector<double> aValues)
+	{
+		Summary_ result;
+		if (aValues.empty()) return result;
+
+		std::sort(aValues.begin(), aValues.end());
+		auto const percentile = [&] (double aP) {
+			size_t const rank = size_t(std::ceil(aP / 100.0 * double(aValues.size())));
+			return aValues[std::clamp<size_t>(rank, 1, aValues.size()) - 1];
+		};
+
+		result.count = aValues.size();
+		for (double value : aValues) result.average += value;
+		result.average /= double(aValues.size());
+		result.p50 = percentile(50.0);
+		result.p95 = percentile(95.0);
+		result.p99 = percentile(99.0);
+		result.max = aValues.back();
+		return result;
+	}
+
+	template< typename tGetter >
+	void write_summary_(std::FILE* aOut, const char* aName, const std::vector<BenchmarkFrame>& aFrames, tGetter&& aGet, bool aLast = false)
+	{
+		std::vector<double> values;
+		values.reserve(aFrames.size());
+		for (auto const& frame : aFrames)
+		{
+			double const value = aGet(frame);
+			if (value >= 0.0) values.push_back(value);
+		}
+
+		Summary_ const s = summarise_(std::move(values));
+		std::fprintf(aOut, "\t\t\"%s\": { \"samples\": %zu, \"avg\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f }%s\n",
+			aName, s.count, s.average, s.p50, s.p95, s.p99, s.max, aLast ? "" : ",");
+	}
+
+	std::string json_escape_(const char* aText)
+	{
+		std::string result;
+		for (const char* c = aText; *c; c++)
+		{
+			if (*c == '"' || *c == '\\') result += '\\';
+			if (static_cast<unsigned char>(*c) >= 0x20) result += *c;
+		}
+		return result;
+	}
+}
+
+BenchmarkOptions parse_benchmark_options(int aArgc, char** aArgv)
+{
+	BenchmarkOptions options;
+
+	for (int i = 1; i < aArgc; i++)
+	{
+		const char* const arg = aArgv[i];
+		const char* const value = (i + 1 < aArgc) ? aArgv[i + 1] : nullptr;
+
+		if (std::strcmp(arg, "--bench") == 0)
+		{
+			options.enabled = true;
+		}
+		else if (std::strcmp(arg, "--unthrottled") == 0)
+		{
+			options.unthrottled = true;
+		}
+		else if (std::strcmp(arg, "--bench-frames") == 0)
+		{
+			options.frames = std::max(parse_count_(arg, value), 1);
+			i++;
+		}
+		else if (std::strcmp(arg, "--bench-warmup") == 0)
+		{
+			options.warmupFrames = parse_count_(arg, value);
+			i++;
+		}
+		else if (std::strcmp(arg, "--bench-threaded") == 0)
+		{
+			options.threadedSimulation = true;
+		}
+		else if (std::strcmp(arg, "--bench-animation") == 0)
+		{
+			options.animationChannels = parse_count_(arg, value);
+			i++;
+		}
+		else if (std::strcmp(arg, "--bench-path") == 0)
+		{
+			if (!value) throw Error("%s expects a file name", arg);
+			options.cameraPath = value;
+			i++;
+		}
+		else if (std::strcmp(arg, "--bench-out") == 0)
+		{
+			if (!value) throw Error("%s expects a file name", arg);
+			options.output = value;
+			i++;
+		}
+		else if (std::strcmp(arg, "--record-input") == 0)
+		{
+			if (!value) throw Error("%s expects a file name", arg);
+			options.recordInput = value;
+			i++;
+		}
+		else if (std::strcmp(arg, "--replay-input") == 0)
+		{
+			if (!value) throw Error("%s expects a file name", arg);
+			options.replayInput = value;
+			i++;
+		}
+		else if (std::strcmp(arg, "--gl-calls") == 0)
+		{
+			if (!value) throw Error("%s expects a file name", arg);
+			options.glCallsOutput = value;
+			i++;
+		}
+		else
+		{
+			throw Error("Unknown argument '%s'", arg);
+		}
+	}
+
+	if (!options.recordInput.empty() && !options.replayInput.empty())
+		throw Error("--record-input and --replay-input cannot be combined");
+	// a threaded simulation runs a frame behind its input, so a recording
+	// would not replay the same frames
+	if (options.threadedSimulation && (!options.recordInput.empty() || !options.replayInput.empty()))
+		throw Error("--bench-threaded cannot be combined with recording or replaying input");
+
+	return options;
+}
+
+void CameraPath::load(const char* aPath)
+{
+	std::FILE* in = std::fopen(aPath, "r");
+	if (!in) throw Error("Unable to open camera path '%s'", aPath);
+
+	keys.clear();
+	CameraKey key;
+	while (std::fscanf(in, "%f %f %f %f %f %f", &key.time, &key.position.x, &key.position.y, &key.position.z, &key.theta, &key.phi) == 6)
+	{
+		keys.push_back(key);
+	}
+	bool const complete = std::feof(in) != 0;
+	std::fclose(in);
+
+	if (!complete || keys.empty())
+		throw Error("Camera path '%s' is malformed after %zu keys", aPath, keys.size());
+}
+
+void CameraPath::save(const char* aPath) const
+{
+	std::FILE* out = std::fopen(aPath, "w");
+	if (!out) throw Error("Unable to write camera path '%s'", aPath);
+
+	for (auto const& key : keys)
+	{
+		std::fprintf(out, "%.4f %.5f %.5f %.5f %.5f %.5f\n", key.time, key.position.x, key.position.y, key.position.z, key.theta, key.phi);
+	}
+	std::fclose(out);
+}
+
+CameraKey CameraPath::sample(float aTime) const
+{
+	if (keys.empty()) return { aTime, { 0.f, 0.f, 0.f }, 0.f, 0.f };
+
+	auto const next = std::upper_bound(keys.begin(), keys.end(), aTime,
+		[] (float aT, const CameraKey& aKey) { return aT < aKey.time; });
+	if (next == keys.begin()) return keys.front();
+	if (next == keys.end()) return keys.back();
+
+	CameraKey const& a = *(next - 1);
+	CameraKey const& b = *next;
+	float const t = (aTime - a.time) / std::max(b.time - a.time, 1e-6f);
+
+	return {
+		aTime,
+		(1.f - t) * a.position + t * b.position,
+		(1.f - t) * a.theta + t * b.theta,
+		(1.f - t) * a.phi + t * b.phi
+	};
+}
+
+CameraPath make_default_fly_through()
+{
+	// eye on a circle around the centre of the room, rising and falling,
+	// slightly looking down; one lap in 40 seconds
+	constexpr int kKeys = 64;
+	constexpr float kLapSeconds = 40.f;
+
+	CameraPath path;
+	for (int i = 0; i <= kKeys; i++)
+	{
+		float const angle = 2.f * kPi * float(i) / float(kKeys);
+		float const radius = 12.f + 3.f * std::sin(3.f * angle);
+		Vec3f const eye = { radius * std::sin(angle), 2.5f + 1.5f * std::sin(2.f * angle), radius * std::cos(angle) };
+
+		path.add({ kLapSeconds * float(i) / float(kKeys), -eye, 0.15f, -angle });
+	}
+	return path;
+}
+
+GpuFrameTimer::GpuFrameTimer()
+{
+	glGenQueries(GLsizei(kFramesInFlight * 2), queries);
+}
+
+GpuFrameTimer::~GpuFrameTimer()
+{
+	glDeleteQueries(GLsizei(kFramesInFlight * 2), queries);
+}
+
+void GpuFrameTimer::begin(std::uint64_t aFrame)
+{
+	// every slot in flight: the oldest result is dropped
+	frameOf[next] = aFrame;
+	pending[next] = false;
+	glQueryCounter(queries[next * 2], GL_TIMESTAMP);
+}
+
+void GpuFrameTimer::end()
+{
+	glQueryCounter(queries[next * 2 + 1], GL_TIMESTAMP);
+	pending[next] = true;
+	next = (next + 1) % kFramesInFlight;
+}
+
+bool GpuFrameTimer::collect(std::uint64_t& aFrame, float& aMs, bool aWait)
+{
+	// slots are used round-robin, so the oldest pending one is the first
+	// after the most recent
+	for (size_t i = 0; i < kFramesInFlight; i++)
+	{
+		size_t const slot = (next + i) % kFramesInFlight;
+		if (!pending[slot]) continue;
+
+		if (!aWait)
+		{
+			GLint available = 0;
+			glGetQueryObjectiv(queries[slot * 2 + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available) return false;
+		}
+
+		GLuint64 start = 0, end = 0;
+		glGetQueryObjectui64v(queries[slot * 2], GL_QUERY_RESULT, &start);
+		glGetQueryObjectui64v(queries[slot * 2 + 1], GL_QUERY_RESULT, &end);
+		pending[slot] = false;
+
+		aFrame = frameOf[slot];
+		aMs = float(double(end - start) * 1e-6);
+		return true;
+	}
+	return false;
+}
+
+void BenchmarkReport::writeJson(const char* aPath, const BenchmarkOptions& aOptions, float aTimeStep, const char* aRenderer) const
+{
+	std::FILE* out = std::fopen(aPath, "w");
+	if (!out) throw Error("Unable to write benchmark results to '%s'", aPath);
+
+	std::fprintf(out, "{\n");
+	std::fprintf(out, "\t\"renderer\": \"%s\",\n", json_escape_(aRenderer ? aRenderer : "").c_str());
+	std::fprintf(out, "\t\"cameraPath\": \"%s\",\n", json_escape_(aOptions.cameraPath.empty() ? "built-in" : aOptions.cameraPath.c_str()).c_str());
+	std::fprintf(out, "\t\"frames\": %zu,\n", frames.size());
+	std::fprintf(out, "\t\"warmupFrames\": %d,\n", aOptions.warmupFrames);
+	std::fprintf(out, "\t\"timeStep\": %.6f,\n", aTimeStep);
+	std::fprintf(out, "\t\"vsync\": %s,\n", aOptions.unthrottled ? "false" : "true");
+	std::fprintf(out, "\t\"simulation\": \"%s\",\n", aOptions.threadedSimulation ? "threaded" : "inline");
+	std::fprintf(out, "\t\"animationChannels\": %d,\n", aOptions.animationChannels);
+
+	std::fprintf(out, "\t\"timings\": {\n");
+	write_summary_(out, "frameMs", frames, [] (const BenchmarkFrame& f) { return double(f.frameMs); });
+	write_summary_(out, "cpuMs", frames, [] (const BenchmarkFrame& f) { return double(f.cpuMs); });
+	write_summary_(out, "simulationMs", frames, [] (const BenchmarkFrame& f) { return double(f.simulationMs); });
+	write_summary_(out, "gpuMs", frames, [] (const BenchmarkFrame& f) { return double(f.gpuMs); }, true);
+	std::fprintf(out, "\t},\n");
+
+	std::fprintf(out, "\t\"counts\": {\n");
+	write_summary_(out, "draws", frames, [] (const BenchmarkFrame& f) { return double(f.draws); });
+	write_summary_(out, "programChanges", frames, [] (const BenchmarkFrame& f) { return double(f.programChanges); });
+	write_summary_(out, "vertexArrayChanges", frames, [] (const BenchmarkFrame& f) { return double(f.vertexArrayChanges); });
+	write_summary_(out, "textureChanges", frames, [] (const BenchmarkFrame& f) { return double(f.textureChanges); });
+	write_summary_(out, "stateCallsIssued", frames, [] (const BenchmarkFrame& f) { return double(f.stateCallsIssued); }, true);
+	std::fprintf(out, "\t}\n");
+	std::fprintf(out, "}\n");
+
+	bool const failed = std::ferror(out) != 0;
+	std::fclose(out);
+	if (failed) throw Error("Writing benchmark results to '%s' failed", aPath);
+}
@@ -0,0 +1,155 @@
+#ifndef FRAME_BENCHMARK_HEADER_FILE
+#define FRAME_BENCHMARK_HEADER_FILE
+
+#include <glad.h>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "../vmlib/vec3.hpp"
+
+// Command line of a benchmark run:
+//
+//   main --bench [--bench-frames N] [--bench-warmup N] [--bench-path FILE]
+//        [--bench-out FILE] [--unthrottled]
+//        [--bench-animation N] [--bench-threaded]
+//   main --record-input FILE | --replay-input FILE
+//   main --gl-calls FILE
+//
+// Without --bench the program runs interactively as usual. Recording and
+// replaying input (see input_recording.hpp) both step the simulation at a
+// fixed rate; a replay may be combined with --bench, in which case the
+// replayed input moves the camera instead of the camera path. --gl-calls
+// counts and times every GL call (see gl_call_profiler.hpp) and writes the
+// totals to FILE on exit; it combines with all of the above.
+//
+// A benchmark simulates on the render thread unless --bench-threaded is
+// given; --bench-animation adds N animation channels to the simulation. The
+// two simulation modes are compared under heavy animation by two runs:
+//
+//   main --bench --unthrottled --bench-animation 100000 --bench-out inline.json
+//   main --bench --unthrottled --bench-animation 100000 --bench-threaded
+//        --bench-out threaded.json
+//
+// and the avg and p95 of frameMs and cpuMs in the two files.
+struct BenchmarkOptions
+{
+	bool enabled = false;
+	int frames = 1000;
+	// frames rendered before measuring starts (shader compiles, uploads)
+	int warmupFrames = 60;
+	// vsync off
+	bool unthrottled = false;
+	// simulate on a SimulationThread instead of the render thread
+	bool threadedSimulation = false;
+	// extra channels in the animation system
+	int animationChannels = 0;
+	// recorded camera path; empty for the built-in fly-through
+	std::string cameraPath;
+	std::string output = "bench.json";
+	// at most one of these is set
+	std::string recordInput;
+	std::string replayInput;
+	// empty unless GL calls are profiled
+	std::string glCallsOutput;
+};
+
+// throws Error for unknown or malformed arguments
+BenchmarkOptions parse_benchmark_options(int aArgc, char** aArgv);
+
+// Camera pose at a point in time. The position is the camera's translation
+// as in cameraControl (the negated eye position).
+struct CameraKey
+{
+	float time;
+	Vec3f position;
+	float theta, phi;
+};
+
+// Camera poses over time, linearly interpolated. Recorded from the
+// interactive mode and saved as text, one "time x y z theta phi" per line.
+class CameraPath
+{
+	std::vector<CameraKey> keys;
+
+public:
+	// keys must be added in time order
+	void add(const CameraKey& aKey) { keys.push_back(aKey); }
+	void clear() { keys.clear(); }
+
+	// throw Error if the file cannot be read or written
+	void load(const char* aPath);
+	void save(const char* aPath) const;
+
+	// clamped to the first and last key
+	CameraKey sample(float aTime) const;
+	float duration() const { return keys.empty() ? 0.f : keys.back().time; }
+	size_t size() const { return keys.size(); }
+};
+
+// a loop around the room, looking at its centre
+CameraPath make_default_fly_through();
+
+// GPU time of whole frames, from GL_TIMESTAMP queries written at the start
+// and end of each frame. Unlike GL_TIME_ELAPSED these may overlap other
+// timer queries (see PathCrowd). Results arrive a few frames late, so they
+// are handed out together with the number of the frame they belong to.
+class GpuFrameTimer
+{
+	static constexpr size_t kFramesInFlight = 4;
+
+	GLuint queries[kFramesInFlight * 2];
+	std::uint64_t frameOf[kFramesInFlight];
+	bool pending[kFramesInFlight] = {};
+	size_t next = 0;
+
+public:
+	GpuFrameTimer();
+	~GpuFrameTimer();
+
+	GpuFrameTimer(const GpuFrameTimer&) = delete;
+	GpuFrameTimer& operator=(const GpuFrameTimer&) = delete;
+
+	void begin(std::uint64_t aFrame);
+	void end();
+
+	// oldest finished frame, if any; with aWait, waits for the oldest
+	// pending one instead
+	bool collect(std::uint64_t& aFrame, float& aMs, bool aWait = false);
+};
+
+struct BenchmarkFrame
+{
+	// start of the frame to the return of glfwSwapBuffers()
+	float frameMs = 0.f;
+	// up to the swap
+	float cpuMs = 0.f;
+	float simulationMs = 0.f;
+	// negative until known
+	float gpuMs = -1.f;
+
+	size_t draws = 0;
+	size_t programChanges = 0;
+	size_t vertexArrayChanges = 0;
+	size_t textureChanges = 0;
+	size_t stateCallsIssued = 0;
+};
+
+// Collects the measured frames and writes average, median, 95th and 99th
+// percentile and maximum of each quantity as JSON.
+class BenchmarkReport
+{
+	std::vector<BenchmarkFrame> frames;
+
+public:
+	void reserve(size_t aFrames) { frames.reserve(aFrames); }
+	BenchmarkFrame& add() { return frames.emplace_back(); }
+	BenchmarkFrame& frame(size_t aIndex) { return frames[aIndex]; }
+	size_t size() const { return frames.size(); }
+
+	// throws Error if the file cannot be written
+	void writeJson(const char* aPath, const BenchmarkOptions& aOptions, float aTimeStep, const char* aRenderer) const;
+};
+
+#endif//FRAME_BENCHMARK_HEADER_FILE
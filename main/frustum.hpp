@@ -0,0 +1,48 @@
+#ifndef FRUSTUM_HEADER_FILE
+#define FRUSTUM_HEADER_FILE
+
+#include <cmath>
+
+#include "../vmlib/vec3.hpp"
+#include "../vmlib/vec4.hpp"
+#include "../vmlib/mat44.hpp"
+
+// View frustum as six planes (xyz: inward normal, w: offset), in the space
+// that the matrix it was made from transforms out of.
+struct Frustum
+{
+	Vec4f planes[6];
+};
+
+// Planes of a projection(-camera-world) matrix, following Gribb and Hartmann
+inline Frustum make_frustum(const Mat44f& aProjCamera)
+{
+	auto row = [&] (std::size_t aRow) {
+		return Vec4f{ aProjCamera(aRow, 0), aProjCamera(aRow, 1), aProjCamera(aRow, 2), aProjCamera(aRow, 3) };
+	};
+
+	Vec4f const x = row(0), y = row(1), z = row(2), w = row(3);
+
+	Frustum frustum{ { w + x, w - x, w + y, w - y, w + z, w - z } };
+	for (auto& plane : frustum.planes)
+	{
+		float const length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+		plane = plane / length;
+	}
+	return frustum;
+}
+
+// conservative: true if any part of the sphere may be visible
+inline bool sphere_in_frustum(const Frustum& aFrustum, Vec3f aCentre, float aRadius)
+{
+	for (auto const& plane : aFrustum.planes)
+	{
+		if (plane.x * aCentre.x + plane.y * aCentre.y + plane.z * aCentre.z + plane.w < -aRadius)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+#endif//FRUSTUM_HEADER_FILE
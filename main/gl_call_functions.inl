@@ -0,0 +1,715 @@
+// Every entry point in third_party/glad/include/glad.h (gl 4.6 core and the
+// debug extensions), for the GL call profiler. Regenerate after updating glad:
+//
+//   grep -oE "^#define (gl[A-Za-z0-9_]+) glad_\\1$" glad.h | awk '{print "GL_CALL_FUNCTION(" $2 ")"}'
+//
+// Include with GL_CALL_FUNCTION(name) defined.
+
+GL_CALL_FUNCTION(glCullFace)
+GL_CALL_FUNCTION(glFrontFace)
+GL_CALL_FUNCTION(glHint)
+GL_CALL_FUNCTION(glLineWidth)
+GL_CALL_FUNCTION(glPointSize)
+GL_CALL_FUNCTION(glPolygonMode)
+GL_CALL_FUNCTION(glScissor)
+GL_CALL_FUNCTION(glTexParameterf)
+GL_CALL_FUNCTION(glTexParameterfv)
+GL_CALL_FUNCTION(glTexParameteri)
+GL_CALL_FUNCTION(glTexParameteriv)
+GL_CALL_FUNCTION(glTexImage1D)
+GL_CALL_FUNCTION(glTexImage2D)
+GL_CALL_FUNCTION(glDrawBuffer)
+GL_CALL_FUNCTION(glClear)
+GL_CALL_FUNCTION(glClearColor)
+GL_CALL_FUNCTION(glClearStencil)
+GL_CALL_FUNCTION(glClearDepth)
+GL_CALL_FUNCTION(glStencilMask)
+GL_CALL_FUNCTION(glColorMask)
+GL_CALL_FUNCTION(glDepthMask)
+GL_CALL_FUNCTION(glDisable)
+GL_CALL_FUNCTION(glEnable)
+GL_CALL_FUNCTION(glFinish)
+GL_CALL_FUNCTION(glFlush)
+GL_CALL_FUNCTION(glBlendFunc)
+GL_CALL_FUNCTION(glLogicOp)
+GL_CALL_FUNCTION(glStencilFunc)
+GL_CALL_FUNCTION(glStencilOp)
+GL_CALL_FUNCTION(glDepthFunc)
+GL_CALL_FUNCTION(glPixelStoref)
+GL_CALL_FUNCTION(glPixelStorei)
+GL_CALL_FUNCTION(glReadBuffer)
+GL_CALL_FUNCTION(glReadPixels)
+GL_CALL_FUNCTION(glGetBooleanv)
+GL_CALL_FUNCTION(glGetDoublev)
+GL_CALL_FUNCTION(glGetError)
+GL_CALL_FUNCTION(glGetFloatv)
+GL_CALL_FUNCTION(glGetIntegerv)
+GL_CALL_FUNCTION(glGetString)
+GL_CALL_FUNCTION(glGetTexImage)
+GL_CALL_FUNCTION(glGetTexParameterfv)
+GL_CALL_FUNCTION(glGetTexParameteriv)
+GL_CALL_FUNCTION(glGetTexLevelParameterfv)
+GL_CALL_FUNCTION(glGetTexLevelParameteriv)
+GL_CALL_FUNCTION(glIsEnabled)
+GL_CALL_FUNCTION(glDepthRange)
+GL_CALL_FUNCTION(glViewport)
+GL_CALL_FUNCTION(glDrawArrays)
+GL_CALL_FUNCTION(glDrawElements)
+GL_CALL_FUNCTION(glPolygonOffset)
+GL_CALL_FUNCTION(glCopyTexImage1D)
+GL_CALL_FUNCTION(glCopyTexImage2D)
+GL_CALL_FUNCTION(glCopyTexSubImage1D)
+GL_CALL_FUNCTION(glCopyTexSubImage2D)
+GL_CALL_FUNCTION(glTexSubImage1D)
+GL_CALL_FUNCTION(glTexSubImage2D)
+GL_CALL_FUNCTION(glBindTexture)
+GL_CALL_FUNCTION(glDeleteTextures)
+GL_CALL_FUNCTION(glGenTextures)
+GL_CALL_FUNCTION(glIsTexture)
+GL_CALL_FUNCTION(glDrawRangeElements)
+GL_CALL_FUNCTION(glTexImage3D)
+GL_CALL_FUNCTION(glTexSubImage3D)
+GL_CALL_FUNCTION(glCopyTexSubImage3D)
+GL_CALL_FUNCTION(glActiveTexture)
+GL_CALL_FUNCTION(glSampleCoverage)
+GL_CALL_FUNCTION(glCompressedTexImage3D)
+GL_CALL_FUNCTION(glCompressedTexImage2D)
+GL_CALL_FUNCTION(glCompressedTexImage1D)
+GL_CALL_FUNCTION(glCompressedTexSubImage3D)
+GL_CALL_FUNCTION(glCompressedTexSubImage2D)
+GL_CALL_FUNCTION(glCompressedTexSubImage1D)
+GL_CALL_FUNCTION(glGetCompressedTexImage)
+GL_CALL_FUNCTION(glBlendFuncSeparate)
+GL_CALL_FUNCTION(glMultiDrawArrays)
+GL_CALL_FUNCTION(glMultiDrawElements)
+GL_CALL_FUNCTION(glPointParameterf)
+GL_CALL_FUNCTION(glPointParameterfv)
+GL_CALL_FUNCTION(glPointParameteri)
+GL_CALL_FUNCTION(glPointParameteriv)
+GL_CALL_FUNCTION(glBlendColor)
+GL_CALL_FUNCTION(glBlendEquation)
+GL_CALL_FUNCTION(glGenQueries)
+GL_CALL_FUNCTION(glDeleteQueries)
+GL_CALL_FUNCTION(glIsQuery)
+GL_CALL_FUNCTION(glBeginQuery)
+GL_CALL_FUNCTION(glEndQuery)
+GL_CALL_FUNCTION(glGetQueryiv)
+GL_CALL_FUNCTION(glGetQueryObjectiv)
+GL_CALL_FUNCTION(glGetQueryObjectuiv)
+GL_CALL_FUNCTION(glBindBuffer)
+GL_CALL_FUNCTION(glDeleteBuffers)
+GL_CALL_FUNCTION(glGenBuffers)
+GL_CALL_FUNCTION(glIsBuffer)
+GL_CALL_FUNCTION(glBufferData)
+GL_CALL_FUNCTION(glBufferSubData)
+GL_CALL_FUNCTION(glGetBufferSubData)
+GL_CALL_FUNCTION(glMapBuffer)
+GL_CALL_FUNCTION(glUnmapBuffer)
+GL_CALL_FUNCTION(glGetBufferParameteriv)
+GL_CALL_FUNCTION(glGetBufferPointerv)
+GL_CALL_FUNCTION(glBlendEquationSeparate)
+GL_CALL_FUNCTION(glDrawBuffers)
+GL_CALL_FUNCTION(glStencilOpSeparate)
+GL_CALL_FUNCTION(glStencilFuncSeparate)
+GL_CALL_FUNCTION(glStencilMaskSeparate)
+GL_CALL_FUNCTION(glAttachShader)
+GL_CALL_FUNCTION(glBindAttribLocation)
+GL_CALL_FUNCTION(glCompileShader)
+GL_CALL_FUNCTION(glCreateProgram)
+GL_CALL_FUNCTION(glCreateShader)
+GL_CALL_FUNCTION(glDeleteProgram)
+GL_CALL_FUNCTION(glDeleteShader)
+GL_CALL_FUNCTION(glDetachShader)
+GL_CALL_FUNCTION(glDisableVertexAttribArray)
+GL_CALL_FUNCTION(glEnableVertexAttribArray)
+GL_CALL_FUNCTION(glGetActiveAttrib)
+GL_CALL_FUNCTION(glGetActiveUniform)
+GL_CALL_FUNCTION(glGetAttachedShaders)
+GL_CALL_FUNCTION(glGetAttribLocation)
+GL_CALL_FUNCTION(glGetProgramiv)
+GL_CALL_FUNCTION(glGetProgramInfoLog)
+GL_CALL_FUNCTION(glGetShaderiv)
+GL_CALL_FUNCTION(glGetShaderInfoLog)
+GL_CALL_FUNCTION(glGetShaderSource)
+GL_CALL_FUNCTION(glGetUniformLocation)
+GL_CALL_FUNCTION(glGetUniformfv)
+GL_CALL_FUNCTION(glGetUniformiv)
+GL_CALL_FUNCTION(glGetVertexAttribdv)
+GL_CALL_FUNCTION(glGetVertexAttribfv)
+GL_CALL_FUNCTION(glGetVertexAttribiv)
+GL_CALL_FUNCTION(glGetVertexAttribPointerv)
+GL_CALL_FUNCTION(glIsProgram)
+GL_CALL_FUNCTION(glIsShader)
+GL_CALL_FUNCTION(glLinkProgram)
+GL_CALL_FUNCTION(glShaderSource)
+GL_CALL_FUNCTION(glUseProgram)
+GL_CALL_FUNCTION(glUniform1f)
+GL_CALL_FUNCTION(glUniform2f)
+GL_CALL_FUNCTION(glUniform3f)
+GL_CALL_FUNCTION(glUniform4f)
+GL_CALL_FUNCTION(glUniform1i)
+GL_CALL_FUNCTION(glUniform2i)
+GL_CALL_FUNCTION(glUniform3i)
+GL_CALL_FUNCTION(glUniform4i)
+GL_CALL_FUNCTION(glUniform1fv)
+GL_CALL_FUNCTION(glUniform2fv)
+GL_CALL_FUNCTION(glUniform3fv)
+GL_CALL_FUNCTION(glUniform4fv)
+GL_CALL_FUNCTION(glUniform1iv)
+GL_CALL_FUNCTION(glUniform2iv)
+GL_CALL_FUNCTION(glUniform3iv)
+GL_CALL_FUNCTION(glUniform4iv)
+GL_CALL_FUNCTION(glUniformMatrix2fv)
+GL_CALL_FUNCTION(glUniformMatrix3fv)
+GL_CALL_FUNCTION(glUniformMatrix4fv)
+GL_CALL_FUNCTION(glValidateProgram)
+GL_CALL_FUNCTION(glVertexAttrib1d)
+GL_CALL_FUNCTION(glVertexAttrib1dv)
+GL_CALL_FUNCTION(glVertexAttrib1f)
+GL_CALL_FUNCTION(glVertexAttrib1fv)
+GL_CALL_FUNCTION(glVertexAttrib1s)
+GL_CALL_FUNCTION(glVertexAttrib1sv)
+GL_CALL_FUNCTION(glVertexAttrib2d)
+GL_CALL_FUNCTION(glVertexAttrib2dv)
+GL_CALL_FUNCTION(glVertexAttrib2f)
+GL_CALL_FUNCTION(glVertexAttrib2fv)
+GL_CALL_FUNCTION(glVertexAttrib2s)
+GL_CALL_FUNCTION(glVertexAttrib2sv)
+GL_CALL_FUNCTION(glVertexAttrib3d)
+GL_CALL_FUNCTION(glVertexAttrib3dv)
+GL_CALL_FUNCTION(glVertexAttrib3f)
+GL_CALL_FUNCTION(glVertexAttrib3fv)
+GL_CALL_FUNCTION(glVertexAttrib3s)
+GL_CALL_FUNCTION(glVertexAttrib3sv)
+GL_CALL_FUNCTION(glVertexAttrib4Nbv)
+GL_CALL_FUNCTION(glVertexAttrib4Niv)
+GL_CALL_FUNCTION(glVertexAttrib4Nsv)
+GL_CALL_FUNCTION(glVertexAttrib4Nub)
+GL_CALL_FUNCTION(glVertexAttrib4Nubv)
+GL_CALL_FUNCTION(glVertexAttrib4Nuiv)
+GL_CALL_FUNCTION(glVertexAttrib4Nusv)
+GL_CALL_FUNCTION(glVertexAttrib4bv)
+GL_CALL_FUNCTION(glVertexAttrib4d)
+GL_CALL_FUNCTION(glVertexAttrib4dv)
+GL_CALL_FUNCTION(glVertexAttrib4f)
+GL_CALL_FUNCTION(glVertexAttrib4fv)
+GL_CALL_FUNCTION(glVertexAttrib4iv)
+GL_CALL_FUNCTION(glVertexAttrib4s)
+GL_CALL_FUNCTION(glVertexAttrib4sv)
+GL_CALL_FUNCTION(glVertexAttrib4ubv)
+GL_CALL_FUNCTION(glVertexAttrib4uiv)
+GL_CALL_FUNCTION(glVertexAttrib4usv)
+GL_CALL_FUNCTION(glVertexAttribPointer)
+GL_CALL_FUNCTION(glUniformMatrix2x3fv)
+GL_CALL_FUNCTION(glUniformMatrix3x2fv)
+GL_CALL_FUNCTION(glUniformMatrix2x4fv)
+GL_CALL_FUNCTION(glUniformMatrix4x2fv)
+GL_CALL_FUNCTION(glUniformMatrix3x4fv)
+GL_CALL_FUNCTION(glUniformMatrix4x3fv)
+GL_CALL_FUNCTION(glColorMaski)
+GL_CALL_FUNCTION(glGetBooleani_v)
+GL_CALL_FUNCTION(glGetIntegeri_v)
+GL_CALL_FUNCTION(glEnablei)
+GL_CALL_FUNCTION(glDisablei)
+GL_CALL_FUNCTION(glIsEnabledi)
+GL_CALL_FUNCTION(glBeginTransformFeedback)
+GL_CALL_FUNCTION(glEndTransformFeedback)
+GL_CALL_FUNCTION(glBindBufferRange)
+GL_CALL_FUNCTION(glBindBufferBase)
+GL_CALL_FUNCTION(glTransformFeedbackVaryings)
+GL_CALL_FUNCTION(glGetTransformFeedbackVarying)
+GL_CALL_FUNCTION(glClampColor)
+GL_CALL_FUNCTION(glBeginConditionalRender)
+GL_CALL_FUNCTION(glEndConditionalRender)
+GL_CALL_FUNCTION(glVertexAttribIPointer)
+GL_CALL_FUNCTION(glGetVertexAttribIiv)
+GL_CALL_FUNCTION(glGetVertexAttribIuiv)
+GL_CALL_FUNCTION(glVertexAttribI1i)
+GL_CALL_FUNCTION(glVertexAttribI2i)
+GL_CALL_FUNCTION(glVertexAttribI3i)
+GL_CALL_FUNCTION(glVertexAttribI4i)
+GL_CALL_FUNCTION(glVertexAttribI1ui)
+GL_CALL_FUNCTION(glVertexAttribI2ui)
+GL_CALL_FUNCTION(glVertexAttribI3ui)
+GL_CALL_FUNCTION(glVertexAttribI4ui)
+GL_CALL_FUNCTION(glVertexAttribI1iv)
+GL_CALL_FUNCTION(glVertexAttribI2iv)
+GL_CALL_FUNCTION(glVertexAttribI3iv)
+GL_CALL_FUNCTION(glVertexAttribI4iv)
+GL_CALL_FUNCTION(glVertexAttribI1uiv)
+GL_CALL_FUNCTION(glVertexAttribI2uiv)
+GL_CALL_FUNCTION(glVertexAttribI3uiv)
+GL_CALL_FUNCTION(glVertexAttribI4uiv)
+GL_CALL_FUNCTION(glVertexAttribI4bv)
+GL_CALL_FUNCTION(glVertexAttribI4sv)
+GL_CALL_FUNCTION(glVertexAttribI4ubv)
+GL_CALL_FUNCTION(glVertexAttribI4usv)
+GL_CALL_FUNCTION(glGetUniformuiv)
+GL_CALL_FUNCTION(glBindFragDataLocation)
+GL_CALL_FUNCTION(glGetFragDataLocation)
+GL_CALL_FUNCTION(glUniform1ui)
+GL_CALL_FUNCTION(glUniform2ui)
+GL_CALL_FUNCTION(glUniform3ui)
+GL_CALL_FUNCTION(glUniform4ui)
+GL_CALL_FUNCTION(glUniform1uiv)
+GL_CALL_FUNCTION(glUniform2uiv)
+GL_CALL_FUNCTION(glUniform3uiv)
+GL_CALL_FUNCTION(glUniform4uiv)
+GL_CALL_FUNCTION(glTexParameterIiv)
+GL_CALL_FUNCTION(glTexParameterIuiv)
+GL_CALL_FUNCTION(glGetTexParameterIiv)
+GL_CALL_FUNCTION(glGetTexParameterIuiv)
+GL_CALL_FUNCTION(glClearBufferiv)
+GL_CALL_FUNCTION(glClearBufferuiv)
+GL_CALL_FUNCTION(glClearBufferfv)
+GL_CALL_FUNCTION(glClearBufferfi)
+GL_CALL_FUNCTION(glGetStringi)
+GL_CALL_FUNCTION(glIsRenderbuffer)
+GL_CALL_FUNCTION(glBindRenderbuffer)
+GL_CALL_FUNCTION(glDeleteRenderbuffers)
+GL_CALL_FUNCTION(glGenRenderbuffers)
+GL_CALL_FUNCTION(glRenderbufferStorage)
+GL_CALL_FUNCTION(glGetRenderbufferParameteriv)
+GL_CALL_FUNCTION(glIsFramebuffer)
+GL_CALL_FUNCTION(glBindFramebuffer)
+GL_CALL_FUNCTION(glDeleteFramebuffers)
+GL_CALL_FUNCTION(glGenFramebuffers)
+GL_CALL_FUNCTION(glCheckFramebufferStatus)
+GL_CALL_FUNCTION(glFramebufferTexture1D)
+GL_CALL_FUNCTION(glFramebufferTexture2D)
+GL_CALL_FUNCTION(glFramebufferTexture3D)
+GL_CALL_FUNCTION(glFramebufferRenderbuffer)
+GL_CALL_FUNCTION(glGetFramebufferAttachmentParameteriv)
+GL_CALL_FUNCTION(glGenerateMipmap)
+GL_CALL_FUNCTION(glBlitFramebuffer)
+GL_CALL_FUNCTION(glRenderbufferStorageMultisample)
+GL_CALL_FUNCTION(glFramebufferTextureLayer)
+GL_CALL_FUNCTION(glMapBufferRange)
+GL_CALL_FUNCTION(glFlushMappedBufferRange)
+GL_CALL_FUNCTION(glBindVertexArray)
+GL_CALL_FUNCTION(glDeleteVertexArrays)
+GL_CALL_FUNCTION(glGenVertexArrays)
+GL_CALL_FUNCTION(glIsVertexArray)
+GL_CALL_FUNCTION(glDrawArraysInstanced)
+GL_CALL_FUNCTION(glDrawElementsInstanced)
+GL_CALL_FUNCTION(glTexBuffer)
+GL_CALL_FUNCTION(glPrimitiveRestartIndex)
+GL_CALL_FUNCTION(glCopyBufferSubData)
+GL_CALL_FUNCTION(glGetUniformIndices)
+GL_CALL_FUNCTION(glGetActiveUniformsiv)
+GL_CALL_FUNCTION(glGetActiveUniformName)
+GL_CALL_FUNCTION(glGetUniformBlockIndex)
+GL_CALL_FUNCTION(glGetActiveUniformBlockiv)
+GL_CALL_FUNCTION(glGetActiveUniformBlockName)
+GL_CALL_FUNCTION(glUniformBlockBinding)
+GL_CALL_FUNCTION(glDrawElementsBaseVertex)
+GL_CALL_FUNCTION(glDrawRangeElementsBaseVertex)
+GL_CALL_FUNCTION(glDrawElementsInstancedBaseVertex)
+GL_CALL_FUNCTION(glMultiDrawElementsBaseVertex)
+GL_CALL_FUNCTION(glProvokingVertex)
+GL_CALL_FUNCTION(glFenceSync)
+GL_CALL_FUNCTION(glIsSync)
+GL_CALL_FUNCTION(glDeleteSync)
+GL_CALL_FUNCTION(glClientWaitSync)
+GL_CALL_FUNCTION(glWaitSync)
+GL_CALL_FUNCTION(glGetInteger64v)
+GL_CALL_FUNCTION(glGetSynciv)
+GL_CALL_FUNCTION(glGetInteger64i_v)
+GL_CALL_FUNCTION(glGetBufferParameteri64v)
+GL_CALL_FUNCTION(glFramebufferTexture)
+GL_CALL_FUNCTION(glTexImage2DMultisample)
+GL_CALL_FUNCTION(glTexImage3DMultisample)
+GL_CALL_FUNCTION(glGetMultisamplefv)
+GL_CALL_FUNCTION(glSampleMaski)
+GL_CALL_FUNCTION(glBindFragDataLocationIndexed)
+GL_CALL_FUNCTION(glGetFragDataIndex)
+GL_CALL_FUNCTION(glGenSamplers)
+GL_CALL_FUNCTION(glDeleteSamplers)
+GL_CALL_FUNCTION(glIsSampler)
+GL_CALL_FUNCTION(glBindSampler)
+GL_CALL_FUNCTION(glSamplerParameteri)
+GL_CALL_FUNCTION(glSamplerParameteriv)
+GL_CALL_FUNCTION(glSamplerParameterf)
+GL_CALL_FUNCTION(glSamplerParameterfv)
+GL_CALL_FUNCTION(glSamplerParameterIiv)
+GL_CALL_FUNCTION(glSamplerParameterIuiv)
+GL_CALL_FUNCTION(glGetSamplerParameteriv)
+GL_CALL_FUNCTION(glGetSamplerParameterIiv)
+GL_CALL_FUNCTION(glGetSamplerParameterfv)
+GL_CALL_FUNCTION(glGetSamplerParameterIuiv)
+GL_CALL_FUNCTION(glQueryCounter)
+GL_CALL_FUNCTION(glGetQueryObjecti64v)
+GL_CALL_FUNCTION(glGetQueryObjectui64v)
+GL_CALL_FUNCTION(glVertexAttribDivisor)
+GL_CALL_FUNCTION(glVertexAttribP1ui)
+GL_CALL_FUNCTION(glVertexAttribP1uiv)
+GL_CALL_FUNCTION(glVertexAttribP2ui)
+GL_CALL_FUNCTION(glVertexAttribP2uiv)
+GL_CALL_FUNCTION(glVertexAttribP3ui)
+GL_CALL_FUNCTION(glVertexAttribP3uiv)
+GL_CALL_FUNCTION(glVertexAttribP4ui)
+GL_CALL_FUNCTION(glVertexAttribP4uiv)
+GL_CALL_FUNCTION(glVertexP2ui)
+GL_CALL_FUNCTION(glVertexP2uiv)
+GL_CALL_FUNCTION(glVertexP3ui)
+GL_CALL_FUNCTION(glVertexP3uiv)
+GL_CALL_FUNCTION(glVertexP4ui)
+GL_CALL_FUNCTION(glVertexP4uiv)
+GL_CALL_FUNCTION(glTexCoordP1ui)
+GL_CALL_FUNCTION(glTexCoordP1uiv)
+GL_CALL_FUNCTION(glTexCoordP2ui)
+GL_CALL_FUNCTION(glTexCoordP2uiv)
+GL_CALL_FUNCTION(glTexCoordP3ui)
+GL_CALL_FUNCTION(glTexCoordP3uiv)
+GL_CALL_FUNCTION(glTexCoordP4ui)
+GL_CALL_FUNCTION(glTexCoordP4uiv)
+GL_CALL_FUNCTION(glMultiTexCoordP1ui)
+GL_CALL_FUNCTION(glMultiTexCoordP1uiv)
+GL_CALL_FUNCTION(glMultiTexCoordP2ui)
+GL_CALL_FUNCTION(glMultiTexCoordP2uiv)
+GL_CALL_FUNCTION(glMultiTexCoordP3ui)
+GL_CALL_FUNCTION(glMultiTexCoordP3uiv)
+GL_CALL_FUNCTION(glMultiTexCoordP4ui)
+GL_CALL_FUNCTION(glMultiTexCoordP4uiv)
+GL_CALL_FUNCTION(glNormalP3ui)
+GL_CALL_FUNCTION(glNormalP3uiv)
+GL_CALL_FUNCTION(glColorP3ui)
+GL_CALL_FUNCTION(glColorP3uiv)
+GL_CALL_FUNCTION(glColorP4ui)
+GL_CALL_FUNCTION(glColorP4uiv)
+GL_CALL_FUNCTION(glSecondaryColorP3ui)
+GL_CALL_FUNCTION(glSecondaryColorP3uiv)
+GL_CALL_FUNCTION(glMinSampleShading)
+GL_CALL_FUNCTION(glBlendEquationi)
+GL_CALL_FUNCTION(glBlendEquationSeparatei)
+GL_CALL_FUNCTION(glBlendFunci)
+GL_CALL_FUNCTION(glBlendFuncSeparatei)
+GL_CALL_FUNCTION(glDrawArraysIndirect)
+GL_CALL_FUNCTION(glDrawElementsIndirect)
+GL_CALL_FUNCTION(glUniform1d)
+GL_CALL_FUNCTION(glUniform2d)
+GL_CALL_FUNCTION(glUniform3d)
+GL_CALL_FUNCTION(glUniform4d)
+GL_CALL_FUNCTION(glUniform1dv)
+GL_CALL_FUNCTION(glUniform2dv)
+GL_CALL_FUNCTION(glUniform3dv)
+GL_CALL_FUNCTION(glUniform4dv)
+GL_CALL_FUNCTION(glUniformMatrix2dv)
+GL_CALL_FUNCTION(glUniformMatrix3dv)
+GL_CALL_FUNCTION(glUniformMatrix4dv)
+GL_CALL_FUNCTION(glUniformMatrix2x3dv)
+GL_CALL_FUNCTION(glUniformMatrix2x4dv)
+GL_CALL_FUNCTION(glUniformMatrix3x2dv)
+GL_CALL_FUNCTION(glUniformMatrix3x4dv)
+GL_CALL_FUNCTION(glUniformMatrix4x2dv)
+GL_CALL_FUNCTION(glUniformMatrix4x3dv)
+GL_CALL_FUNCTION(glGetUniformdv)
+GL_CALL_FUNCTION(glGetSubroutineUniformLocation)
+GL_CALL_FUNCTION(glGetSubroutineIndex)
+GL_CALL_FUNCTION(glGetActiveSubroutineUniformiv)
+GL_CALL_FUNCTION(glGetActiveSubroutineUniformName)
+GL_CALL_FUNCTION(glGetActiveSubroutineName)
+GL_CALL_FUNCTION(glUniformSubroutinesuiv)
+GL_CALL_FUNCTION(glGetUniformSubroutineuiv)
+GL_CALL_FUNCTION(glGetProgramStageiv)
+GL_CALL_FUNCTION(glPatchParameteri)
+GL_CALL_FUNCTION(glPatchParameterfv)
+GL_CALL_FUNCTION(glBindTransformFeedback)
+GL_CALL_FUNCTION(glDeleteTransformFeedbacks)
+GL_CALL_FUNCTION(glGenTransformFeedbacks)
+GL_CALL_FUNCTION(glIsTransformFeedback)
+GL_CALL_FUNCTION(glPauseTransformFeedback)
+GL_CALL_FUNCTION(glResumeTransformFeedback)
+GL_CALL_FUNCTION(glDrawTransformFeedback)
+GL_CALL_FUNCTION(glDrawTransformFeedbackStream)
+GL_CALL_FUNCTION(glBeginQueryIndexed)
+GL_CALL_FUNCTION(glEndQueryIndexed)
+GL_CALL_FUNCTION(glGetQueryIndexediv)
+GL_CALL_FUNCTION(glReleaseShaderCompiler)
+GL_CALL_FUNCTION(glShaderBinary)
+GL_CALL_FUNCTION(glGetShaderPrecisionFormat)
+GL_CALL_FUNCTION(glDepthRangef)
+GL_CALL_FUNCTION(glClearDepthf)
+GL_CALL_FUNCTION(glGetProgramBinary)
+GL_CALL_FUNCTION(glProgramBinary)
+GL_CALL_FUNCTION(glProgramParameteri)
+GL_CALL_FUNCTION(glUseProgramStages)
+GL_CALL_FUNCTION(glActiveShaderProgram)
+GL_CALL_FUNCTION(glCreateShaderProgramv)
+GL_CALL_FUNCTION(glBindProgramPipeline)
+GL_CALL_FUNCTION(glDeleteProgramPipelines)
+GL_CALL_FUNCTION(glGenProgramPipelines)
+GL_CALL_FUNCTION(glIsProgramPipeline)
+GL_CALL_FUNCTION(glGetProgramPipelineiv)
+GL_CALL_FUNCTION(glProgramUniform1i)
+GL_CALL_FUNCTION(glProgramUniform1iv)
+GL_CALL_FUNCTION(glProgramUniform1f)
+GL_CALL_FUNCTION(glProgramUniform1fv)
+GL_CALL_FUNCTION(glProgramUniform1d)
+GL_CALL_FUNCTION(glProgramUniform1dv)
+GL_CALL_FUNCTION(glProgramUniform1ui)
+GL_CALL_FUNCTION(glProgramUniform1uiv)
+GL_CALL_FUNCTION(glProgramUniform2i)
+GL_CALL_FUNCTION(glProgramUniform2iv)
+GL_CALL_FUNCTION(glProgramUniform2f)
+GL_CALL_FUNCTION(glProgramUniform2fv)
+GL_CALL_FUNCTION(glProgramUniform2d)
+GL_CALL_FUNCTION(glProgramUniform2dv)
+GL_CALL_FUNCTION(glProgramUniform2ui)
+GL_CALL_FUNCTION(glProgramUniform2uiv)
+GL_CALL_FUNCTION(glProgramUniform3i)
+GL_CALL_FUNCTION(glProgramUniform3iv)
+GL_CALL_FUNCTION(glProgramUniform3f)
+GL_CALL_FUNCTION(glProgramUniform3fv)
+GL_CALL_FUNCTION(glProgramUniform3d)
+GL_CALL_FUNCTION(glProgramUniform3dv)
+GL_CALL_FUNCTION(glProgramUniform3ui)
+GL_CALL_FUNCTION(glProgramUniform3uiv)
+GL_CALL_FUNCTION(glProgramUniform4i)
+GL_CALL_FUNCTION(glProgramUniform4iv)
+GL_CALL_FUNCTION(glProgramUniform4f)
+GL_CALL_FUNCTION(glProgramUniform4fv)
+GL_CALL_FUNCTION(glProgramUniform4d)
+GL_CALL_FUNCTION(glProgramUniform4dv)
+GL_CALL_FUNCTION(glProgramUniform4ui)
+GL_CALL_FUNCTION(glProgramUniform4uiv)
+GL_CALL_FUNCTION(glProgramUniformMatrix2fv)
+GL_CALL_FUNCTION(glProgramUniformMatrix3fv)
+GL_CALL_FUNCTION(glProgramUniformMatrix4fv)
+GL_CALL_FUNCTION(glProgramUniformMatrix2dv)
+GL_CALL_FUNCTION(glProgramUniformMatrix3dv)
+GL_CALL_FUNCTION(glProgramUniformMatrix4dv)
+GL_CALL_FUNCTION(glProgramUniformMatrix2x3fv)
+GL_CALL_FUNCTION(glProgramUniformMatrix3x2fv)
+GL_CALL_FUNCTION(glProgramUniformMatrix2x4fv)
+GL_CALL_FUNCTION(glProgramUniformMatrix4x2fv)
+GL_CALL_FUNCTION(glProgramUniformMatrix3x4fv)
+GL_CALL_FUNCTION(glProgramUniformMatrix4x3fv)
+GL_CALL_FUNCTION(glProgramUniformMatrix2x3dv)
+GL_CALL_FUNCTION(glProgramUniformMatrix3x2dv)
+GL_CALL_FUNCTION(glProgramUniformMatrix2x4dv)
+GL_CALL_FUNCTION(glProgramUniformMatrix4x2dv)
+GL_CALL_FUNCTION(glProgramUniformMatrix3x4dv)
+GL_CALL_FUNCTION(glProgramUniformMatrix4x3dv)
+GL_CALL_FUNCTION(glValidateProgramPipeline)
+GL_CALL_FUNCTION(glGetProgramPipelineInfoLog)
+GL_CALL_FUNCTION(glVertexAttribL1d)
+GL_CALL_FUNCTION(glVertexAttribL2d)
+GL_CALL_FUNCTION(glVertexAttribL3d)
+GL_CALL_FUNCTION(glVertexAttribL4d)
+GL_CALL_FUNCTION(glVertexAttribL1dv)
+GL_CALL_FUNCTION(glVertexAttribL2dv)
+GL_CALL_FUNCTION(glVertexAttribL3dv)
+GL_CALL_FUNCTION(glVertexAttribL4dv)
+GL_CALL_FUNCTION(glVertexAttribLPointer)
+GL_CALL_FUNCTION(glGetVertexAttribLdv)
+GL_CALL_FUNCTION(glViewportArrayv)
+GL_CALL_FUNCTION(glViewportIndexedf)
+GL_CALL_FUNCTION(glViewportIndexedfv)
+GL_CALL_FUNCTION(glScissorArrayv)
+GL_CALL_FUNCTION(glScissorIndexed)
+GL_CALL_FUNCTION(glScissorIndexedv)
+GL_CALL_FUNCTION(glDepthRangeArrayv)
+GL_CALL_FUNCTION(glDepthRangeIndexed)
+GL_CALL_FUNCTION(glGetFloati_v)
+GL_CALL_FUNCTION(glGetDoublei_v)
+GL_CALL_FUNCTION(glDrawArraysInstancedBaseInstance)
+GL_CALL_FUNCTION(glDrawElementsInstancedBaseInstance)
+GL_CALL_FUNCTION(glDrawElementsInstancedBaseVertexBaseInstance)
+GL_CALL_FUNCTION(glGetInternalformativ)
+GL_CALL_FUNCTION(glGetActiveAtomicCounterBufferiv)
+GL_CALL_FUNCTION(glBindImageTexture)
+GL_CALL_FUNCTION(glMemoryBarrier)
+GL_CALL_FUNCTION(glTexStorage1D)
+GL_CALL_FUNCTION(glTexStorage2D)
+GL_CALL_FUNCTION(glTexStorage3D)
+GL_CALL_FUNCTION(glDrawTransformFeedbackInstanced)
+GL_CALL_FUNCTION(glDrawTransformFeedbackStreamInstanced)
+GL_CALL_FUNCTION(glClearBufferData)
+GL_CALL_FUNCTION(glClearBufferSubData)
+GL_CALL_FUNCTION(glDispatchCompute)
+GL_CALL_FUNCTION(glDispatchComputeIndirect)
+GL_CALL_FUNCTION(glCopyImageSubData)
+GL_CALL_FUNCTION(glFramebufferParameteri)
+GL_CALL_FUNCTION(glGetFramebufferParameteriv)
+GL_CALL_FUNCTION(glGetInternalformati64v)
+GL_CALL_FUNCTION(glInvalidateTexSubImage)
+GL_CALL_FUNCTION(glInvalidateTexImage)
+GL_CALL_FUNCTION(glInvalidateBufferSubData)
+GL_CALL_FUNCTION(glInvalidateBufferData)
+GL_CALL_FUNCTION(glInvalidateFramebuffer)
+GL_CALL_FUNCTION(glInvalidateSubFramebuffer)
+GL_CALL_FUNCTION(glMultiDrawArraysIndirect)
+GL_CALL_FUNCTION(glMultiDrawElementsIndirect)
+GL_CALL_FUNCTION(glGetProgramInterfaceiv)
+GL_CALL_FUNCTION(glGetProgramResourceIndex)
+GL_CALL_FUNCTION(glGetProgramResourceName)
+GL_CALL_FUNCTION(glGetProgramResourceiv)
+GL_CALL_FUNCTION(glGetProgramResourceLocation)
+GL_CALL_FUNCTION(glGetProgramResourceLocationIndex)
+GL_CALL_FUNCTION(glShaderStorageBlockBinding)
+GL_CALL_FUNCTION(glTexBufferRange)
+GL_CALL_FUNCTION(glTexStorage2DMultisample)
+GL_CALL_FUNCTION(glTexStorage3DMultisample)
+GL_CALL_FUNCTION(glTextureView)
+GL_CALL_FUNCTION(glBindVertexBuffer)
+GL_CALL_FUNCTION(glVertexAttribFormat)
+GL_CALL_FUNCTION(glVertexAttribIFormat)
+GL_CALL_FUNCTION(glVertexAttribLFormat)
+GL_CALL_FUNCTION(glVertexAttribBinding)
+GL_CALL_FUNCTION(glVertexBindingDivisor)
+GL_CALL_FUNCTION(glDebugMessageControl)
+GL_CALL_FUNCTION(glDebugMessageInsert)
+GL_CALL_FUNCTION(glDebugMessageCallback)
+GL_CALL_FUNCTION(glGetDebugMessageLog)
+GL_CALL_FUNCTION(glPushDebugGroup)
+GL_CALL_FUNCTION(glPopDebugGroup)
+GL_CALL_FUNCTION(glObjectLabel)
+GL_CALL_FUNCTION(glGetObjectLabel)
+GL_CALL_FUNCTION(glObjectPtrLabel)
+GL_CALL_FUNCTION(glGetObjectPtrLabel)
+GL_CALL_FUNCTION(glGetPointerv)
+GL_CALL_FUNCTION(glBufferStorage)
+GL_CALL_FUNCTION(glClearTexImage)
+GL_CALL_FUNCTION(glClearTexSubImage)
+GL_CALL_FUNCTION(glBindBuffersBase)
+GL_CALL_FUNCTION(glBindBuffersRange)
+GL_CALL_FUNCTION(glBindTextures)
+GL_CALL_FUNCTION(glBindSamplers)
+GL_CALL_FUNCTION(glBindImageTextures)
+GL_CALL_FUNCTION(glBindVertexBuffers)
+GL_CALL_FUNCTION(glClipControl)
+GL_CALL_FUNCTION(glCreateTransformFeedbacks)
+GL_CALL_FUNCTION(glTransformFeedbackBufferBase)
+GL_CALL_FUNCTION(glTransformFeedbackBufferRange)
+GL_CALL_FUNCTION(glGetTransformFeedbackiv)
+GL_CALL_FUNCTION(glGetTransformFeedbacki_v)
+GL_CALL_FUNCTION(glGetTransformFeedbacki64_v)
+GL_CALL_FUNCTION(glCreateBuffers)
+GL_CALL_FUNCTION(glNamedBufferStorage)
+GL_CALL_FUNCTION(glNamedBufferData)
+GL_CALL_FUNCTION(glNamedBufferSubData)
+GL_CALL_FUNCTION(glCopyNamedBufferSubData)
+GL_CALL_FUNCTION(glClearNamedBufferData)
+GL_CALL_FUNCTION(glClearNamedBufferSubData)
+GL_CALL_FUNCTION(glMapNamedBuffer)
+GL_CALL_FUNCTION(glMapNamedBufferRange)
+GL_CALL_FUNCTION(glUnmapNamedBuffer)
+GL_CALL_FUNCTION(glFlushMappedNamedBufferRange)
+GL_CALL_FUNCTION(glGetNamedBufferParameteriv)
+GL_CALL_FUNCTION(glGetNamedBufferParameteri64v)
+GL_CALL_FUNCTION(glGetNamedBufferPointerv)
+GL_CALL_FUNCTION(glGetNamedBufferSubData)
+GL_CALL_FUNCTION(glCreateFramebuffers)
+GL_CALL_FUNCTION(glNamedFramebufferRenderbuffer)
+GL_CALL_FUNCTION(glNamedFramebufferParameteri)
+GL_CALL_FUNCTION(glNamedFramebufferTexture)
+GL_CALL_FUNCTION(glNamedFramebufferTextureLayer)
+GL_CALL_FUNCTION(glNamedFramebufferDrawBuffer)
+GL_CALL_FUNCTION(glNamedFramebufferDrawBuffers)
+GL_CALL_FUNCTION(glNamedFramebufferReadBuffer)
+GL_CALL_FUNCTION(glInvalidateNamedFramebufferData)
+GL_CALL_FUNCTION(glInvalidateNamedFramebufferSubData)
+GL_CALL_FUNCTION(glClearNamedFramebufferiv)
+GL_CALL_FUNCTION(glClearNamedFramebufferuiv)
+GL_CALL_FUNCTION(glClearNamedFramebufferfv)
+GL_CALL_FUNCTION(glClearNamedFramebufferfi)
+GL_CALL_FUNCTION(glBlitNamedFramebuffer)
+GL_CALL_FUNCTION(glCheckNamedFramebufferStatus)
+GL_CALL_FUNCTION(glGetNamedFramebufferParameteriv)
+GL_CALL_FUNCTION(glGetNamedFramebufferAttachmentParameteriv)
+GL_CALL_FUNCTION(glCreateRenderbuffers)
+GL_CALL_FUNCTION(glNamedRenderbufferStorage)
+GL_CALL_FUNCTION(glNamedRenderbufferStorageMultisample)
+GL_CALL_FUNCTION(glGetNamedRenderbufferParameteriv)
+GL_CALL_FUNCTION(glCreateTextures)
+GL_CALL_FUNCTION(glTextureBuffer)
+GL_CALL_FUNCTION(glTextureBufferRange)
+GL_CALL_FUNCTION(glTextureStorage1D)
+GL_CALL_FUNCTION(glTextureStorage2D)
+GL_CALL_FUNCTION(glTextureStorage3D)
+GL_CALL_FUNCTION(glTextureStorage2DMultisample)
+GL_CALL_FUNCTION(glTextureStorage3DMultisample)
+GL_CALL_FUNCTION(glTextureSubImage1D)
+GL_CALL_FUNCTION(glTextureSubImage2D)
+GL_CALL_FUNCTION(glTextureSubImage3D)
+GL_CALL_FUNCTION(glCompressedTextureSubImage1D)
+GL_CALL_FUNCTION(glCompressedTextureSubImage2D)
+GL_CALL_FUNCTION(glCompressedTextureSubImage3D)
+GL_CALL_FUNCTION(glCopyTextureSubImage1D)
+GL_CALL_FUNCTION(glCopyTextureSubImage2D)
+GL_CALL_FUNCTION(glCopyTextureSubImage3D)
+GL_CALL_FUNCTION(glTextureParameterf)
+GL_CALL_FUNCTION(glTextureParameterfv)
+GL_CALL_FUNCTION(glTextureParameteri)
+GL_CALL_FUNCTION(glTextureParameterIiv)
+GL_CALL_FUNCTION(glTextureParameterIuiv)
+GL_CALL_FUNCTION(glTextureParameteriv)
+GL_CALL_FUNCTION(glGenerateTextureMipmap)
+GL_CALL_FUNCTION(glBindTextureUnit)
+GL_CALL_FUNCTION(glGetTextureImage)
+GL_CALL_FUNCTION(glGetCompressedTextureImage)
+GL_CALL_FUNCTION(glGetTextureLevelParameterfv)
+GL_CALL_FUNCTION(glGetTextureLevelParameteriv)
+GL_CALL_FUNCTION(glGetTextureParameterfv)
+GL_CALL_FUNCTION(glGetTextureParameterIiv)
+GL_CALL_FUNCTION(glGetTextureParameterIuiv)
+GL_CALL_FUNCTION(glGetTextureParameteriv)
+GL_CALL_FUNCTION(glCreateVertexArrays)
+GL_CALL_FUNCTION(glDisableVertexArrayAttrib)
+GL_CALL_FUNCTION(glEnableVertexArrayAttrib)
+GL_CALL_FUNCTION(glVertexArrayElementBuffer)
+GL_CALL_FUNCTION(glVertexArrayVertexBuffer)
+GL_CALL_FUNCTION(glVertexArrayVertexBuffers)
+GL_CALL_FUNCTION(glVertexArrayAttribBinding)
+GL_CALL_FUNCTION(glVertexArrayAttribFormat)
+GL_CALL_FUNCTION(glVertexArrayAttribIFormat)
+GL_CALL_FUNCTION(glVertexArrayAttribLFormat)
+GL_CALL_FUNCTION(glVertexArrayBindingDivisor)
+GL_CALL_FUNCTION(glGetVertexArrayiv)
+GL_CALL_FUNCTION(glGetVertexArrayIndexediv)
+GL_CALL_FUNCTION(glGetVertexArrayIndexed64iv)
+GL_CALL_FUNCTION(glCreateSamplers)
+GL_CALL_FUNCTION(glCreateProgramPipelines)
+GL_CALL_FUNCTION(glCreateQueries)
+GL_CALL_FUNCTION(glGetQueryBufferObjecti64v)
+GL_CALL_FUNCTION(glGetQueryBufferObjectiv)
+GL_CALL_FUNCTION(glGetQueryBufferObjectui64v)
+GL_CALL_FUNCTION(glGetQueryBufferObjectuiv)
+GL_CALL_FUNCTION(glMemoryBarrierByRegion)
+GL_CALL_FUNCTION(glGetTextureSubImage)
+GL_CALL_FUNCTION(glGetCompressedTextureSubImage)
+GL_CALL_FUNCTION(glGetGraphicsResetStatus)
+GL_CALL_FUNCTION(glGetnCompressedTexImage)
+GL_CALL_FUNCTION(glGetnTexImage)
+GL_CALL_FUNCTION(glGetnUniformdv)
+GL_CALL_FUNCTION(glGetnUniformfv)
+GL_CALL_FUNCTION(glGetnUniformiv)
+GL_CALL_FUNCTION(glGetnUniformuiv)
+GL_CALL_FUNCTION(glReadnPixels)
+GL_CALL_FUNCTION(glGetnMapdv)
+GL_CALL_FUNCTION(glGetnMapfv)
+GL_CALL_FUNCTION(glGetnMapiv)
+GL_CALL_FUNCTION(glGetnPixelMapfv)
+GL_CALL_FUNCTION(glGetnPixelMapuiv)
+GL_CALL_FUNCTION(glGetnPixelMapusv)
+GL_CALL_FUNCTION(glGetnPolygonStipple)
+GL_CALL_FUNCTION(glGetnColorTable)
+GL_CALL_FUNCTION(glGetnConvolutionFilter)
+GL_CALL_FUNCTION(glGetnSeparableFilter)
+GL_CALL_FUNCTION(glGetnHistogram)
+GL_CALL_FUNCTION(glGetnMinmax)
+GL_CALL_FUNCTION(glTextureBarrier)
+GL_CALL_FUNCTION(glSpecializeShader)
+GL_CALL_FUNCTION(glMultiDrawArraysIndirectCount)
+GL_CALL_FUNCTION(glMultiDrawElementsIndirectCount)
+GL_CALL_FUNCTION(glPolygonOffsetClamp)
+GL_CALL_FUNCTION(glDebugMessageControlARB)
+GL_CALL_FUNCTION(glDebugMessageInsertARB)
+GL_CALL_FUNCTION(glDebugMessageCallbackARB)
+GL_CALL_FUNCTION(glGetDebugMessageLogARB)
+GL_CALL_FUNCTION(glLabelObjectEXT)
+GL_CALL_FUNCTION(glGetObjectLabelEXT)
+GL_CALL_FUNCTION(glInsertEventMarkerEXT)
+GL_CALL_FUNCTION(glPushGroupMarkerEXT)
+GL_CALL_FUNCTION(glPopGroupMarkerEXT)
@@ -0,0 +1,257 @@
+#include "gl_call_profiler.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#include "../support/error.hpp"
+
+namespace
+{
+	using Clock_ = std::chrono::steady_clock;
+
+	enum GL_CALL_FUNCTION_INDEX_
+	{
+#		define GL_CALL_FUNCTION(aName) kFunction_##aName,
+#		include "gl_call_functions.inl"
+#		undef GL_CALL_FUNCTION
+		kFunctionCount_
+	};
+
+	char const* const kFunctionNames_[kFunctionCount_] = {
+#		define GL_CALL_FUNCTION(aName) #aName,
+#		include "gl_call_functions.inl"
+#		undef GL_CALL_FUNCTION
+	};
+
+	// scope 0 collects calls made outside of any GL_PROFILE_SCOPE, and
+	// those of scopes that did not fit
+	constexpr std::uint32_t kMaxScopes = 64;
+
+	struct Counter_
+	{
+		std::atomic<std::uint64_t> calls{ 0 };
+		std::atomic<std::uint64_t> ns{ 0 };
+	};
+
+	Counter_ gFunctions_[kFunctionCount_];
+	Counter_ gScopes_[kMaxScopes];
+
+	std::mutex gScopeMutex_;
+	char const* gScopeNames_[kMaxScopes] = { "(no scope)" };
+	std::atomic<std::uint32_t> gScopeCount_{ 1 };
+
+	thread_local std::uint32_t tCurrentScope_ = 0;
+
+	class CallTimer_
+	{
+		std::size_t function;
+		Clock_::time_point start;
+
+	public:
+		explicit CallTimer_(std::size_t aFunction) : function(aFunction), start(Clock_::now()) {}
+		~CallTimer_()
+		{
+			auto const ns = std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock_::now() - start).count());
+
+			gFunctions_[function].calls.fetch_add(1, std::memory_order_relaxed);
+			gFunctions_[function].ns.fetch_add(ns, std::memory_order_relaxed);
+			gScopes_[tCurrentScope_].calls.fetch_add(1, std::memory_order_relaxed);
+			gScopes_[tCurrentScope_].ns.fetch_add(ns, std::memory_order_relaxed);
+		}
+	};
+
+	// One wrapper per glad pointer, of the same type as the function it
+	// replaces; the arguments and result are passed through unchanged.
+	template< auto tPointer, std::size_t tFunction, typename tProc = std::remove_pointer_t<decltype(tPointer)> >
+	struct Hook_;
+
+	template< auto tPointer, std::size_t tFunction, typename tResult, typename... tArgs >
+	struct Hook_< tPointer, tFunction, tResult (APIENTRYP)(tArgs...) >
+	{
+		static inline tResult (APIENTRYP original)(tArgs...) = nullptr;
+
+		static tResult APIENTRY call(tArgs... aArgs)
+		{
+			CallTimer_ const timer(tFunction);
+			return original(aArgs...);
+		}
+
+		static void install()
+		{
+			// entry points the context does not provide stay null
+			if (!*tPointer) return;
+			original = *tPointer;
+			*tPointer = &call;
+		}
+	};
+
+	std::vector<GLCallCount> sorted_counts_(std::vector<GLCallCount> aCounts)
+	{
+		aCounts.erase(std::remove_if(aCounts.begin(), aCounts.end(), [] (const GLCallCount& aCount) {
+			return aCount.calls == 0;
+		}), aCounts.end());
+		std::sort(aCounts.begin(), aCounts.end(), [] (const GLCallCount& aA, const GLCallCount& aB) {
+			return aA.calls > aB.calls;
+		});
+		return aCounts;
+	}
+
+	GLCallCount load_count_(const char* aName, const Counter_& aCounter)
+	{
+		GLCallCount count;
+		count.name = aName;
+		count.calls = aCounter.calls.load(std::memory_order_relaxed);
+		count.ms = double(aCounter.ns.load(std::memory_order_relaxed)) * 1e-6;
+		return count;
+	}
+
+	void write_counts_(std::FILE* aOut, const char* aKey, const std::vector<GLCallCount>& aCounts, std::uint64_t aFrames, bool aLast)
+	{
+		double const frames = double(std::max<std::uint64_t>(aFrames, 1));
+
+		std::fprintf(aOut, "\t\"%s\": [\n", aKey);
+		for (size_t i = 0; i < aCounts.size(); i++)
+		{
+			auto const& count = aCounts[i];
+			std::fprintf(aOut, "\t\t{ \"name\": \"%s\", \"calls\": %llu, \"callsPerFrame\": %.3f, \"ms\": %.3f, \"usPerCall\": %.4f }%s\n",
+				count.name, static_cast<unsigned long long>(count.calls), double(count.calls) / frames,
+				count.ms, count.ms * 1e3 / double(count.calls), i + 1 < aCounts.size() ? "," : "");
+		}
+		std::fprintf(aOut, "\t]%s\n", aLast ? "" : ",");
+	}
+}
+
+void GLCallProfiler::install()
+{
+	if (active) return;
+
+#	define GL_CALL_FUNCTION(aName) Hook_< &glad_##aName, kFunction_##aName >::install();
+#	include "gl_call_functions.inl"
+#	undef GL_CALL_FUNCTION
+
+	lastCalls.assign(kFunctionCount_ + kMaxScopes, 0);
+	lastNs.assign(kFunctionCount_ + kMaxScopes, 0);
+	active = true;
+}
+
+void GLCallProfiler::endFrame()
+{
+	if (!active) return;
+
+	frames++;
+	lastFrame.calls = 0;
+	lastFrame.ms = 0.0;
+	lastFrame.functions.clear();
+	lastFrame.scopes.clear();
+
+	// counts since the previous frame, from the running totals
+	auto delta = [this] (size_t aSlot, const char* aName, const Counter_& aCounter) {
+		std::uint64_t const calls = aCounter.calls.load(std::memory_order_relaxed);
+		std::uint64_t const ns = aCounter.ns.load(std::memory_order_relaxed);
+
+		GLCallCount count;
+		count.name = aName;
+		count.calls = calls - lastCalls[aSlot];
+		count.ms = double(ns - lastNs[aSlot]) * 1e-6;
+
+		lastCalls[aSlot] = calls;
+		lastNs[aSlot] = ns;
+		return count;
+	};
+
+	for (size_t i = 0; i < kFunctionCount_; i++)
+	{
+		GLCallCount const count = delta(i, kFunctionNames_[i], gFunctions_[i]);
+		lastFrame.calls += count.calls;
+		lastFrame.ms += count.ms;
+		if (count.calls) lastFrame.functions.push_back(count);
+	}
+
+	std::uint32_t const scopes = gScopeCount_.load(std::memory_order_acquire);
+	for (std::uint32_t i = 0; i < scopes; i++)
+	{
+		GLCallCount const count = delta(kFunctionCount_ + i, gScopeNames_[i], gScopes_[i]);
+		if (count.calls) lastFrame.scopes.push_back(count);
+	}
+
+	lastFrame.functions = sorted_counts_(std::move(lastFrame.functions));
+	lastFrame.scopes = sorted_counts_(std::move(lastFrame.scopes));
+}
+
+void GLCallProfiler::writeJson(const char* aPath) const
+{
+	std::vector<GLCallCount> functions, scopes;
+	for (size_t i = 0; i < kFunctionCount_; i++)
+	{
+		functions.push_back(load_count_(kFunctionNames_[i], gFunctions_[i]));
+	}
+	std::uint32_t const scopeCount = gScopeCount_.load(std::memory_order_acquire);
+	for (std::uint32_t i = 0; i < scopeCount; i++)
+	{
+		scopes.push_back(load_count_(gScopeNames_[i], gScopes_[i]));
+	}
+	functions = sorted_counts_(std::move(functions));
+	scopes = sorted_counts_(std::move(scopes));
+
+	std::uint64_t calls = 0;
+	double ms = 0.0;
+	for (auto const& count : functions)
+	{
+		calls += count.calls;
+		ms += count.ms;
+	}
+
+	std::FILE* out = std::fopen(aPath, "w");
+	if (!out) throw Error("Unable to write GL call counts to '%s'", aPath);
+
+	// totals include the calls made while loading, before the first frame
+	std::fprintf(out, "{\n");
+	std::fprintf(out, "\t\"frames\": %llu,\n", static_cast<unsigned long long>(frames));
+	std::fprintf(out, "\t\"calls\": %llu,\n", static_cast<unsigned long long>(calls));
+	std::fprintf(out, "\t\"ms\": %.3f,\n", ms);
+	write_counts_(out, "functions", functions, frames, false);
+	write_counts_(out, "scopes", scopes, frames, true);
+	std::fprintf(out, "}\n");
+
+	bool const failed = std::ferror(out) != 0;
+	std::fclose(out);
+	if (failed) throw Error("Writing GL call counts to '%s' failed", aPath);
+}
+
+GLCallProfiler& gl_call_profiler()
+{
+	static GLCallProfiler profiler;
+	return profiler;
+}
+
+std::uint32_t gl_profile_scope_id(const char* aName)
+{
+	std::lock_guard<std::mutex> lock(gScopeMutex_);
+
+	std::uint32_t const count = gScopeCount_.load(std::memory_order_relaxed);
+	for (std::uint32_t i = 1; i < count; i++)
+	{
+		if (std::strcmp(gScopeNames_[i], aName) == 0) return i;
+	}
+	if (count == kMaxScopes) return 0;
+
+	gScopeNames_[count] = aName;
+	gScopeCount_.store(count + 1, std::memory_order_release);
+	return count;
+}
+
+GLProfileScope::GLProfileScope(std::uint32_t aScope)
+	: previous(tCurrentScope_)
+{
+	tCurrentScope_ = aScope;
+}
+
+GLProfileScope::~GLProfileScope()
+{
+	tCurrentScope_ = previous;
+}
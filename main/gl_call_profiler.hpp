@@ -0,0 +1,82 @@
+#ifndef GL_CALL_PROFILER_HEADER_FILE
+#define GL_CALL_PROFILER_HEADER_FILE
+
+#include <glad.h>
+
+#include <vector>
+#include <cstdint>
+
+// Calls to one GL function, or from one scope
+struct GLCallCount
+{
+	const char* name = "";
+	std::uint64_t calls = 0;
+	double ms = 0.0;
+};
+
+// Calls of one frame; only functions and scopes with calls, most first
+struct GLCallFrame
+{
+	std::uint64_t calls = 0;
+	double ms = 0.0;
+	std::vector<GLCallCount> functions;
+	std::vector<GLCallCount> scopes;
+};
+
+// Optional layer between the program and the driver. install() replaces
+// every glad function pointer with a wrapper that counts the call against
+// its function and the innermost GL_PROFILE_SCOPE of the calling thread, and
+// times it. The times are CPU time in the driver (plus the wrapper's two
+// clock reads), not GPU time. Code that loads GL itself, like the ImGui
+// backend, is not seen.
+class GLCallProfiler
+{
+	bool active = false;
+	std::uint64_t frames = 0;
+	std::vector<std::uint64_t> lastCalls;
+	std::vector<std::uint64_t> lastNs;
+	GLCallFrame lastFrame;
+
+public:
+	// after gladLoadGLLoader(), before any other thread makes GL calls
+	void install();
+	bool installed() const { return active; }
+
+	// publishes the calls since the previous endFrame()
+	void endFrame();
+	const GLCallFrame& frame() const { return lastFrame; }
+
+	// totals since install() and averages per frame; throws Error if the
+	// file cannot be written
+	void writeJson(const char* aPath) const;
+};
+
+GLCallProfiler& gl_call_profiler();
+
+// Attributes the GL calls of the current thread to aName until the end of
+// the enclosing block. Scopes nest; calls count against the innermost one.
+// aName must be a string literal.
+#define GL_PROFILE_SCOPE(aName) \
+	static std::uint32_t const GL_PROFILE_NAME_(glProfileScopeId_, __LINE__) = gl_profile_scope_id(aName); \
+	GLProfileScope const GL_PROFILE_NAME_(glProfileScope_, __LINE__)( GL_PROFILE_NAME_(glProfileScopeId_, __LINE__) ) \
+	/*ENDM*/
+
+#define GL_PROFILE_NAME_(aPrefix, aLine) GL_PROFILE_CONCAT_(aPrefix, aLine)
+#define GL_PROFILE_CONCAT_(aPrefix, aLine) aPrefix##aLine
+
+// registers a scope name; there is room for a few dozen
+std::uint32_t gl_profile_scope_id(const char* aName);
+
+class GLProfileScope
+{
+	std::uint32_t previous;
+
+public:
+	explicit GLProfileScope(std::uint32_t aScope);
+	~GLProfileScope();
+
+	GLProfileScope(const GLProfileScope&) = delete;
+	GLProfileScope& operator=(const GLProfileScope&) = delete;
+};
+
+#endif//GL_CALL_PROFILER_HEADER_FILE
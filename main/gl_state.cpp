@@ -0,0 +1,229 @@
+#include "gl_state.hpp"
+
+#include <cstring>
+
+size_t GLStateCounters::totalIssued() const
+{
+	size_t total = 0;
+	for (auto const count : issued) total += count;
+	return total;
+}
+
+size_t GLStateCounters::totalFiltered() const
+{
+	size_t total = 0;
+	for (auto const count : filtered) total += count;
+	return total;
+}
+
+GLStateCache::GLStateCache()
+{
+	invalidate();
+}
+
+void GLStateCache::beginFrame()
+{
+	lastFrame = counters;
+	counters = GLStateCounters();
+	invalidate();
+}
+
+void GLStateCache::invalidate()
+{
+	programKnown = false;
+	vertexArrayKnown = false;
+	activeUnitKnown = false;
+	for (auto& unit : texturesKnown) unit.fill(false);
+
+	blend = UNKNOWN;
+	depthTest = UNKNOWN;
+	cullFace = UNKNOWN;
+	depthMask = UNKNOWN;
+	blendFuncKnown = false;
+}
+
+void GLStateCache::forgetUniforms()
+{
+	uniforms.clear();
+}
+
+void GLStateCache::count(GL_STATE_CATEGORY aCategory, bool aIssued)
+{
+	if (aIssued) counters.issued[aCategory]++;
+	else counters.filtered[aCategory]++;
+}
+
+void GLStateCache::useProgram(GLuint aProgram)
+{
+	bool const issue = !programKnown || program != aProgram;
+	count(STATE_PROGRAM, issue);
+	if (!issue) return;
+
+	glUseProgram(aProgram);
+	program = aProgram;
+	programKnown = true;
+}
+
+void GLStateCache::bindVertexArray(GLuint aVertexArray)
+{
+	bool const issue = !vertexArrayKnown || vertexArray != aVertexArray;
+	count(STATE_VERTEX_ARRAY, issue);
+	if (!issue) return;
+
+	glBindVertexArray(aVertexArray);
+	vertexArray = aVertexArray;
+	vertexArrayKnown = true;
+}
+
+void GLStateCache::bindTexture(GLuint aUnit, GLenum aTarget, GLuint aTexture)
+{
+	int slot = -1;
+	if (aTarget == GL_TEXTURE_2D) slot = SLOT_2D;
+	else if (aTarget == GL_TEXTURE_2D_ARRAY) slot = SLOT_2D_ARRAY;
+
+	bool const tracked = slot >= 0 && aUnit < kTextureUnits;
+	bool const issue = !tracked || !texturesKnown[aUnit][slot] || textures[aUnit][slot] != aTexture;
+	count(STATE_TEXTURE, issue);
+	if (!issue) return;
+
+	if (!activeUnitKnown || activeUnit != aUnit)
+	{
+		glActiveTexture(GL_TEXTURE0 + aUnit);
+		activeUnit = aUnit;
+		activeUnitKnown = true;
+	}
+
+	glBindTexture(aTarget, aTexture);
+
+	if (tracked)
+	{
+		textures[aUnit][slot] = aTexture;
+		texturesKnown[aUnit][slot] = true;
+	}
+}
+
+GLStateCache::KNOWN_STATE* GLStateCache::capability(GLenum aCap)
+{
+	switch (aCap)
+	{
+		case GL_BLEND: return &blend;
+		case GL_DEPTH_TEST: return &depthTest;
+		case GL_CULL_FACE: return &cullFace;
+	}
+	return nullptr;
+}
+
+void GLStateCache::enable(GLenum aCap)
+{
+	KNOWN_STATE* state = capability(aCap);
+	bool const issue = !state || *state != ON;
+	count(STATE_CAPABILITY, issue);
+	if (!issue) return;
+
+	glEnable(aCap);
+	if (state) *state = ON;
+}
+
+void GLStateCache::disable(GLenum aCap)
+{
+	KNOWN_STATE* state = capability(aCap);
+	bool const issue = !state || *state != OFF;
+	count(STATE_CAPABILITY, issue);
+	if (!issue) return;
+
+	glDisable(aCap);
+	if (state) *state = OFF;
+}
+
+void GLStateCache::blendFunc(GLenum aSrc, GLenum aDst)
+{
+	bool const issue = !blendFuncKnown || blendSrc != aSrc || blendDst != aDst;
+	count(STATE_BLEND_DEPTH, issue);
+	if (!issue) return;
+
+	glBlendFunc(aSrc, aDst);
+	blendSrc = aSrc;
+	blendDst = aDst;
+	blendFuncKnown = true;
+}
+
+void GLStateCache::depthMaskEnabled(bool aEnabled)
+{
+	KNOWN_STATE const wanted = aEnabled ? ON : OFF;
+	bool const issue = depthMask != wanted;
+	count(STATE_BLEND_DEPTH, issue);
+	if (!issue) return;
+
+	glDepthMask(aEnabled ? GL_TRUE : GL_FALSE);
+	depthMask = wanted;
+}
+
+GLStateCache::UniformSlot* GLStateCache::uniformSlot(GLint aLocation)
+{
+	// uniform values are per program; without a known program there is
+	// nothing to compare against
+	if (!programKnown || program == 0) return nullptr;
+	if (aLocation < 0 || aLocation >= kUniformLocations) return nullptr;
+
+	return &uniforms[program][aLocation];
+}
+
+bool GLStateCache::uniformUnchanged(GLint aLocation, const float* aData, GLsizei aSize, GLboolean aTranspose)
+{
+	UniformSlot* slot = uniformSlot(aLocation);
+	if (!slot) return false;
+
+	bool const unchanged = slot->valid
+		&& slot->size == aSize
+		&& slot->transpose == aTranspose
+		&& std::memcmp(slot->data, aData, aSize * sizeof(float)) == 0;
+
+	if (!unchanged)
+	{
+		slot->valid = true;
+		slot->size = aSize;
+		slot->transpose = aTranspose;
+		std::memcpy(slot->data, aData, aSize * sizeof(float));
+	}
+
+	return unchanged;
+}
+
+void GLStateCache::uniform1f(GLint aLocation, float aValue)
+{
+	bool const issue = !uniformUnchanged(aLocation, &aValue, 1, GL_FALSE);
+	count(STATE_UNIFORM, issue);
+	if (issue) glUniform1f(aLocation, aValue);
+}
+
+void GLStateCache::uniform1i(GLint aLocation, GLint aValue)
+{
+	// stored bit-for-bit in the float slot; a location has a single type per
+	// program, so this cannot be confused with a float value
+	float bits;
+	std::memcpy(&bits, &aValue, sizeof(bits));
+
+	bool const issue = !uniformUnchanged(aLocation, &bits, 1, GL_FALSE);
+	count(STATE_UNIFORM, issue);
+	if (issue) glUniform1i(aLocation, aValue);
+}
+
+void GLStateCache::uniform3fv(GLint aLocation, const float* aValue)
+{
+	bool const issue = !uniformUnchanged(aLocation, aValue, 3, GL_FALSE);
+	count(STATE_UNIFORM, issue);
+	if (issue) glUniform3fv(aLocation, 1, aValue);
+}
+
+void GLStateCache::uniformMatrix4fv(GLint aLocation, GLboolean aTranspose, const float* aValue)
+{
+	bool const issue = !uniformUnchanged(aLocation, aValue, 16, aTranspose);
+	count(STATE_UNIFORM, issue);
+	if (issue) glUniformMatrix4fv(aLocation, 1, aTranspose, aValue);
+}
+
+GLStateCache& gl_state()
+{
+	static GLStateCache cache;
+	return cache;
+}
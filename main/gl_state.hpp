@@ -0,0 +1,108 @@
+#ifndef GL_STATE_HEADER_FILE
+#define GL_STATE_HEADER_FILE
+
+#include <glad.h>
+
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+
+enum GL_STATE_CATEGORY
+{
+	STATE_PROGRAM,
+	STATE_VERTEX_ARRAY,
+	STATE_TEXTURE,
+	STATE_CAPABILITY,
+	STATE_BLEND_DEPTH,
+	STATE_UNIFORM,
+	STATE_CATEGORY_COUNT
+};
+
+struct GLStateCounters
+{
+	std::array<size_t, STATE_CATEGORY_COUNT> issued{};
+	std::array<size_t, STATE_CATEGORY_COUNT> filtered{};
+
+	size_t totalIssued() const;
+	size_t totalFiltered() const;
+};
+
+// Thin state tracking layer. Calls that would set a piece of GL state to the
+// value it already has are dropped. State that is changed by code which does
+// not go through the cache (ImGui, texture and VAO creation, ...) is not
+// seen, so bindings and capabilities are forgotten in beginFrame(). Uniform
+// values are per program and are kept across frames; call forgetUniforms()
+// whenever a program is replaced.
+class GLStateCache
+{
+	static constexpr GLuint kTextureUnits = 16;
+	static constexpr GLint kUniformLocations = 32;
+
+	enum TEXTURE_TARGET_SLOT { SLOT_2D, SLOT_2D_ARRAY, SLOT_COUNT };
+
+	// tri-state: unknown until first set through the cache
+	enum KNOWN_STATE : signed char { UNKNOWN = -1, OFF = 0, ON = 1 };
+
+	struct UniformSlot
+	{
+		bool valid = false;
+		GLboolean transpose = GL_FALSE;
+		GLsizei size = 0;
+		float data[16];
+	};
+
+	bool programKnown = false;
+	GLuint program = 0;
+	bool vertexArrayKnown = false;
+	GLuint vertexArray = 0;
+	bool activeUnitKnown = false;
+	GLuint activeUnit = 0;
+	std::array<std::array<GLuint, SLOT_COUNT>, kTextureUnits> textures;
+	std::array<std::array<bool, SLOT_COUNT>, kTextureUnits> texturesKnown;
+
+	KNOWN_STATE blend = UNKNOWN;
+	KNOWN_STATE depthTest = UNKNOWN;
+	KNOWN_STATE cullFace = UNKNOWN;
+	KNOWN_STATE depthMask = UNKNOWN;
+	bool blendFuncKnown = false;
+	GLenum blendSrc = GL_ONE, blendDst = GL_ZERO;
+
+	std::unordered_map<GLuint, std::array<UniformSlot, kUniformLocations>> uniforms;
+
+	GLStateCounters counters;
+	GLStateCounters lastFrame;
+
+	KNOWN_STATE* capability(GLenum aCap);
+	UniformSlot* uniformSlot(GLint aLocation);
+	bool uniformUnchanged(GLint aLocation, const float* aData, GLsizei aSize, GLboolean aTranspose);
+	void count(GL_STATE_CATEGORY aCategory, bool aIssued);
+
+public:
+	GLStateCache();
+
+	// start of frame: publish counters of the previous frame and forget bindings
+	void beginFrame();
+	void invalidate();
+	void forgetUniforms();
+
+	void useProgram(GLuint aProgram);
+	void bindVertexArray(GLuint aVertexArray);
+	void bindTexture(GLuint aUnit, GLenum aTarget, GLuint aTexture);
+
+	void enable(GLenum aCap);
+	void disable(GLenum aCap);
+	void blendFunc(GLenum aSrc, GLenum aDst);
+	void depthMaskEnabled(bool aEnabled);
+
+	void uniform1f(GLint aLocation, float aValue);
+	void uniform1i(GLint aLocation, GLint aValue);
+	void uniform3fv(GLint aLocation, const float* aValue);
+	void uniformMatrix4fv(GLint aLocation, GLboolean aTranspose, const float* aValue);
+
+	const GLStateCounters& frameCounters() const { return lastFrame; }
+};
+
+// State cache for the main context. Only use from the thread that owns it.
+GLStateCache& gl_state();
+
+#endif//GL_STATE_HEADER_FILE
@@ -0,0 +1,126 @@
+#include "input_recording.hpp"
+
+#include <cstring>
+
+#include "../support/error.hpp"
+
+namespace
+{
+	constexpr char kMagic[4] = { 'C', 'W', 'I', 'N' };
+	constexpr std::uint32_t kVersion = 1;
+	// offset of the frame count in the header
+	constexpr long kFrameCountOffset = 12;
+
+	template< typename tType >
+	void write_(std::FILE* aFile, tType aValue)
+	{
+		std::fwrite(&aValue, sizeof(aValue), 1, aFile);
+	}
+
+	template< typename tType >
+	bool read_(std::FILE* aFile, tType& aValue)
+	{
+		return std::fread(&aValue, sizeof(aValue), 1, aFile) == 1;
+	}
+}
+
+InputRecorder::InputRecorder(const char* aPath, float aTimeStep)
+{
+	file = std::fopen(aPath, "wb");
+	if (!file) throw Error("Unable to create input recording '%s'", aPath);
+
+	std::fwrite(kMagic, 1, sizeof(kMagic), file);
+	write_(file, kVersion);
+	write_(file, aTimeStep);
+	write_(file, std::uint32_t(0));
+}
+
+InputRecorder::~InputRecorder()
+{
+	finish();
+}
+
+void InputRecorder::key(int aKey, int aAction)
+{
+	if (!file) return;
+
+	write_(file, frame);
+	write_(file, std::uint8_t(INPUT_EVENT_KEY));
+	write_(file, std::int16_t(aKey));
+	write_(file, std::uint8_t(aAction));
+}
+
+void InputRecorder::cursor(double aX, double aY)
+{
+	if (!file) return;
+
+	write_(file, frame);
+	write_(file, std::uint8_t(INPUT_EVENT_CURSOR));
+	write_(file, aX);
+	write_(file, aY);
+}
+
+void InputRecorder::finish()
+{
+	if (!file) return;
+
+	// frames run from 0 to the current one
+	std::fseek(file, kFrameCountOffset, SEEK_SET);
+	write_(file, std::uint32_t(frame + 1));
+	std::fclose(file);
+	file = nullptr;
+}
+
+InputReplay::InputReplay(const char* aPath)
+{
+	std::FILE* file = std::fopen(aPath, "rb");
+	if (!file) throw Error("Unable to open input recording '%s'", aPath);
+
+	char magic[4] = {};
+	std::uint32_t version = 0;
+	bool const header = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic)
+		&& read_(file, version) && read_(file, timeStep) && read_(file, frames);
+
+	if (!header || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion || !(timeStep > 0.f))
+	{
+		std::fclose(file);
+		throw Error("'%s' is not an input recording (version %u)", aPath, unsigned(kVersion));
+	}
+
+	bool complete = true;
+	std::uint32_t frame;
+	std::uint8_t type;
+	while (read_(file, frame))
+	{
+		complete = false;
+		InputEvent event;
+		event.frame = frame;
+		if (!read_(file, type)) break;
+
+		if (type == INPUT_EVENT_KEY)
+		{
+			std::int16_t key;
+			std::uint8_t action;
+			if (!read_(file, key) || !read_(file, action)) break;
+			event.type = INPUT_EVENT_KEY;
+			event.key = key;
+			event.action = action;
+		}
+		else if (type == INPUT_EVENT_CURSOR)
+		{
+			if (!read_(file, event.x) || !read_(file, event.y)) break;
+			event.type = INPUT_EVENT_CURSOR;
+		}
+		else
+		{
+			break;
+		}
+
+		events.push_back(event);
+		complete = true;
+	}
+	std::fclose(file);
+
+	if (!complete)
+		throw Error("Input recording '%s' is damaged after %zu events", aPath, events.size());
+}
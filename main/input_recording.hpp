@@ -0,0 +1,86 @@
+#ifndef INPUT_RECORDING_HEADER_FILE
+#define INPUT_RECORDING_HEADER_FILE
+
+#include <cstdio>
+#include <vector>
+#include <cstdint>
+
+enum INPUT_EVENT_TYPE
+{
+	INPUT_EVENT_KEY,
+	INPUT_EVENT_CURSOR
+};
+
+// A GLFW key or cursor event, stamped with the frame in whose
+// glfwPollEvents() it arrived.
+struct InputEvent
+{
+	std::uint32_t frame = 0;
+	INPUT_EVENT_TYPE type = INPUT_EVENT_KEY;
+	int key = 0;
+	int action = 0;
+	double x = 0.0, y = 0.0;
+};
+
+// Writes input events to a binary file:
+//
+//   header:  "CWIN", version (u32), time step (f32), frame count (u32)
+//   key:     frame (u32), INPUT_EVENT_KEY (u8), key (i16), action (u8)
+//   cursor:  frame (u32), INPUT_EVENT_CURSOR (u8), x (f64), y (f64)
+//
+// in the byte order of the machine (little-endian everywhere this builds).
+// Cursor positions are stored exactly, so that the camera follows the same
+// path when they are replayed. The frame count is filled in by finish(),
+// or by the destructor.
+class InputRecorder
+{
+	std::FILE* file = nullptr;
+	std::uint32_t frame = 0;
+
+public:
+	// throws Error if the file cannot be created. aTimeStep is the fixed
+	// simulation step the frames are recorded with.
+	InputRecorder(const char* aPath, float aTimeStep);
+	~InputRecorder();
+
+	InputRecorder(const InputRecorder&) = delete;
+	InputRecorder& operator=(const InputRecorder&) = delete;
+
+	// events from now on belong to aFrame
+	void setFrame(std::uint32_t aFrame) { frame = aFrame; }
+	void key(int aKey, int aAction);
+	void cursor(double aX, double aY);
+
+	void finish();
+};
+
+// Events read back from a file written by InputRecorder, handed out frame
+// by frame.
+class InputReplay
+{
+	std::vector<InputEvent> events;
+	size_t next = 0;
+	float timeStep = 0.f;
+	std::uint32_t frames = 0;
+
+public:
+	// throws Error if the file cannot be read or is not a recording
+	explicit InputReplay(const char* aPath);
+
+	// calls aHandle(event) for the events of aFrame; frames must be played
+	// in order
+	template< typename tHandler >
+	void play(std::uint32_t aFrame, tHandler&& aHandle)
+	{
+		while (next < events.size() && events[next].frame <= aFrame)
+		{
+			aHandle(events[next++]);
+		}
+	}
+
+	float getTimeStep() const { return timeStep; }
+	std::uint32_t frameCount() const { return frames; }
+	size_t eventCount() const { return events.size(); }
+};
+
+#endif//INPUT_RECORDING_HEADER_FILE
@@ -19,6 +19,15 @@ SimpleMeshData load_wavefront_obj(char const* aPath)
 	// Convert the OBJ data into a SimpleMeshData structure. For now, we simply turn the object into a triangle
 	// soup, ignoring the indexing information that the OBJ file contains.
 	SimpleMeshData ret;
+
+	std::size_t vertexCount = 0;
+	for (auto const& shape : result.shapes)
+	{
+		vertexCount += shape.mesh.indices.size();
+	}
+	ret.positions.reserve(vertexCount);
+	ret.normals.reserve(vertexCount);
+	ret.colors.reserve(vertexCount);
 	
 	for (auto const& shape : result.shapes)
 	{
@@ -69,10 +78,14 @@ std::vector<SimpleMeshData> load_wavefront_multi_obj(char const* aPath)
 	// Convert the OBJ data into a SimpleMeshData structure. For now, we simply turn the object into a triangle
 	// soup, ignoring the indexing information that the OBJ file contains.
 	std::vector<SimpleMeshData> ret_multi;
+	ret_multi.reserve(result.shapes.size());
 	
 	for (auto const& shape : result.shapes)
 	{
 		SimpleMeshData ret;
+		ret.positions.reserve(shape.mesh.indices.size());
+		ret.normals.reserve(shape.mesh.indices.size());
+		ret.colors.reserve(shape.mesh.indices.size());
 		for (std::size_t i = 0; i < shape.mesh.indices.size(); ++i)
 		{
 			auto const& idx = shape.mesh.indices[i];
@@ -100,7 +113,7 @@ std::vector<SimpleMeshData> load_wavefront_multi_obj(char const* aPath)
 
 		}
 		ret.size = ret.positions.size();
-		ret_multi.push_back(ret);
+		ret_multi.push_back(std::move(ret));
 	}
 	
 	return ret_multi;
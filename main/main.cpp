@@ -2,10 +2,14 @@
 #include <GLFW/glfw3.h>
 
 #include <typeinfo>
+#include <optional>
+#include <list>
+#include <algorithm>
 #include <stdexcept>
 
 #include <cstdio>
 #include <cstdlib>
+#include <cmath>
 
 #include "../support/error.hpp"
 #include "../support/program.hpp"
@@ -14,6 +18,7 @@
 
 #include "../vmlib/vec4.hpp"
 #include "../vmlib/mat44.hpp"
+#include "../vmlib/constants.hpp"
 
 #include "imgui.h"
 #include "imgui_impl_glfw.h"
@@ -31,6 +36,25 @@
 #include "scene_object.hpp"
 #include "animation_object.hpp"
 #include "path_object.hpp"
+#include "shader_watcher.hpp"
+#include "gl_state.hpp"
+#include "oit.hpp"
+#include "texture_array.hpp"
+#include "path_crowd.hpp"
+#include "simulation.hpp"
+#include "command_list.hpp"
+#include "worker_pool.hpp"
+#include "frustum.hpp"
+#include "upload_thread.hpp"
+#include "obj_stream.hpp"
+#include "memory_arena.hpp"
+#include "entity_store.hpp"
+#include "entity_bench.hpp"
+#include "scene_hierarchy.hpp"
+#include "vehicle_fleet.hpp"
+#include "frame_benchmark.hpp"
+#include "input_recording.hpp"
+#include "gl_call_profiler.hpp"
 
 // include STB_IMAGE for texture mapping, provided in the "third_party" directory
 #define STB_IMAGE_IMPLEMENTATION
@@ -44,8 +68,10 @@ namespace
 	constexpr char const* kWindowTitle = "COMP3811 - Coursework 2";
 	constexpr float const kMouseSensitivity = 0.01f;
 	constexpr float const kMovementSensitivity = 2.f;
-	constexpr float const kPi = 3.1415962f;
 	constexpr size_t kLightCount = 3;
+	// simulation step of benchmark runs and input recordings, independent of
+	// the frame rate
+	constexpr float kFixedTimeStep = 1.f / 60.f;
 	float kFlightSpeed = 3.f;
 	float kNormFlightSpeed = 3.f;
 	float kSlowFlightSpeed = 1.f;
@@ -69,6 +95,35 @@ namespace
 		bool fastFlight = false;
 		bool slowFlight = false;
 		bool showGuiWindow = true;
+		TRANSPARENCY_MODE transparencyMode = TRANSPARENCY_SORTED;
+		int extraGlassPanes = 0;
+		int extraAnimationChannels = 0;
+		int crowdSize = 0;
+		bool crowdOnGpu = true;
+		bool stressTrack = false;
+		bool threadedSimulation = true;
+		int extraProps = 0;
+		bool parallelRecording = true;
+		int benchEntities = 0;
+		bool benchUseStore = true;
+		int fleetVehicles = 0;
+		bool parallelHierarchy = true;
+		bool streamCarQueued = false;
+		char scanPath[256] = "assets/Armadillo.obj";
+		bool scanLoadQueued = false;
+		char cameraPathFile[256] = "camera_path.txt";
+		bool cameraRecording = false;
+		// set while recording input, or while replaying it instead of
+		// taking live input
+		InputRecorder* inputRecorder = nullptr;
+		bool inputReplaying = false;
+	};
+
+	// large mesh loaded by the out-of-core OBJ loader
+	struct LoadedScan_
+	{
+		StreamedMesh mesh;
+		ObjStreamStats stats;
 	};
 
 	void glfw_callback_error_( int, char const* );
@@ -76,6 +131,17 @@ namespace
 	void glfw_callback_key_( GLFWwindow*, int, int, int, int );
 	void glfw_callback_motion_( GLFWwindow*, double, double );
 
+	// what the callbacks do with an event, live or replayed
+	void handle_key_( GLFWwindow*, int, int );
+	void handle_motion_( GLFWwindow*, double, double );
+
+	std::uint64_t state_digest_( FrameSnapshot const& );
+
+	// control points of a long generated track, for stress tests
+	std::vector<Vec3f> stress_track_points_();
+	// the F1's hand-placed path, or the stress-test track
+	void build_f1_track_( PathObj&, bool aStressTrack );
+
 	struct GLFWCleanupHelper
 	{
 		~GLFWCleanupHelper();
@@ -87,9 +153,13 @@ namespace
 	};
 }
 
-int main() try
+int main(int argc, char** argv) try
 {
 	//####################### SETUP #######################
+	// --bench replays a camera path for a fixed number of frames and writes
+	// the frame time statistics to a file, then exits
+	BenchmarkOptions const benchOptions = parse_benchmark_options(argc, argv);
+
 	// Initialize GLFW
 	if( GLFW_TRUE != glfwInit() )
 	{
@@ -115,13 +185,18 @@ int main() try
 	glfwWindowHint( GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE );
 
 	glfwWindowHint( GLFW_DEPTH_BITS, 24 );
+	// the OIT pass copies the depth buffer into a DEPTH24_STENCIL8 target,
+	// which requires the formats to match
+	glfwWindowHint( GLFW_STENCIL_BITS, 8 );
 
-#	if !defined(NDEBUG)
+#	if !defined(NDEBUG) || defined(OGL_PROFILE)
 	// When building in debug mode, request an OpenGL debug context. This
 	// enables additional debugging features. However, this can carry extra
-	// overheads. We therefore do not do this for release builds.
+	// overheads. We therefore do not do this for release builds. Profiling
+	// builds need one too: without it, drivers may report few or no
+	// messages.
 	glfwWindowHint( GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE );
-#	endif // ~ !NDEBUG
+#	endif // ~ !NDEBUG, OGL_PROFILE
 
 	GLFWwindow* window = glfwCreateWindow(
 		1280,
@@ -149,6 +224,36 @@ int main() try
 	state.camControl.forwards = {0.f , 0.f, 1.f};
 	state.camControl.up = {0.f , 1.0f, 0.f};
 
+	// --record-input logs key and cursor events per frame; --replay-input
+	// feeds them back in the same frames instead of the live input
+	std::optional<InputRecorder> inputRecorder;
+	std::optional<InputReplay> inputReplay;
+	if (!benchOptions.recordInput.empty())
+	{
+		inputRecorder.emplace(benchOptions.recordInput.c_str(), kFixedTimeStep);
+		state.inputRecorder = &*inputRecorder;
+	}
+	if (!benchOptions.replayInput.empty())
+	{
+		inputReplay.emplace(benchOptions.replayInput.c_str());
+		state.inputReplaying = true;
+		std::printf("Replaying %zu input events over %u frames\n", inputReplay->eventCount(), unsigned(inputReplay->frameCount()));
+	}
+
+	// benchmark runs and input recordings step the simulation by fixed
+	// amounts on this thread, so that every run renders the same frames
+	bool const fixedTimeStep = benchOptions.enabled || inputRecorder || inputReplay;
+	float const timeStep = inputReplay ? inputReplay->getTimeStep() : kFixedTimeStep;
+	if (fixedTimeStep)
+	{
+		state.threadedSimulation = benchOptions.threadedSimulation;
+	}
+	if (benchOptions.enabled)
+	{
+		state.showGuiWindow = false;
+		state.extraAnimationChannels = benchOptions.animationChannels;
+	}
+
 	// Setup lights
 	//constexpr size_t kLightCount = 2;
 	//pointLight sceneLights[kLightCount];
@@ -189,22 +294,28 @@ int main() try
 
 	// Set up drawing stuff
 	glfwMakeContextCurrent( window );
-	glfwSwapInterval( 1 ); // V-Sync is on.
+	glfwSwapInterval( benchOptions.unthrottled ? 0 : 1 ); // V-Sync is on, unless benchmarking unthrottled.
 
 	// Initialize GLAD
 	// This will load the OpenGL API. We mustn't make any OpenGL calls before this!
 	if( !gladLoadGLLoader( (GLADloadproc)&glfwGetProcAddress ) )
 		throw Error( "gladLoaDGLLoader() failed - cannot load GL API!" );
 
+	// must wrap the GL functions before the upload thread starts using them
+	if (!benchOptions.glCallsOutput.empty())
+	{
+		gl_call_profiler().install();
+	}
+
 	std::printf( "RENDERER %s\n", glGetString( GL_RENDERER ) );
 	std::printf( "VENDOR %s\n", glGetString( GL_VENDOR ) );
 	std::printf( "VERSION %s\n", glGetString( GL_VERSION ) );
 	std::printf( "SHADING_LANGUAGE_VERSION %s\n", glGetString( GL_SHADING_LANGUAGE_VERSION ) );
 
-	// Ddebug output
-#	if !defined(NDEBUG)
+	// Ddebug output; asynchronous in profiling builds
+#	if !defined(NDEBUG) || defined(OGL_PROFILE)
 	setup_gl_debug_output();
-#	endif // ~ !NDEBUG
+#	endif // ~ !NDEBUG, OGL_PROFILE
 
 	// Global GL state
 	OGL_CHECKPOINT_ALWAYS();
@@ -242,182 +353,31 @@ int main() try
 		{ GL_FRAGMENT_SHADER, "assets/alternative.frag" }
 		});
 
+	// Watch the shader sources so that edits are picked up without a restart
+	ShaderWatcher shaderWatcher("assets");
+
+	// Targets and shaders for weighted blended order-independent transparency
+	WeightedBlendedOIT oit;
+
 	// Other initialization & loading
 	OGL_CHECKPOINT_ALWAYS();
 
 	//####################### Texture Loading ############################
 	// Guide for texture mapping: https://learnopengl.com/Getting-started/Textures
 	// As a rule of thumb, we want to load textures once only so we do it out of the main loop
-	// Reserve an ID to our cobblestoneFloor and bind
-	unsigned int cobblestoneFloor;
-	glGenTextures(1, &cobblestoneFloor);
-	glBindTexture(GL_TEXTURE_2D, cobblestoneFloor);
-	// set the texture wrapping/filtering options (on the currently bound texture object)
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	// Load wooden container texture
-	int cobblestoneFloorWidth, cobblestoneFloorHeight, cobblestoneFloorNRChannels;
-	unsigned char* cobblestoneFloorData = stbi_load("assets/textures/cobblestonefloor.jpeg", &cobblestoneFloorWidth, &cobblestoneFloorHeight, &cobblestoneFloorNRChannels, 0);
-	// Generate a texture using the image data
-	// Take note if there's an Alpha value or not, you'll either use GL_RGB or GL_RGBA
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, cobblestoneFloorWidth, cobblestoneFloorHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, cobblestoneFloorData);
-	glGenerateMipmap(GL_TEXTURE_2D);
-	// free the memory used for the image data
-	stbi_image_free(cobblestoneFloorData);
-
-	// Reserve an ID for our markusTexture and bind
-	unsigned int markusTexture;
-	glGenTextures(1, &markusTexture);
-	glBindTexture(GL_TEXTURE_2D, markusTexture);
-	// set the texture wrapping/filtering options (on the currently bound texture object)
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	// Load markus container texture
-	int markusTextureWidth, markusTextureHeight, markusTextureNRChannels;
-	unsigned char* markusTextureData = stbi_load("assets/textures/markus.png", &markusTextureWidth, &markusTextureHeight, &markusTextureNRChannels, 0);
-	// Generate a texture using the image data
-	// Take note if there's an Alpha value or not, you'll either use GL_RGB or GL_RGBA
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, markusTextureWidth, markusTextureHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, markusTextureData);
-	glGenerateMipmap(GL_TEXTURE_2D);
-	// free the memory used for the image data
-	stbi_image_free(markusTextureData);
-
-	// window texture
-	unsigned int windowTexture;
-	glGenTextures(1, &windowTexture);
-	glBindTexture(GL_TEXTURE_2D, windowTexture);
-	// set the texture wrapping/filtering options (on the currently bound texture object)
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	// Load window texture
-	int windowTextureWidth, windowTextureHeight, windowTextureNRChannels;
-	unsigned char* windowTextureData = stbi_load("assets/textures/window.png", &windowTextureWidth, &windowTextureHeight, &windowTextureNRChannels, 0);
-	// Generate a texture using the image data
-	// Take note if there's an Alpha value or not, you'll either use GL_RGB or GL_RGBA
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, windowTextureWidth, windowTextureHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, windowTextureData);
-	glGenerateMipmap(GL_TEXTURE_2D);
-	// free the memory used for the image data
-	stbi_image_free(windowTextureData);
-
-	// nightsky texture
-	unsigned int nightSkyTexture;
-	glGenTextures(1, &nightSkyTexture);
-	glBindTexture(GL_TEXTURE_2D, nightSkyTexture);
-	// set the texture wrapping/filtering options (on the currently bound texture object)
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	// Load nightSky texture
-	int nightSkyTextureWidth, nightSkyTextureHeight, nightSkyTextureNRChannels;
-	unsigned char* nightSkyTextureData = stbi_load("assets/textures/nightsky.jpeg", &nightSkyTextureWidth, &nightSkyTextureHeight, &nightSkyTextureNRChannels, 0);
-	// Generate a texture using the image data
-	// Take note if there's an Alpha value or not, you'll either use GL_RGB or GL_RGBA
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, nightSkyTextureWidth, nightSkyTextureHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, nightSkyTextureData);
-	glGenerateMipmap(GL_TEXTURE_2D);
-	// free the memory used for the image data
-	stbi_image_free(nightSkyTextureData);
-
-	// northcity texture
-	unsigned int northCityTexture;
-	glGenTextures(1, &northCityTexture);
-	glBindTexture(GL_TEXTURE_2D, northCityTexture);
-	// set the texture wrapping/filtering options (on the currently bound texture object)
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	// Load northCity texture
-	int northCityTextureWidth, northCityTextureHeight, northCityTextureNRChannels;
-	unsigned char* northCityTextureData = stbi_load("assets/textures/northcity.jpg", &northCityTextureWidth, &northCityTextureHeight, &northCityTextureNRChannels, 0);
-	// Generate a texture using the image data
-	// Take note if there's an Alpha value or not, you'll either use GL_RGB or GL_RGBA
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, northCityTextureWidth, northCityTextureHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, northCityTextureData);
-	glGenerateMipmap(GL_TEXTURE_2D);
-	// free the memory used for the image data
-	stbi_image_free(northCityTextureData);
-
-	// southcity texture
-	unsigned int southCityTexture;
-	glGenTextures(1, &southCityTexture);
-	glBindTexture(GL_TEXTURE_2D, southCityTexture);
-	// set the texture wrapping/filtering options (on the currently bound texture object)
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	// Load southCity texture
-	int southCityTextureWidth, southCityTextureHeight, southCityTextureNRChannels;
-	unsigned char* southCityTextureData = stbi_load("assets/textures/southcity.jpg", &southCityTextureWidth, &southCityTextureHeight, &southCityTextureNRChannels, 0);
-	// Generate a texture using the image data
-	// Take note if there's an Alpha value or not, you'll either use GL_RGB or GL_RGBA
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, southCityTextureWidth, southCityTextureHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, southCityTextureData);
-	glGenerateMipmap(GL_TEXTURE_2D);
-	// free the memory used for the image data
-	stbi_image_free(southCityTextureData);
-
-	// eastcity texture
-	unsigned int eastCityTexture;
-	glGenTextures(1, &eastCityTexture);
-	glBindTexture(GL_TEXTURE_2D, eastCityTexture);
-	// set the texture wrapping/filtering options (on the currently bound texture object)
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	// Load eastCity texture
-	int eastCityTextureWidth, eastCityTextureHeight, eastCityTextureNRChannels;
-	unsigned char* eastCityTextureData = stbi_load("assets/textures/eastcity.jpg", &eastCityTextureWidth, &eastCityTextureHeight, &eastCityTextureNRChannels, 0);
-	// Generate a texture using the image data
-	// Take note if there's an Alpha value or not, you'll either use GL_RGB or GL_RGBA
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, eastCityTextureWidth, eastCityTextureHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, eastCityTextureData);
-	glGenerateMipmap(GL_TEXTURE_2D);
-	// free the memory used for the image data
-	stbi_image_free(eastCityTextureData);
-
-	// westcity texture
-	unsigned int westCityTexture;
-	glGenTextures(1, &westCityTexture);
-	glBindTexture(GL_TEXTURE_2D, westCityTexture);
-	// set the texture wrapping/filtering options (on the currently bound texture object)
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	// Load westCity texture
-	int westCityTextureWidth, westCityTextureHeight, westCityTextureNRChannels;
-	unsigned char* westCityTextureData = stbi_load("assets/textures/westcity.jpg", &westCityTextureWidth, &westCityTextureHeight, &westCityTextureNRChannels, 0);
-	// Generate a texture using the image data
-	// Take note if there's an Alpha value or not, you'll either use GL_RGB or GL_RGBA
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, westCityTextureWidth, westCityTextureHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, westCityTextureData);
-	glGenerateMipmap(GL_TEXTURE_2D);
-	// free the memory used for the image data
-	stbi_image_free(westCityTextureData);
-
-	// iron texture
-	unsigned int ironTexture;
-	glGenTextures(1, &ironTexture);
-	glBindTexture(GL_TEXTURE_2D, ironTexture);
-	// set the texture wrapping/filtering options (on the currently bound texture object)
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	// Load iron texture
-	int ironTextureWidth, ironTextureHeight, ironTextureNRChannels;
-	unsigned char* ironTextureData = stbi_load("assets/textures/iron.jpg", &ironTextureWidth, &ironTextureHeight, &ironTextureNRChannels, 0);
-	// Generate a texture using the image data
-	// Take note if there's an Alpha value or not, you'll either use GL_RGB or GL_RGBA
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, ironTextureWidth, ironTextureHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, ironTextureData);
-	glGenerateMipmap(GL_TEXTURE_2D);
-	// free the memory used for the image data
-	stbi_image_free(ironTextureData);
+	// The scene textures all live in one texture array, so the draws that use
+	// them only differ by the layer uniform and never rebind a texture.
+	TextureArray sceneTextures(512, 512);
+	GLint const cobblestoneFloor = sceneTextures.add("assets/textures/cobblestonefloor.jpeg");
+	GLint const markusTexture = sceneTextures.add("assets/textures/markus.png");
+	GLint const windowTexture = sceneTextures.add("assets/textures/window.png");
+	GLint const nightSkyTexture = sceneTextures.add("assets/textures/nightsky.jpeg");
+	GLint const northCityTexture = sceneTextures.add("assets/textures/northcity.jpg");
+	GLint const southCityTexture = sceneTextures.add("assets/textures/southcity.jpg");
+	GLint const eastCityTexture = sceneTextures.add("assets/textures/eastcity.jpg");
+	GLint const westCityTexture = sceneTextures.add("assets/textures/westcity.jpg");
+	GLint const ironTexture = sceneTextures.add("assets/textures/iron.jpg");
+	sceneTextures.build();
 	
 
 	//####################### VBO and VAO creation #######################
@@ -584,7 +544,47 @@ int main() try
 
 	SceneObj streetlampObj;
 	streetlampObj.initialise("assets/streetlamp.obj");
-	streetlampObj.forceTexture("textures/iron.jpg");
+	streetlampObj.forceTextureLayer(sceneTextures.textureId(), ironTexture);
+	streetlampObj.setResidency(RESIDENCY_BOUNDS_ONLY);
+
+	// static scenery is kept in an entity store: placed once here, then
+	// culled and submitted by the store each frame
+	EntityStore sceneEntities;
+	{
+		std::vector<DrawItem> lampParts;
+		streetlampObj.drawItems(0, lampParts);
+		auto const lampBounds = streetlampObj.getBounds();
+
+		// streetlamps (SE, SW, N)
+		struct { Vec3f position; float angle; } const lamps[] = {
+			{ { -5.f, 0.f, -5.f }, kPi * 3 / 4 },
+			{ { 5.f, 0.f, -5.f }, kPi / 4 },
+			{ { 0.f, 0.f, 5.f }, -kPi / 2 }
+		};
+		for (auto const& lamp : lamps)
+		{
+			Entity const entity = sceneEntities.create(lamp.position, { 0.f, lamp.angle, 0.f }, { 0.25f, 0.25f, 0.25f });
+			sceneEntities.setRender(entity, lampParts.data(), lampParts.size());
+			if (lampBounds)
+			{
+				sceneEntities.setBounds(entity, 0.5f * (lampBounds->min + lampBounds->max), 0.5f * length(lampBounds->max - lampBounds->min));
+			}
+		}
+		sceneEntities.updateTransforms();
+	}
+
+	// the monument to Markus and its glass box, as one assembly; scaled
+	// pieces are leaves so that their scale is not inherited
+	SceneHierarchy sceneNodes;
+	HierarchyNode const monumentRoot = sceneNodes.create(kNoParentNode, make_translation({ -5.f, 0.f, 0.f }));
+	HierarchyNode const monumentNode = sceneNodes.create(monumentRoot, make_translation({ 0.f, 0.1f, 0.f }) * make_scaling(0.5f, 0.1f, 0.5f));
+	HierarchyNode const markusNode = sceneNodes.create(monumentRoot, make_translation({ 0.f, 0.21f, 0.f }) * make_scaling(0.4f, 0.025f, 0.4f));
+	HierarchyNode const glassBoxNode = sceneNodes.create(monumentRoot, make_translation({ 0.f, 0.25f, 0.f }));
+	HierarchyNode const glassTopNode = sceneNodes.create(glassBoxNode, make_translation({ 0.f, 0.25f, 0.f }) * make_scaling(1.f, 0.01f, 1.f));
+	HierarchyNode const glassNorthNode = sceneNodes.create(glassBoxNode, make_translation({ 0.f, 0.f, 1.f }) * make_scaling(1.f, 0.25f, 0.01f));
+	HierarchyNode const glassSouthNode = sceneNodes.create(glassBoxNode, make_translation({ 0.f, 0.f, -1.f }) * make_scaling(1.f, 0.25f, 0.01f));
+	HierarchyNode const glassWestNode = sceneNodes.create(glassBoxNode, make_translation({ 1.f, 0.f, 0.f }) * make_scaling(0.01f, 0.25f, 1.f));
+	HierarchyNode const glassEastNode = sceneNodes.create(glassBoxNode, make_translation({ -1.f, 0.f, 0.f }) * make_scaling(0.01f, 0.25f, 1.f));
 
 	SceneObject globeObj;
 	initObject(&globeObj, "assets/globe-sphere.obj");
@@ -593,9 +593,11 @@ int main() try
 	{
 		globeObj.mesh.colors[i] = { 1.f, 1.f, 1.f };
 	}
+	globeObj.residency = RESIDENCY_BOUNDS_ONLY;
 	updateObject(&globeObj);
 
 	SceneObject armadilloObj;
+	armadilloObj.residency = RESIDENCY_DROP;
 	initObject(&armadilloObj, "assets/Armadillo.obj");
 
 	ComplexSceneObject f1carObj;
@@ -610,81 +612,53 @@ int main() try
 
 	PathObj f1Obj;
 	f1Obj.initialise("assets/f1_modified/f1.obj");
+	f1Obj.setResidency(RESIDENCY_BOUNDS_ONLY);
 	//f1Obj.initialise("assets/f1/ferrari-f1-race-car.obj");
 	/*f1Obj.rotate({0.f, 0.5f * kPi, 0.f});
 	f1Obj.setPositionAnchors(Vec3f{-10.f, 0.f, 6.f}, Vec3f{10.f, 0.f, 6.f});
 	f1Obj.setupAnimation(300, RECIPROCAL, REPEAT);*/
 
-	float r = 0.5f * kPi;
-
-	f1Obj.addPathPoint({
-		{0.f, r, 0.f},
-		{-10.f, 0.f, 6.f},
-		{1.f, 1.f, 1.f},
-		200, S_CURVE
-	});
-
-	f1Obj.addPathPoint({
-		{0.f, r, 0.f},
-		{10.f, 0.f, 6.f},
-		{1.f, 1.f, 1.f},
-		100, SINUSOIDAL
-	});
-
-	f1Obj.addPathPoint({
-		{0.f, r * 1.5f, 0.f},
-		{12.f, 0.f, 4.f},
-		{1.f, 1.f, 1.f},
-		100, SINUSOIDAL
-	});
-
-	f1Obj.addPathPoint({
-		{0.f, r * 2.f, 0.f},
-		{10.f, 0.f, 6.f},
-		{1.f, 1.f, 1.f},
-		100, SINUSOIDAL
-	});
-
-	f1Obj.addPathPoint({
-		{0.f, r * 2.5f, 0.f},
-		{12.f, 0.f, 8.f},
-		{1.f, 1.f, 1.f},
-		100, SINUSOIDAL
-	});
-
-	f1Obj.addPathPoint({
-		{0.f, r * 3.f, 0.f},
-		{10.f, 0.f, 6.f},
-		{1.f, 1.f, 1.f},
-		100, SINUSOIDAL
-	});
-
-	f1Obj.addPathPoint({
-		{0.f, r * 3.f, 0.f},
-		{-10.f, 0.f, 6.f},
-		{1.f, 1.f, 1.f},
-		200, S_CURVE
-	});
-
-	f1Obj.setupPath();
+	build_f1_track_(f1Obj, state.stressTrack);
+	bool stressTrackBuilt = state.stressTrack;
+
+	// stress test: many more cars on the stress-test track, drawn instanced
+	CatmullRomSpline crowdTrack;
+	crowdTrack.build(stress_track_points_(), true);
+	PathCrowd crowd;
+	crowd.setTrack(crowdTrack);
+	int crowdBuilt = 0;
+	float crowdCpuMs = 0.f;
 
 	AnimationObj arm2Obj;
 	arm2Obj.initialise("assets/Armadillo.obj");
 	arm2Obj.move({0.f, 0.f, -4.f});
 	arm2Obj.forceFakeTexCoords();
 	arm2Obj.forceTexture("squiggle.png");
+	// the fake texture coordinates are redone if the file is read again
+	arm2Obj.setResidency(RESIDENCY_DROP);
 	arm2Obj.setRotationAnchors(Vec3f{0.f, 0.5f*kPi, 0.f}, Vec3f{0.f, 1.5*kPi, 0.f});
 	arm2Obj.setupAnimation(200, LINEAR, BOUNCE);
 	//arm2Obj.forceTexture("assets/squiggle.png");
 
 	AnimationObj muscleCarObj;
 	muscleCarObj.initialise("assets/msc_car/1967-shelby-ford-mustang.obj");
+	muscleCarObj.setResidency(RESIDENCY_BOUNDS_ONLY);
 	muscleCarObj.scale({0.4f, 0.4f, 0.4f});
 	muscleCarObj.rotate({0.f, 1.5f * kPi, 0.f});
 	muscleCarObj.setPositionAnchors(Vec3f{-10.f, 0.f, 4.f}, Vec3f{10.f, 0.f, 4.f});
 	muscleCarObj.setupAnimation(300, SINUSOIDAL, REPEAT);
 
+	// camera movement and animation run separately from rendering, either
+	// inline or on their own thread; the renderer only reads the resulting
+	// snapshots, never the animated objects' transforms
+	SceneSimulation simulation(f1Obj, arm2Obj, muscleCarObj, state.camControl.position);
+	std::optional<SimulationThread> simulationThread;
+	FrameSnapshot serialSnapshot;
+	// CPU time spent on a frame, excluding the wait in glfwSwapBuffers()
+	float cpuFrameMs = 0.f;
+
 	
+	f1carObj.object.residency = RESIDENCY_BOUNDS_ONLY;
 	updateComplexObject(&f1carObj);
 
 	SceneObject bulbObj;
@@ -695,12 +669,68 @@ int main() try
 	{
 		bulbObj.mesh.colors[i] = {1.f, 1.f, 1.f};
 	}
+	bulbObj.residency = RESIDENCY_DROP;
 	updateObject(&bulbObj);
 
+	// per-frame memory, reset at the start of each frame; the uniforms of
+	// every draw submitted directly to the queue are packed into it
+	ArenaResource frameArena("frame");
+	RenderQueue renderQueue(frameArena.arena());
+
+	// Cars can be streamed in while the scene is running. Loading and the
+	// buffer/texture uploads happen on the upload thread's shared context;
+	// only the VAOs are created here once the upload's fence has passed.
+	// The pool keeps the objects in place while their upload is pending, and
+	// is declared before the uploader so that it outlives the upload thread.
+	ObjectPool<SceneObj> carPool;
+	std::vector<SceneObj*> streamedCars;
+	// very large meshes are parsed in parallel straight into GPU buffers,
+	// also on the upload thread
+	std::list<LoadedScan_> scans;
+	ObjStreamLoader scanLoader;
+	UploadThread uploader(window);
+	float streamingWorstFrameMs = 0.f;
+
+	// Large numbers of small props are culled and recorded by worker threads
+	// into their own command lists, which the queue merges and replays here.
+	WorkerPool recordPool;
+	std::vector<CommandList> propLists(recordPool.workerCount());
+	size_t propsRecorded = 0;
+	size_t propListsUsed = 0;
+	float propRecordMs = 0.f;
+
+	// the same field of animated cubes as an EntityStore or as AnimationObjs
+	EntityBenchmark entityBench;
+	EntityBenchStats entityBenchStats;
+	// cars made of a few dozen nodes each, for the transform hierarchy
+	VehicleFleet fleet;
+	VehicleFleetStats fleetStats;
+
+	// GPU time of whole frames, and the benchmark run or camera recording
+	GpuFrameTimer frameTimer;
+	float gpuFrameMs = 0.f;
+	std::uint64_t frameNumber = 0;
+	CameraPath benchPath;
+	BenchmarkReport benchReport;
+	if (benchOptions.enabled)
+	{
+		if (benchOptions.cameraPath.empty()) benchPath = make_default_fly_through();
+		else benchPath.load(benchOptions.cameraPath.c_str());
+		benchReport.reserve(size_t(benchOptions.frames));
+	}
+	CameraPath recordedPath;
+	float recordedTime = 0.f;
+
 	auto lastTime = Clock::now();
 
 	ImGui::CreateContext();
 	ImGuiIO& io = ImGui::GetIO(); (void)io;
+	// clicks on the GUI are not recorded, so it only displays while input
+	// is recorded or replayed
+	if (inputRecorder || inputReplay)
+	{
+		io.ConfigFlags |= ImGuiConfigFlags_NoMouse;
+	}
 	ImGui::StyleColorsDark();
 	ImGui_ImplGlfw_InitForOpenGL(window, true);
 	ImGui_ImplOpenGL3_Init("#version 150");
@@ -709,8 +739,30 @@ int main() try
 	while( !glfwWindowShouldClose( window ) )
 	{
 		// Let GLFW process events
+		if (inputRecorder) inputRecorder->setFrame(std::uint32_t(frameNumber));
 		glfwPollEvents();
 
+		if (inputReplay)
+		{
+			inputReplay->play(std::uint32_t(frameNumber), [&] (InputEvent const& aEvent) {
+				if (INPUT_EVENT_KEY == aEvent.type) handle_key_(window, aEvent.key, aEvent.action);
+				else handle_motion_(window, aEvent.x, aEvent.y);
+			});
+		}
+
+		frameArena.reset();
+
+		// finish background uploads; creates VAOs
+		{
+			GL_PROFILE_SCOPE("uploads");
+			uploader.poll();
+		}
+
+		// ImGui and the loaders change GL state behind the cache's back
+		gl_state().beginFrame();
+
+		frameTimer.begin(frameNumber);
+
 		ImGui_ImplOpenGL3_NewFrame();
 		ImGui_ImplGlfw_NewFrame();
 		ImGui::NewFrame();
@@ -721,9 +773,6 @@ int main() try
 			int nwidth, nheight;
 			glfwGetFramebufferSize( window, &nwidth, &nheight );
 
-			fbwidth = float(nwidth);
-			fbheight = float(nheight);
-
 			if( 0 == nwidth || 0 == nheight )
 			{
 				// Window minimized? Pause until it is unminimized.
@@ -735,6 +784,10 @@ int main() try
 				} while( 0 == nwidth || 0 == nheight );
 			}
 
+			// the size after restoring, not the 0x0 of the minimised window
+			fbwidth = float(nwidth);
+			fbheight = float(nheight);
+
 			glViewport( 0, 0, nwidth, nheight );
 		}
 
@@ -752,12 +805,97 @@ int main() try
 			kFlightSpeed = kSlowFlightSpeed;
 		}
 
-		if (state.camControl.actionForwards)	state.camControl.position += dt * kFlightSpeed * cam_forwards(&state.camControl);
-		if (state.camControl.actionBackwards)	state.camControl.position += dt * kFlightSpeed * cam_backwards(&state.camControl);
-		if (state.camControl.actionLeft)		state.camControl.position += dt * kFlightSpeed * cam_left(&state.camControl);
-		if (state.camControl.actionRight)		state.camControl.position += dt * kFlightSpeed * cam_right(&state.camControl);
-		if (state.camControl.actionUp)			state.camControl.position += dt * kFlightSpeed * cam_up(&state.camControl);
-		if (state.camControl.actionDown)		state.camControl.position += dt * kFlightSpeed * cam_down(&state.camControl);
+		if (fixedTimeStep)
+		{
+			dt = timeStep;
+		}
+
+		// a replayed recording moves the camera itself
+		bool const cameraScripted = benchOptions.enabled && !inputReplay;
+		Vec3f scriptedCameraPosition{};
+		if (cameraScripted)
+		{
+			float const duration = benchPath.duration();
+			float const pathTime = duration > 0.f ? std::fmod(float(frameNumber) * timeStep, duration) : 0.f;
+			CameraKey const key = benchPath.sample(pathTime);
+			state.camControl.theta = key.theta;
+			state.camControl.phi = key.phi;
+			scriptedCameraPosition = key.position;
+		}
+
+		// the simulation thread reads the F1's path, so it is stopped while
+		// the path is rebuilt; it is started again below
+		if (stressTrackBuilt != state.stressTrack)
+		{
+			simulationThread.reset();
+			build_f1_track_(f1Obj, state.stressTrack);
+			stressTrackBuilt = state.stressTrack;
+		}
+
+		SimulationInput simulationInput;
+		simulationInput.camera = state.camControl;
+		simulationInput.flightSpeed = kFlightSpeed;
+		simulationInput.animationFactor = state.animationFactor;
+		simulationInput.animationPause = state.animationPause;
+		simulationInput.extraAnimationChannels = state.extraAnimationChannels;
+		simulationInput.timeStep = fixedTimeStep ? timeStep : 0.f;
+		simulationInput.cameraScripted = cameraScripted;
+		simulationInput.scriptedCameraPosition = scriptedCameraPosition;
+		for (size_t i = 0; i < kLightCount; i++)
+		{
+			simulationInput.lights[i] = state.sceneLights[i];
+		}
+
+		// In threaded mode the next step runs while this frame renders the
+		// latest finished one, so the scene lags input by up to a frame.
+		FrameSnapshot const* snapshot = &serialSnapshot;
+		if (state.threadedSimulation)
+		{
+			if (!simulationThread) simulationThread.emplace(simulation);
+			simulationThread->request(simulationInput);
+			snapshot = &simulationThread->latest();
+		}
+		else
+		{
+			simulationThread.reset();
+			simulation.step(simulationInput, dt, serialSnapshot);
+		}
+		state.camControl.position = snapshot->cameraPosition;
+
+		if (state.cameraRecording)
+		{
+			recordedPath.add({ recordedTime, snapshot->cameraPosition, state.camControl.theta, state.camControl.phi });
+			recordedTime += dt;
+		}
+
+		if (state.streamCarQueued)
+		{
+			SceneObj& car = *streamedCars.emplace_back(carPool.create());
+			car.scale({0.4f, 0.4f, 0.4f});
+			car.move({-8.f + 2.5f * float(streamedCars.size() - 1), 0.f, -8.f});
+			car.setResidency(RESIDENCY_DROP);
+			car.initialiseAsync("assets/msc_car/1967-shelby-ford-mustang.obj", uploader);
+			streamingWorstFrameMs = 0.f;
+			state.streamCarQueued = false;
+		}
+		if (state.scanLoadQueued)
+		{
+			auto& scan = scans.emplace_back();
+			uploader.enqueue(
+				[&scanLoader, &scan, path = std::string(state.scanPath)] {
+					scan.stats = scanLoader.load(path, scan.mesh);
+				},
+				[&scan] {
+					if (scan.stats.triangles > 0) scan.mesh.createVertexArray();
+				}
+			);
+			streamingWorstFrameMs = 0.f;
+			state.scanLoadQueued = false;
+		}
+		if (uploader.pending() > 0)
+		{
+			streamingWorstFrameMs = std::max(streamingWorstFrameMs, 1000.f * dt);
+		}
 
 		if (state.showGuiWindow)
 		{
@@ -765,6 +903,15 @@ int main() try
 			ImGui::Text("Animation controls");
 			ImGui::Checkbox("Disable Animations", &state.animationPause);
 			ImGui::SliderInt("Animation Speed", &state.animationFactor, 1, 5);
+			ImGui::SliderInt("Extra animation channels", &state.extraAnimationChannels, 0, 100000);
+			ImGui::Text("Animation system: %zu channels, %.3f ms", snapshot->animationChannels, snapshot->animationUpdateMs);
+			ImGui::Checkbox("Simulate on separate thread", &state.threadedSimulation);
+			ImGui::Text("Simulation step %.3f ms, CPU frame %.3f ms, GPU frame %.3f ms", snapshot->simulationMs, cpuFrameMs, gpuFrameMs);
+
+			ImGui::Checkbox("F1 on stress-test track (2048 points)", &state.stressTrack);
+			ImGui::SliderInt("Path crowd", &state.crowdSize, 0, 10000);
+			ImGui::Checkbox("Evaluate crowd on GPU", &state.crowdOnGpu);
+			ImGui::Text("Crowd update + draw: CPU %.3f ms, GPU %.3f ms", crowdCpuMs, crowd.lastGpuMs());
 
 			ImGui::Spacing();
 			ImGui::Text("Flight Controls");
@@ -794,6 +941,7 @@ int main() try
 					{ GL_VERTEX_SHADER, "assets/default.vert" },
 					{ GL_FRAGMENT_SHADER, "assets/correct_blinn-phong.frag" }
 					});
+				gl_state().forgetUniforms();
 			}
 			ImGui::SameLine();
 			if (ImGui::Button("Alternative"))
@@ -802,6 +950,7 @@ int main() try
 					{ GL_VERTEX_SHADER, "assets/default.vert" },
 					{ GL_FRAGMENT_SHADER, "assets/alternative.frag" }
 					});
+				gl_state().forgetUniforms();
 			}
 			ImGui::SameLine();
 			if (ImGui::Button("Normals"))
@@ -810,6 +959,7 @@ int main() try
 					{ GL_VERTEX_SHADER, "assets/default.vert" },
 					{ GL_FRAGMENT_SHADER, "assets/normals.frag" }
 					});
+				gl_state().forgetUniforms();
 			}
 			ImGui::SameLine();
 			if (ImGui::Button("Textures"))
@@ -818,127 +968,267 @@ int main() try
 					{ GL_VERTEX_SHADER, "assets/default.vert" },
 					{ GL_FRAGMENT_SHADER, "assets/textures.frag" }
 					});
+				gl_state().forgetUniforms();
+			}
+
+			ImGui::Spacing();
+			ImGui::Text("Transparency");
+			if (ImGui::RadioButton("Sorted", state.transparencyMode == TRANSPARENCY_SORTED))
+			{
+				state.transparencyMode = TRANSPARENCY_SORTED;
+			}
+			ImGui::SameLine();
+			if (ImGui::RadioButton("Weighted blended OIT", state.transparencyMode == TRANSPARENCY_WEIGHTED_BLENDED))
+			{
+				state.transparencyMode = TRANSPARENCY_WEIGHTED_BLENDED;
+			}
+			ImGui::SliderInt("Extra glass panes", &state.extraGlassPanes, 0, 500);
+
+			ImGui::Spacing();
+			ImGui::Text("Command lists");
+			ImGui::SliderInt("Extra props", &state.extraProps, 0, 50000);
+			ImGui::Checkbox("Record on worker threads", &state.parallelRecording);
+			ImGui::Text("Recorded %zu of %d props on %zu threads, %.3f ms", propsRecorded, state.extraProps, propListsUsed, propRecordMs);
+
+			ImGui::Spacing();
+			ImGui::Text("Entities");
+			ImGui::SliderInt("Benchmark entities", &state.benchEntities, 0, 50000);
+			ImGui::Checkbox("Entity store (off: AnimationObjs)", &state.benchUseStore);
+			if (state.benchEntities > 0)
+			{
+				ImGui::Text("%zu entities, %zu visible in %.3f ms", entityBenchStats.entities, entityBenchStats.visible, entityBenchStats.totalMs);
+				if (state.benchUseStore)
+				{
+					ImGui::Text("animate %.3f, transform %.3f, cull %.3f, submit %.3f ms", entityBenchStats.animateMs,
+						entityBenchStats.transformMs, entityBenchStats.cullMs, entityBenchStats.submitMs);
+				}
+			}
+
+			ImGui::Spacing();
+			ImGui::Text("Transform hierarchy");
+			ImGui::SliderInt("Vehicles", &state.fleetVehicles, 0, 2500);
+			ImGui::Checkbox("Update subtrees on worker threads", &state.parallelHierarchy);
+			if (state.fleetVehicles > 0)
+			{
+				ImGui::Text("%zu nodes, %zu recomputed in %.3f ms (animate %.3f, submit %zu parts %.3f ms)",
+					fleetStats.nodes, fleetStats.recomputed, fleetStats.updateMs, fleetStats.animateMs,
+					fleetStats.drawn, fleetStats.submitMs);
+			}
+
+			ImGui::Spacing();
+			ImGui::Text("Camera path, for --bench --bench-path");
+			ImGui::InputText("Path file", state.cameraPathFile, sizeof(state.cameraPathFile));
+			if (!state.cameraRecording && ImGui::Button("Record"))
+			{
+				recordedPath.clear();
+				recordedTime = 0.f;
+				state.cameraRecording = true;
+			}
+			else if (state.cameraRecording && ImGui::Button("Stop and save"))
+			{
+				state.cameraRecording = false;
+				try
+				{
+					recordedPath.save(state.cameraPathFile);
+				}
+				catch (Error const& eErr)
+				{
+					std::fprintf(stderr, "%s\n", eErr.what());
+				}
+			}
+			ImGui::SameLine();
+			ImGui::Text("%zu keys, %.1f s", recordedPath.size(), recordedPath.duration());
+
+			ImGui::Spacing();
+			ImGui::Text("Streaming");
+			if (ImGui::Button("Stream in a car"))
+			{
+				state.streamCarQueued = true;
+			}
+			ImGui::SameLine();
+			ImGui::Text("%zu cars, %zu uploads pending, worst frame while streaming %.1f ms",
+				streamedCars.size(), uploader.pending(), streamingWorstFrameMs);
+
+			ImGui::InputText("Scan", state.scanPath, sizeof(state.scanPath));
+			ImGui::SameLine();
+			if (ImGui::Button("Load"))
+			{
+				state.scanLoadQueued = true;
+			}
+			for (auto const& scan : scans)
+			{
+				if (!scan.mesh.ready()) continue;
+				ImGui::Text("%.1f MB, %zu triangles in %.2f s: %.0f MB/s, peak RSS +%.1f MB",
+					float(scan.stats.fileBytes) / (1024.f * 1024.f), scan.stats.triangles, scan.stats.seconds,
+					scan.stats.megabytesPerSecond, float(scan.stats.peakRssGrowthBytes) / (1024.f * 1024.f));
+			}
+
+			ImGui::Spacing();
+			ImGui::Text("CPU mesh memory by residency policy");
+			{
+				static char const* const kResidencyNames[] = { "Keep", "Bounds only", "Drop" };
+				size_t residentBytes[3] = {};
+				size_t residentObjects[3] = {};
+				auto count_object = [&] (MESH_RESIDENCY aResidency, size_t aBytes) {
+					residentBytes[aResidency] += aBytes;
+					residentObjects[aResidency]++;
+				};
+
+				for (SceneObj const* object : { (SceneObj const*)&streetlampObj, (SceneObj const*)&f1Obj, (SceneObj const*)&arm2Obj, (SceneObj const*)&muscleCarObj })
+				{
+					count_object(object->getResidency(), object->residentBytes());
+				}
+				for (SceneObj const* car : streamedCars)
+				{
+					// still owned by the upload thread until initialised
+					if (car->isInitialised()) count_object(car->getResidency(), car->residentBytes());
+				}
+				for (SceneObject const* object : { &globeObj, &armadilloObj, &bulbObj })
+				{
+					count_object(object->residency, objectResidentBytes(object));
+				}
+				count_object(f1carObj.object.residency, complexObjectResidentBytes(&f1carObj));
+
+				for (int i = 0; i < 3; i++)
+				{
+					ImGui::Text("%-11s %2zu objects, %8.2f MB", kResidencyNames[i], residentObjects[i],
+						float(residentBytes[i]) / (1024.f * 1024.f));
+				}
+			}
+
+			ImGui::Spacing();
+			ImGui::Text("Allocators (arenas as of their last reset)");
+			for_each_arena([] (const ArenaStats& aStats) {
+				ImGui::Text("%-14s used %8.1f KB, high water %8.1f KB, reserved %8.1f KB, %zu resets", aStats.name,
+					float(aStats.bytesUsed) / 1024.f, float(aStats.highWater) / 1024.f,
+					float(aStats.bytesReserved) / 1024.f, aStats.resets);
+			});
+			ImGui::Text("%-14s %zu live, high water %zu, capacity %zu (%.1f KB)", "car pool",
+				carPool.liveCount(), carPool.highWaterMark(), carPool.capacity(), float(carPool.bytesReserved()) / 1024.f);
+
+			ImGui::Spacing();
+			ImGui::Text("GL state cache (last frame)");
+			{
+				static char const* const kCategoryNames[STATE_CATEGORY_COUNT] = {
+					"Program", "Vertex array", "Texture", "Capability", "Blend/depth", "Uniform"
+				};
+				auto const& counters = gl_state().frameCounters();
+				for (int i = 0; i < STATE_CATEGORY_COUNT; i++)
+				{
+					ImGui::Text("%-13s issued %4zu, filtered %4zu", kCategoryNames[i], counters.issued[i], counters.filtered[i]);
+				}
+				ImGui::Text("%-13s issued %4zu, filtered %4zu", "Total", counters.totalIssued(), counters.totalFiltered());
+
+				auto const& queueStats = renderQueue.lastStats();
+				ImGui::Text("Draws %zu: program %zu, VAO %zu, texture %zu, material changes %zu",
+					queueStats.draws, queueStats.programChanges, queueStats.vertexArrayChanges,
+					queueStats.textureChanges, queueStats.materialChanges);
+			}
+
+			if (gl_call_profiler().installed())
+			{
+				// the GUI itself is drawn through its own loader and not counted
+				auto const& glCalls = gl_call_profiler().frame();
+				ImGui::Spacing();
+				ImGui::Text("GL calls (last frame): %llu, %.3f ms in the driver",
+					static_cast<unsigned long long>(glCalls.calls), glCalls.ms);
+				for (auto const& scope : glCalls.scopes)
+				{
+					ImGui::Text("  %-28s %6llu calls %8.3f ms", scope.name, static_cast<unsigned long long>(scope.calls), scope.ms);
+				}
+				if (ImGui::TreeNode("By function"))
+				{
+					for (auto const& function : glCalls.functions)
+					{
+						ImGui::Text("%-28s %6llu calls %8.3f ms", function.name, static_cast<unsigned long long>(function.calls), function.ms);
+					}
+					ImGui::TreePop();
+				}
 			}
 
 			ImGui::End();
 		}
 
+		// Hot-reload shaders. The new program is compiled in the background and
+		// only replaces the current one once it has linked successfully. Each
+		// program is handled on its own, so that one that fails (e.g. a source
+		// caught half-saved) does not hold up the others.
+		if (shaderWatcher.poll())
+		{
+			auto const reload = [] (auto& aProgram) {
+				try
+				{
+					aProgram.reloadAsync();
+				}
+				catch (Error const& eErr)
+				{
+					std::fprintf(stderr, "Shader reload failed:\n%s\n", eErr.what());
+				}
+			};
+			reload(prog);
+			reload(oit);
+			reload(crowd);
+		}
+
+		{
+			bool reloaded = false;
+			auto const poll = [&reloaded] (auto& aProgram) {
+				try
+				{
+					if (aProgram.pollReload()) reloaded = true;
+				}
+				catch (Error const& eErr)
+				{
+					std::fprintf(stderr, "Shader reload failed, keeping previous program:\n%s\n", eErr.what());
+				}
+			};
+			poll(prog);
+			poll(oit);
+			poll(crowd);
+
+			// uniform values cached for a replaced program no longer apply
+			if (reloaded)
+			{
+				gl_state().forgetUniforms();
+				std::printf("Shaders reloaded\n");
+			}
+		}
+
 		Mat44f projection = make_perspective_projection(
 			60.f * kPi / 180.f,
 			fbwidth / float(fbheight),
 			0.1f, 100.f
 		);
 
-		Mat44f worldRotationX = make_rotation_x(state.camControl.theta);
-		Mat44f worldRotationY = make_rotation_y(state.camControl.phi);
-		Mat44f worldTranslation = make_translation(state.camControl.position);
+		Mat44f worldRotationX = make_rotation_x(snapshot->cameraTheta);
+		Mat44f worldRotationY = make_rotation_y(snapshot->cameraPhi);
+		Mat44f worldTranslation = make_translation(snapshot->cameraPosition);
 		Mat44f world2camera = worldRotationX * worldRotationY *  worldTranslation;
 
 		// define model to world transformations
-		// make sure to also save the transformation matrix to pass to the vertex shader
 		Mat44f projCameraWorld = projection * world2camera;
 		// boundary box
 		// floor
-		Mat44f projCameraWorldFloor = projection * world2camera * make_translation({ 0.f, 0.f, 0.f }) * make_scaling(20.f, 0.01f, 20.f);
 		Mat44f transformFloor = make_translation({ 0.f, 0.f, 0.f }) * make_scaling(20.f, 0.01f, 20.f);
 		// ceiling
-		Mat44f projCameraWorldCeiling = projection * world2camera * make_translation({ 0.f, 15.f, 0.f }) * make_scaling(20.f, 0.01f, 20.f);
 		Mat44f transformCeiling = make_translation({ 0.f, 15.f, 0.f }) * make_scaling(20.f, 0.01f, 20.f);
 		// north wall
-		Mat44f projCameraWorldNorth = projection * world2camera * make_translation({ 0.f, 7.5f, 20.f }) * make_scaling(20.f, 7.5f, 0.01f);
 		Mat44f transformNorth = make_translation({ 0.f, 7.5f, 20.f }) * make_scaling(20.f, 7.5f, 0.01f);
 		// south wall
-		Mat44f projCameraWorldSouth = projection * world2camera * make_translation({0.f, 7.5f, -20.f}) * make_scaling(20.f, 7.5f, 0.01f);
 		Mat44f transformSouth = make_translation({ 0.f, 7.5f, -20.f }) * make_scaling(20.f, 7.5f, 0.01f);
 		// west wall
-		Mat44f projCameraWorldWest = projection * world2camera * make_translation({20.f, 7.5f, 0.f}) * make_scaling(0.01f, 7.5f, 20.f);
 		Mat44f transformWest = make_translation({ 20.f, 7.5f, 0.f }) * make_scaling(0.01f, 7.5f, 20.f);
 		// east wall
-		Mat44f projCameraWorldEast = projection * world2camera * make_translation({-20.f, 7.5f, 0.f }) * make_scaling(0.01f, 7.5f, 20.f);
 		Mat44f transformEast = make_translation({ -20.f, 7.5f, 0.f }) * make_scaling(0.01f, 7.5f, 20.f);
 		// markus monument pieces
-		// markus
-		Mat44f projCameraWorldMarkus = projection * world2camera * make_translation({ -5.f, 0.21f, 0.f }) * make_scaling(0.4f, 0.025f, 0.4f);
-		Mat44f transformMarkus = make_translation({ -5.f, 0.21f, 0.f }) * make_scaling(0.4f, 0.025f, 0.4f);
-		// monument
-		Mat44f projCameraWorldMonument = projection * world2camera * make_translation({ -5.f, 0.1f, 0.f }) * make_scaling(0.5f, 0.1f, 0.5f);
-		Mat44f transformMonument = make_translation({ -5.f, 0.1f, 0.f }) * make_scaling(0.5f, 0.1f, 0.5f);
-		// glass box top
-		Mat44f projCameraWorldGlassTop = projection * world2camera * make_translation({ -5.f, 0.5f, 0.f }) * make_scaling(1.f, 0.01f, 1.f);
-		Mat44f transformGlassTop = make_translation({ -5.f, 0.5f, 0.f }) * make_scaling(1.f, 0.01f, 1.f);
-		// glass box north
-		Mat44f projCameraWorldGlassNorth = projection * world2camera * make_translation({ -5.f, 0.25f, 1.f }) * make_scaling(1.f, 0.25f, 0.01f);
-		Mat44f transformGlassNorth = make_translation({ -5.f, 0.25f, 1.f }) * make_scaling(1.f, 0.25f, 0.01f);
-		// glass box south
-		Mat44f projCameraWorldGlassSouth = projection * world2camera * make_translation({ -5.f, 0.25f, -1.f }) * make_scaling(1.f, 0.25f, 0.01f);
-		Mat44f transformGlassSouth = make_translation({ -5.f, 0.25f, -1.f }) * make_scaling(1.f, 0.25f, 0.01f);
-		// glass box west
-		Mat44f projCameraWorldGlassWest = projection * world2camera * make_translation({ -4.f, 0.25f, 0.f }) * make_scaling(0.01f, 0.25f, 1.f);
-		Mat44f transformGlassWest = projection * world2camera * make_translation({ -4.f, 0.25f, 0.f }) * make_scaling(0.01f, 0.25f, 1.f);
-		// glass box east
-		Mat44f projCameraWorldGlassEast = projection * world2camera * make_translation({ -6.f, 0.25f, 0.f }) * make_scaling(0.01f, 0.25f, 1.f);
-		Mat44f transformGlassEast = make_translation({ -6.f, 0.25f, 0.f }) * make_scaling(0.01f, 0.25f, 1.f);
-
-		
-
-		OGL_CHECKPOINT_DEBUG();
-		//####################### Draw frame #######################
-
-		// General draw frame settings
-		glEnable(GL_DEPTH_TEST);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-		//glPolygonMode(GL_FRONT_AND_BACK, GL_LINE); // wireframe mode
-
-		// Prepare to draw using simple meshes (armadillo)
-		glUseProgram(prog.programId());
-		glUniformMatrix4fv(
-			0, 1,
-			GL_TRUE, projCameraWorld.v
-		);
-
-		glUniform3fv(
-			4, 1,
-			&state.sceneLights[0].position.x
-		);
-		glUniform3fv(
-			5, 1,
-			&state.sceneLights[0].color.x
-		);
-		glUniform1fv(
-			6, 1, &state.sceneLights[0].brightness
-		);
-		glUniform3fv(
-			7, 1,
-			&state.sceneLights[1].position.x
-		);
-		glUniform3fv(
-			8, 1,
-			&state.sceneLights[1].color.x
-		);
-		glUniform1f(
-			9, state.sceneLights[1].brightness
-		);
-		glUniform3fv(
-			10, 1,
-			&state.sceneLights[2].position.x
-		);
-		glUniform3fv(
-			11, 1,
-			&state.sceneLights[2].color.x
-		);
-		glUniform1f(
-			12, state.sceneLights[2].brightness
-		);
-		
-		// move camera forwards slightly when passed to renderer to enhance specular lighting
-		Vec3f camPos = state.camControl.position + cam_forwards(&state.camControl) * 3.0f;
-
-		glUniform3f(
-			2,
-			camPos.x,
-			camPos.y,
-			camPos.z
-		);
+		sceneNodes.update();
+		Mat44f const& transformMarkus = sceneNodes.getWorld(markusNode);
+		Mat44f const& transformMonument = sceneNodes.getWorld(monumentNode);
+		Mat44f const& transformGlassTop = sceneNodes.getWorld(glassTopNode);
+		Mat44f const& transformGlassNorth = sceneNodes.getWorld(glassNorthNode);
+		Mat44f const& transformGlassSouth = sceneNodes.getWorld(glassSouthNode);
+		Mat44f const& transformGlassWest = sceneNodes.getWorld(glassWestNode);
+		Mat44f const& transformGlassEast = sceneNodes.getWorld(glassEastNode);
 
 		Mat44f standardMaterialProps = {
 			0.8f, 0.8f, 0.8f, 0.f, // kA
@@ -975,343 +1265,285 @@ int main() try
 			1.f, 1.f, 1.f, 0.f // kE
 		};
 
-		glUniformMatrix4fv(
-			3, 1,
-			GL_FALSE, standardMaterialProps.v
-		);
+		Vec3f const camPos = snapshot->lightingCameraPosition;
+		pointLight const* sceneLights = snapshot->lights;
 
-		// draw f1 car
-		drawComplexObject(&f1carObj, projCameraWorld);
+		//####################### Collect draws #######################
+		// The camera position stored in camControl is the world translation,
+		// i.e. the negated eye position.
+		renderQueue.setTransparencyMode(state.transparencyMode);
+		renderQueue.begin(-snapshot->cameraPosition, 100.f);
 
-		// draw a SceneObj f1 car
-		if (!state.animationPause) {
-			f1Obj.updatePath(state.animationFactor);
-		}
-		f1Obj.draw(projCameraWorld);
+		GLuint const programId = prog.programId();
+		GLuint const sceneTextureArray = sceneTextures.textureId();
 
-		if (!state.animationPause) {
-			arm2Obj.updateAnimation(state.animationFactor);
-		}
-		arm2Obj.draw(projCameraWorld);
+		// f1 cars
+		submitComplexObject(&f1carObj, renderQueue, programId, sceneTextureArray, standardMaterialProps, ironTexture);
 
+		// animated objects are placed with the simulated transforms
+		f1Obj.submit(renderQueue, programId, snapshot->f1Model);
+		arm2Obj.submit(renderQueue, programId, snapshot->arm2Model);
+		muscleCarObj.submit(renderQueue, programId, snapshot->muscleCarModel);
 
-		if (!state.animationPause) {
-			muscleCarObj.updateAnimation(state.animationFactor);
+		for (SceneObj* car : streamedCars)
+		{
+			car->submit(renderQueue, programId);
 		}
-		muscleCarObj.draw(projCameraWorld);
-
-		glUniformMatrix4fv(
-			3, 1,
-			GL_FALSE, armadilloMaterialProps.v
-		);
 
-		// define terms for the armadillo
-		Vec3f pos1 = { 0.f, 0.f, 0.f };
-		Vec3f pos2 = { 4.f, 0.f, 0.f };
+		// scans stand in a row along the west wall, scaled to 2 units high
+		{
+			float scanX = -8.f;
+			for (auto const& scan : scans)
+			{
+				if (!scan.mesh.ready()) continue;
+
+				Vec3f const low = scan.mesh.minimum(), high = scan.mesh.maximum();
+				float const size = 2.f / std::max(high.y - low.y, 1e-6f);
+				Mat44f const model = make_translation({ scanX, 0.f, 8.f })
+					* make_scaling(size, size, size)
+					* make_translation({ -0.5f * (low.x + high.x), -low.y, -0.5f * (low.z + high.z) });
+				scan.mesh.submit(renderQueue, programId, sceneTextureArray, ironTexture, model, armadilloMaterialProps);
+				scanX += 3.f;
+			}
+		}
 
 		// adjust the armadillo's rotation, then draw it
-		armadilloObj.position = pos2;
-		if (!state.animationPause) {
-			armadilloObj.rotation.y += dt * state.animationFactor;
-			armadilloObj.rotation.y = armadilloObj.rotation.y > 2 * kPi ? 0 : armadilloObj.rotation.y;
+		armadilloObj.position = { 4.f, 0.f, 0.f };
+		armadilloObj.rotation.y = std::fmod(snapshot->animationTime, 2 * kPi);
+		submitObject(&armadilloObj, renderQueue, programId, sceneTextureArray, armadilloMaterialProps, ironTexture);
+
+		// streetlamps and other static scenery
+		Frustum const viewFrustum = make_frustum(projCameraWorld);
+		sceneEntities.cull(viewFrustum);
+		sceneEntities.submit(renderQueue, programId);
+
+		// unit cube with the standard material, for the stress tests below
+		DrawItem testCube;
+		testCube.vertexArray = complexObjectVAO;
+		testCube.texture = sceneTextureArray;
+		testCube.textureLayer = ironTexture;
+		testCube.count = 36;
+		testCube.material = standardMaterialProps;
+
+		if (state.benchEntities > 0)
+		{
+			if (entityBench.size() != size_t(state.benchEntities))
+			{
+				entityBench.build(size_t(state.benchEntities), testCube);
+			}
+			entityBenchStats = entityBench.run(state.benchUseStore, snapshot->animationTime, viewFrustum, renderQueue, programId);
 		}
-		drawObject(&armadilloObj, projCameraWorld);
-
-		glUniformMatrix4fv(
-			3, 1,
-			GL_FALSE, standardMaterialProps.v
-		);
-
-		// define positions for the streetlamps
-		Vec3f streetlampPos1 = { -5.f, 0.f, -5.f };	// SE
-		Vec3f streetlampPos2 = { 5.f, 0.f, -5.f };	// SW
-		Vec3f streetlampPos3 = { 0.f, 0.f, 5.f };	// N
-
-		// draw streetlamps
-		// bind iron
-		glBindTexture(GL_TEXTURE_2D, ironTexture);
-		streetlampObj.move(streetlampPos1);
-		streetlampObj.scale({ 0.25f, 0.25f, 0.25f });
-		streetlampObj.rotate({ 0.f, kPi * 3 / 4, 0.f });
-		streetlampObj.draw(projCameraWorld);
-
-		streetlampObj.move(streetlampPos2);
-		streetlampObj.rotate({ 0.f, kPi / 4, 0.f });
-		streetlampObj.draw(projCameraWorld);
-
-		streetlampObj.move(streetlampPos3);
-		streetlampObj.rotate({ 0.f, -kPi / 2, 0.f });
-		streetlampObj.draw(projCameraWorld);
-
-		// draw the box around the scene
-		// draw floor
-		// bind cobblestonefloor
-		glBindTexture(GL_TEXTURE_2D, cobblestoneFloor);
-
-		glUniformMatrix4fv(
-			0, 1,
-			GL_TRUE, projCameraWorldFloor.v
-		);
-		glUniformMatrix4fv(
-			1, 1,
-			GL_TRUE, transformFloor.v
-		);
-
-		glBindVertexArray(complexObjectVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
-
-		// draw ceiling
-		// bind nightSky
-		glBindTexture(GL_TEXTURE_2D, nightSkyTexture);
-
-		glUniformMatrix4fv(
-			0, 1,
-			GL_TRUE, projCameraWorldCeiling.v
-		); 
-		glUniformMatrix4fv(
-			1, 1,
-			GL_TRUE, transformCeiling.v
-		);
-
-		glBindVertexArray(complexObjectVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
-
-		// draw north wall
-		// bind northCity
-		glBindTexture(GL_TEXTURE_2D, northCityTexture);
-		glUniformMatrix4fv(
-			0, 1,
-			GL_TRUE, projCameraWorldNorth.v
-		);
-		glUniformMatrix4fv(
-			1, 1,
-			GL_TRUE, transformNorth.v
-		);
-
-		glBindVertexArray(complexObjectVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
-
-		// draw south wall
-		// bind southCity
-		glBindTexture(GL_TEXTURE_2D, southCityTexture);
-		glUniformMatrix4fv(
-			0, 1,
-			GL_TRUE, projCameraWorldSouth.v
-		);
-		glUniformMatrix4fv(
-			1, 1,
-			GL_TRUE, transformSouth.v
-		);
-
-		glBindVertexArray(complexObjectVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
-
-		// draw west wall
-		// bind westCity
-		glBindTexture(GL_TEXTURE_2D, westCityTexture);
-		glUniformMatrix4fv(
-			0, 1,
-			GL_TRUE, projCameraWorldWest.v
-		);
-		glUniformMatrix4fv(
-			1, 1,
-			GL_TRUE, transformWest.v
-		);
-
-		glBindVertexArray(complexObjectVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
-
-
-		// draw east wall
-		// bind eastCity
-		glBindTexture(GL_TEXTURE_2D, eastCityTexture);
-		glUniformMatrix4fv(
-			0, 1,
-			GL_TRUE, projCameraWorldEast.v
-		);
-		glUniformMatrix4fv(
-			1, 1,
-			GL_TRUE, transformEast.v
-		);
-
-		glBindVertexArray(complexObjectVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
-
-		// draw the monument to Markus
-		// iron monument base
-		glBindTexture(GL_TEXTURE_2D, ironTexture);
-		glUniformMatrix4fv(
-			0, 1,
-			GL_TRUE, projCameraWorldMonument.v
-		);
-		glUniformMatrix4fv(
-			1, 1,
-			GL_TRUE, transformMonument.v
-		);
-
-		glBindVertexArray(complexObjectVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
 
-		// markus plaque
-		glBindTexture(GL_TEXTURE_2D, markusTexture);
-		glUniformMatrix4fv(
-			0, 1,
-			GL_TRUE, projCameraWorldMarkus.v
-		);
-		glUniformMatrix4fv(
-			1, 1,
-			GL_TRUE, transformMarkus.v
-		);
-
-		glBindVertexArray(complexObjectVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
-
-		// last things to be drawn should be our transparent objects
-		// draw glass top
-		// bind glass
-		glBindTexture(GL_TEXTURE_2D, windowTexture);
-		glUniformMatrix4fv(
-			0, 1,
-			GL_TRUE, projCameraWorldGlassTop.v
-		);
-		glUniformMatrix4fv(
-			1, 1,
-			GL_TRUE, transformGlassTop.v
-		);
-
-		glBindVertexArray(complexObjectVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
+		if (state.fleetVehicles > 0)
+		{
+			if (fleet.size() != size_t(state.fleetVehicles))
+			{
+				fleet.build(size_t(state.fleetVehicles), markusTexture, ironTexture);
+			}
+			testCube.program = programId;
+			fleetStats = fleet.run(snapshot->animationTime, state.parallelHierarchy ? &recordPool : nullptr, viewFrustum, renderQueue, testCube);
+		}
 
-		// draw glass north
-		glUniformMatrix4fv(
-			0, 1,
-			GL_TRUE, projCameraWorldGlassNorth.v
-		);
-		glUniformMatrix4fv(
-			1, 1,
-			GL_TRUE, transformGlassNorth.v
-		);
-		glBindVertexArray(complexObjectVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
+		// the box around the scene and the monument to Markus are all cubes
+		auto submitCube = [&] (GLint aTextureLayer, Mat44f const& aModel, bool aTranslucent) {
+			DrawItem item;
+			item.translucent = aTranslucent;
+			item.program = programId;
+			item.vertexArray = complexObjectVAO;
+			item.texture = sceneTextureArray;
+			item.textureLayer = aTextureLayer;
+			item.count = 36;
+			item.model = aModel;
+			item.material = standardMaterialProps;
+			renderQueue.submit(item);
+		};
 
-		// draw glass south
-		glUniformMatrix4fv(
-			0, 1,
-			GL_TRUE, projCameraWorldGlassSouth.v
-		);
-		glUniformMatrix4fv(
-			1, 1,
-			GL_TRUE, transformGlassSouth.v
-		);
+		submitCube(cobblestoneFloor, transformFloor, false);
+		submitCube(nightSkyTexture, transformCeiling, false);
+		submitCube(northCityTexture, transformNorth, false);
+		submitCube(southCityTexture, transformSouth, false);
+		submitCube(westCityTexture, transformWest, false);
+		submitCube(eastCityTexture, transformEast, false);
+
+		submitCube(ironTexture, transformMonument, false);
+		submitCube(markusTexture, transformMarkus, false);
+
+		// glass box around the monument; sorted back-to-front by the queue
+		submitCube(windowTexture, transformGlassTop, true);
+		submitCube(windowTexture, transformGlassNorth, true);
+		submitCube(windowTexture, transformGlassSouth, true);
+		submitCube(windowTexture, transformGlassEast, true);
+		submitCube(windowTexture, transformGlassWest, true);
+
+		// stress test for transparency: a spiral of overlapping panes around
+		// the monument
+		for (int i = 0; i < state.extraGlassPanes; i++)
+		{
+			float const angle = float(i) * 0.25f;
+			float const radius = 1.5f + 0.01f * float(i);
+			Mat44f const transformPane = make_translation({ -5.f + radius * std::cos(angle), 1.f + 0.002f * float(i), radius * std::sin(angle) })
+				* make_rotation_y(-angle)
+				* make_scaling(0.01f, 0.75f, 0.75f);
+			submitCube(windowTexture, transformPane, true);
+		}
 
-		glBindVertexArray(complexObjectVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
+		// 3 globes of different materials (SE, SW, N)
+		globeObj.scaling = { 0.5f, 0.5f, 0.5f };
 
-		// draw glass east
-		glUniformMatrix4fv(
-			0, 1,
-			GL_TRUE, projCameraWorldGlassEast.v
-		);
-		glUniformMatrix4fv(
-			1, 1,
-			GL_TRUE, transformGlassSouth.v
-		);
+		globeObj.position = { -1.f, 2.f, 4.f };
+		submitObject(&globeObj, renderQueue, programId, sceneTextureArray, diffuseMaterialProps, ironTexture);
 
-		glBindVertexArray(complexObjectVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
+		globeObj.position = { 1.f, 2.f, 4.f };
+		submitObject(&globeObj, renderQueue, programId, sceneTextureArray, specularMaterialProps, ironTexture);
 
-		// draw glass west
-		glUniformMatrix4fv(
-			0, 1,
-			GL_TRUE, projCameraWorldGlassWest.v
-		);
-		glUniformMatrix4fv(
-			1, 1,
-			GL_TRUE, transformGlassWest.v
-		);
+		globeObj.position = { 0.f, 2.f, 6.f };
+		submitObject(&globeObj, renderQueue, programId, sceneTextureArray, emissiveMaterialProps, ironTexture);
 
-		glBindVertexArray(complexObjectVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
+		// light bulbs glow in the colour of their light
+		for (size_t i = 0; i < kLightCount; i++)
+		{
+			lightMaterialProps.v[12] = sceneLights[i].color.x;
+			lightMaterialProps.v[13] = sceneLights[i].color.y;
+			lightMaterialProps.v[14] = sceneLights[i].color.z;
 
-		// reset texture state (using iron texture as a reset)
+			bulbObj.position = sceneLights[i].position;
+			submitObject(&bulbObj, renderQueue, programId, sceneTextureArray, lightMaterialProps, ironTexture);
+		}
 
-		// set positions for 3 globes of different materials
-		Vec3f globePos1 = { -1.f, 2.f, 4.f };	// SE
-		Vec3f globePos2 = { 1.f, 2.f, 4.f };	// SW
-		Vec3f globePos3 = { 0.f, 2.f, 6.f };	// N
+		// field of small props on the floor: culling, matrix and key building
+		// and uniform packing all happen on the workers
+		propsRecorded = 0;
+		propListsUsed = 0;
+		if (state.extraProps > 0)
+		{
+			auto const recordStart = Clock::now();
+
+			Frustum const frustum = make_frustum(projCameraWorld);
+			SortKeyContext const keyContext = renderQueue.keyContext();
+			GLint const propLayers[] = { ironTexture, markusTexture, cobblestoneFloor };
+			int const propsPerRow = int(std::ceil(std::sqrt(float(state.extraProps))));
+			float const spacing = 36.f / float(propsPerRow);
+
+			auto recordProps = [&] (size_t aWorker, size_t aBegin, size_t aEnd) {
+				CommandList& list = propLists[aWorker];
+				list.begin(keyContext);
+
+				DrawItem item;
+				item.program = programId;
+				item.vertexArray = complexObjectVAO;
+				item.texture = sceneTextureArray;
+				item.count = 36;
+				item.material = standardMaterialProps;
+
+				for (size_t i = aBegin; i < aEnd; i++)
+				{
+					float const size = 0.05f + 0.05f * float(i % 3);
+					Vec3f const position = {
+						-18.f + spacing * float(int(i) % propsPerRow),
+						size,
+						-18.f + spacing * float(int(i) / propsPerRow)
+					};
+					// bounding sphere of the cube
+					if (!sphere_in_frustum(frustum, position, 1.74f * size)) continue;
+
+					item.textureLayer = propLayers[i % 3];
+					item.model = make_translation(position) * make_rotation_y(float(i)) * make_scaling(size, size, size);
+					list.record(item);
+				}
+			};
 
-		// draw globes
-		// bind iron
-		glBindTexture(GL_TEXTURE_2D, ironTexture);
-		globeObj.scaling = { 0.5f, 0.5f, 0.5f };
+			if (state.parallelRecording)
+			{
+				recordPool.parallelFor(size_t(state.extraProps), recordProps);
+				propListsUsed = recordPool.workerCount();
+			}
+			else
+			{
+				recordProps(0, 0, size_t(state.extraProps));
+				propListsUsed = 1;
+			}
 
-		globeObj.position = globePos1;
-		// setting material properties
-		glUniformMatrix4fv(
-			3, 1,
-			GL_FALSE, diffuseMaterialProps.v
-		);
-		drawObject(&globeObj, projCameraWorld);
+			for (size_t i = 0; i < propListsUsed; i++)
+			{
+				renderQueue.merge(propLists[i]);
+				propsRecorded += propLists[i].size();
+			}
 
-		globeObj.position = globePos2;
-		// setting material properties
-		glUniformMatrix4fv(
-			3, 1,
-			GL_FALSE, specularMaterialProps.v
-		);
-		drawObject(&globeObj, projCameraWorld);
+			propRecordMs = std::chrono::duration<float, std::milli>(Clock::now() - recordStart).count();
+		}
 
+		renderQueue.sort();
 
-		globeObj.position = globePos3;
-		// setting material properties
-		glUniformMatrix4fv(
-			3, 1,
-			GL_FALSE, emissiveMaterialProps.v
-		);
-		drawObject(&globeObj, projCameraWorld);
+		OGL_CHECKPOINT_DEBUG();
+		//####################### Draw frame #######################
 
-		lightMaterialProps.v[12] = state.sceneLights[0].color.x;
-		lightMaterialProps.v[13] = state.sceneLights[0].color.y;
-		lightMaterialProps.v[14] = state.sceneLights[0].color.z;
+		// General draw frame settings
+		gl_state().enable(GL_DEPTH_TEST);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		//glPolygonMode(GL_FRONT_AND_BACK, GL_LINE); // wireframe mode
 
-		// seetting material properties
-		glUniformMatrix4fv(
-			3, 1,
-			GL_FALSE, lightMaterialProps.v
-		);
+		// per-frame uniforms, shared by the scene and the OIT accumulation shaders
+		auto uploadFrameUniforms = [&] (GLuint aProgram) {
+			gl_state().useProgram(aProgram);
+
+			gl_state().uniform3fv(4, &sceneLights[0].position.x);
+			gl_state().uniform3fv(5, &sceneLights[0].color.x);
+			gl_state().uniform1f(6, sceneLights[0].brightness);
+			gl_state().uniform3fv(7, &sceneLights[1].position.x);
+			gl_state().uniform3fv(8, &sceneLights[1].color.x);
+			gl_state().uniform1f(9, sceneLights[1].brightness);
+			gl_state().uniform3fv(10, &sceneLights[2].position.x);
+			gl_state().uniform3fv(11, &sceneLights[2].color.x);
+			gl_state().uniform1f(12, sceneLights[2].brightness);
+
+			gl_state().uniform3fv(2, &camPos.x);
+		};
 
-		bulbObj.position = state.sceneLights[0].position;
-		drawObject(&bulbObj, projCameraWorld);
+		{
+			GL_PROFILE_SCOPE("opaque");
+			uploadFrameUniforms(programId);
+			renderQueue.flushOpaque(projCameraWorld);
+		}
 
-		lightMaterialProps.v[12] = state.sceneLights[1].color.x;
-		lightMaterialProps.v[13] = state.sceneLights[1].color.y;
-		lightMaterialProps.v[14] = state.sceneLights[1].color.z;
+		if (crowdBuilt != state.crowdSize)
+		{
+			crowd.setInstanceCount(size_t(state.crowdSize), 6.f);
+			crowdBuilt = state.crowdSize;
+		}
 
-		// seetting material properties
-		glUniformMatrix4fv(
-			3, 1,
-			GL_FALSE, lightMaterialProps.v
-		);
+		if (crowd.size() > 0)
+		{
+			GL_PROFILE_SCOPE("crowd");
+			auto const crowdStart = Clock::now();
 
-		bulbObj.position = state.sceneLights[1].position;
-		drawObject(&bulbObj, projCameraWorld);
+			if (state.crowdOnGpu) crowd.updateOnGpu(snapshot->animationTime);
+			else crowd.updateOnCpu(snapshot->animationTime);
 
-		lightMaterialProps.v[12] = state.sceneLights[2].color.x;
-		lightMaterialProps.v[13] = state.sceneLights[2].color.y;
-		lightMaterialProps.v[14] = state.sceneLights[2].color.z;
+			uploadFrameUniforms(crowd.drawProgramId());
+			crowd.draw(f1Obj, projCameraWorld);
 
-		// seetting material properties
-		glUniformMatrix4fv(
-			3, 1,
-			GL_FALSE, lightMaterialProps.v
-		);
+			crowdCpuMs = std::chrono::duration<float, std::milli>(Clock::now() - crowdStart).count();
+		}
 
-		bulbObj.position = state.sceneLights[2].position;
-		drawObject(&bulbObj, projCameraWorld);
+		if (state.transparencyMode == TRANSPARENCY_WEIGHTED_BLENDED)
+		{
+			GL_PROFILE_SCOPE("translucent");
+			oit.resize(GLsizei(fbwidth), GLsizei(fbheight));
+			oit.beginAccumulation();
+			uploadFrameUniforms(oit.accumulateProgramId());
+			renderQueue.flushTranslucent(projCameraWorld, oit.accumulateProgramId());
+			oit.endAccumulation();
+			oit.composite();
+		}
+		else
+		{
+			GL_PROFILE_SCOPE("translucent");
+			renderQueue.flushTranslucent(projCameraWorld);
+		}
 
 		// Reset state
-		glBindVertexArray(0);
-		glUseProgram(0);
+		gl_state().bindVertexArray(0);
+		gl_state().useProgram(0);
 		// End of drawing using simple meshes
 
 		OGL_CHECKPOINT_DEBUG();
@@ -1319,14 +1551,74 @@ int main() try
 		ImGui::Render();
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
+		frameTimer.end();
+
+		// frames after the warm-up are measured by a benchmark run
+		BenchmarkFrame* benchFrame = nullptr;
+		std::uint64_t const firstBenchFrame = std::uint64_t(benchOptions.warmupFrames);
+		if (benchOptions.enabled && frameNumber >= firstBenchFrame)
+		{
+			auto const& queueStats = renderQueue.lastStats();
+			benchFrame = &benchReport.add();
+			benchFrame->simulationMs = snapshot->simulationMs;
+			benchFrame->draws = queueStats.draws;
+			benchFrame->programChanges = queueStats.programChanges;
+			benchFrame->vertexArrayChanges = queueStats.vertexArrayChanges;
+			benchFrame->textureChanges = queueStats.textureChanges;
+			benchFrame->stateCallsIssued = gl_state().frameCounters().totalIssued();
+		}
+
+		{
+			// smoothed, so that the threaded and serial modes can be compared
+			float const frameMs = std::chrono::duration<float, std::milli>(Clock::now() - now).count();
+			cpuFrameMs += 0.05f * (frameMs - cpuFrameMs);
+			if (benchFrame) benchFrame->cpuMs = frameMs;
+		}
+
 		glfwSwapBuffers( window );
 
+		// messages from the asynchronous debug output (profiling builds)
+		drain_gl_debug_output();
+		gl_call_profiler().endFrame();
+
+		if (benchFrame)
+		{
+			benchFrame->frameMs = std::chrono::duration<float, std::milli>(Clock::now() - now).count();
+		}
+
+		// GPU times arrive a few frames late
+		bool const replayDone = inputReplay && frameNumber + 1 >= inputReplay->frameCount();
+		bool const benchDone = benchOptions.enabled && (benchReport.size() == size_t(benchOptions.frames) || replayDone);
+		std::uint64_t timedFrame;
+		float timedMs;
+		while (frameTimer.collect(timedFrame, timedMs, benchDone))
+		{
+			gpuFrameMs += 0.05f * (timedMs - gpuFrameMs);
+			if (benchOptions.enabled && timedFrame >= firstBenchFrame && timedFrame - firstBenchFrame < benchReport.size())
+			{
+				benchReport.frame(size_t(timedFrame - firstBenchFrame)).gpuMs = timedMs;
+			}
+		}
+		frameNumber++;
+
+		if (benchDone)
+		{
+			benchReport.writeJson(benchOptions.output.c_str(), benchOptions, timeStep,
+				reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+			std::printf("Benchmark: %zu frames written to %s\n", benchReport.size(), benchOptions.output.c_str());
+			glfwSetWindowShouldClose(window, GLFW_TRUE);
+		}
+		if (replayDone)
+		{
+			glfwSetWindowShouldClose(window, GLFW_TRUE);
+		}
+
 		if (state.screenshotQueued)
 		{
 			auto epoch = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch());
 			std::string filepath = "screenshots/" + std::to_string(epoch.count()) + ".png";
 			ScreenshotData ssData = getScreenshotData(window);
-			std::thread t([ssData, filepath]{saveScreenshot(ssData, filepath);});
+			std::thread t([ssData = std::move(ssData), filepath = std::move(filepath)]{saveScreenshot(ssData, filepath);});
 			t.detach();
 			state.screenshotQueued = false;
 		}
@@ -1335,6 +1627,22 @@ int main() try
 	//####################### Cleanup (on exit) #######################
 	//TODO: additional cleanup
 
+	report_gl_debug_output();
+
+	if (gl_call_profiler().installed())
+	{
+		gl_call_profiler().writeJson(benchOptions.glCallsOutput.c_str());
+		std::printf("GL calls written to %s\n", benchOptions.glCallsOutput.c_str());
+	}
+
+	// a replay of a recording ends in the same state as the recording did
+	if (inputRecorder || inputReplay)
+	{
+		if (inputRecorder) inputRecorder->finish();
+		std::printf("Input %s: %llu frames, final state %016llx\n", inputRecorder ? "recording" : "replay",
+			static_cast<unsigned long long>(frameNumber), static_cast<unsigned long long>(state_digest_(serialSnapshot)));
+	}
+
 	glDeleteBuffers(1, &complexObjectPositionVBO);
 	glDeleteBuffers(1, &complexObjectColorVBO);
 
@@ -1357,6 +1665,35 @@ namespace
 	}
 
 	void glfw_callback_key_( GLFWwindow* aWindow, int aKey, int, int aAction, int )
+	{
+		if( auto* state = static_cast<State_*>(glfwGetWindowUserPointer( aWindow )) )
+		{
+			// live input is ignored during a replay, except for quitting
+			if( state->inputReplaying && GLFW_KEY_ESCAPE != aKey )
+				return;
+
+			if( state->inputRecorder )
+				state->inputRecorder->key( aKey, aAction );
+		}
+
+		handle_key_( aWindow, aKey, aAction );
+	}
+
+	void glfw_callback_motion_( GLFWwindow* aWindow, double aX, double aY )
+	{
+		if( auto* state = static_cast<State_*>(glfwGetWindowUserPointer( aWindow )) )
+		{
+			if( state->inputReplaying )
+				return;
+
+			if( state->inputRecorder )
+				state->inputRecorder->cursor( aX, aY );
+		}
+
+		handle_motion_( aWindow, aX, aY );
+	}
+
+	void handle_key_( GLFWwindow* aWindow, int aKey, int aAction )
 	{
 		// Check if window should close
 		if( GLFW_KEY_ESCAPE == aKey && GLFW_PRESS == aAction )
@@ -1529,7 +1866,7 @@ namespace
 		
 	}
 
-	void glfw_callback_motion_( GLFWwindow* aWindow, double aX, double aY )
+	void handle_motion_( GLFWwindow* aWindow, double aX, double aY )
 	{
 		if( auto* state = static_cast<State_*>(glfwGetWindowUserPointer( aWindow )) )
 		{
@@ -1555,6 +1892,113 @@ namespace
 			cam_handle_mouse(&state->camControl, kMouseSensitivity, aX, aY);
 		}
 	}
+
+	// FNV-1a over the camera and the animated transforms, to compare the
+	// end of a replay with the end of its recording
+	std::uint64_t state_digest_( FrameSnapshot const& aSnapshot )
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+		auto const add = [&hash] (void const* aData, size_t aSize) {
+			auto const* bytes = static_cast<unsigned char const*>(aData);
+			for (size_t i = 0; i < aSize; i++)
+			{
+				hash = (hash ^ bytes[i]) * 1099511628211ull;
+			}
+		};
+
+		add(&aSnapshot.cameraPosition, sizeof(aSnapshot.cameraPosition));
+		add(&aSnapshot.cameraTheta, sizeof(aSnapshot.cameraTheta));
+		add(&aSnapshot.cameraPhi, sizeof(aSnapshot.cameraPhi));
+		add(&aSnapshot.animationTime, sizeof(aSnapshot.animationTime));
+		add(&aSnapshot.f1Model, sizeof(aSnapshot.f1Model));
+		add(&aSnapshot.arm2Model, sizeof(aSnapshot.arm2Model));
+		add(&aSnapshot.muscleCarModel, sizeof(aSnapshot.muscleCarModel));
+		return hash;
+	}
+
+	std::vector<Vec3f> stress_track_points_()
+	{
+		// a wavy oval around the scene through a couple of thousand points
+		constexpr int kTrackPoints = 2048;
+		std::vector<Vec3f> points;
+		points.reserve(kTrackPoints);
+		for (int i = 0; i < kTrackPoints; i++)
+		{
+			float const angle = 2.f * kPi * float(i) / float(kTrackPoints);
+			float const wobble = 1.f + 0.08f * std::sin(5.f * angle);
+			points.push_back({14.f * wobble * std::cos(angle), 0.f, 10.f * wobble * std::sin(angle)});
+		}
+		return points;
+	}
+
+	void build_f1_track_( PathObj& aF1, bool aStressTrack )
+	{
+		aF1.clearPathPoints();
+
+		if (aStressTrack)
+		{
+			// at constant speed along a spline, facing along it
+			for (Vec3f const& position : stress_track_points_())
+			{
+				aF1.addPathPoint({ {0.f, 0.f, 0.f}, position, {1.f, 1.f, 1.f} });
+			}
+			aF1.setupSpline(6.f);
+			return;
+		}
+
+		float r = 0.5f * kPi;
+
+		aF1.addPathPoint({
+			{0.f, r, 0.f},
+			{-10.f, 0.f, 6.f},
+			{1.f, 1.f, 1.f},
+			200, S_CURVE
+		});
+
+		aF1.addPathPoint({
+			{0.f, r, 0.f},
+			{10.f, 0.f, 6.f},
+			{1.f, 1.f, 1.f},
+			100, SINUSOIDAL
+		});
+
+		aF1.addPathPoint({
+			{0.f, r * 1.5f, 0.f},
+			{12.f, 0.f, 4.f},
+			{1.f, 1.f, 1.f},
+			100, SINUSOIDAL
+		});
+
+		aF1.addPathPoint({
+			{0.f, r * 2.f, 0.f},
+			{10.f, 0.f, 6.f},
+			{1.f, 1.f, 1.f},
+			100, SINUSOIDAL
+		});
+
+		aF1.addPathPoint({
+			{0.f, r * 2.5f, 0.f},
+			{12.f, 0.f, 8.f},
+			{1.f, 1.f, 1.f},
+			100, SINUSOIDAL
+		});
+
+		aF1.addPathPoint({
+			{0.f, r * 3.f, 0.f},
+			{10.f, 0.f, 6.f},
+			{1.f, 1.f, 1.f},
+			100, SINUSOIDAL
+		});
+
+		aF1.addPathPoint({
+			{0.f, r * 3.f, 0.f},
+			{-10.f, 0.f, 6.f},
+			{1.f, 1.f, 1.f},
+			200, S_CURVE
+		});
+
+		aF1.setupPath();
+	}
 }
 
 namespace
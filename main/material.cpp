@@ -5,6 +5,8 @@
 
 #include "../vmlib/mat44.hpp"
 
+#include "gl_state.hpp"
+
 void Material::setAmbient(Vec3f aAmbient)
 {
 	kA = aAmbient;
@@ -28,7 +30,16 @@ void Material::setEmissive(Vec3f aEmissive)
 void Material::setTexture(std::string aPath)
 {
 	textureLoaded = false;
-	textureFilepath = aPath;
+	textureLayer = -1;
+	textureFilepath = std::move(aPath);
+}
+
+void Material::setTextureLayer(GLuint aTextureArray, GLint aLayer)
+{
+	textureFilepath.clear();
+	textureId = aTextureArray;
+	textureLayer = aLayer;
+	textureLoaded = true;
 }
 
 int Material::loadTexture()
@@ -85,19 +96,32 @@ int Material::loadTexture()
 	return 0;
 }
 
-void Material::useMaterial()
+Mat44f Material::packed() const
 {
-	Mat44f materialPacked = {
+	return {
 			kA.x, kA.y, kA.z, 0.f,
 			kD.x, kD.y, kD.z, 0.f,  
 			kS.x, kS.y, kS.z, 0.f,
 			kE.x, kE.y, kE.z, 4.f
 	};
+}
 
-	glBindTexture(GL_TEXTURE_2D, textureId);
+void Material::useMaterial()
+{
+	Mat44f materialPacked = packed();
+
+	if (textureLayer < 0)
+	{
+		gl_state().bindTexture(0, GL_TEXTURE_2D, textureId);
+	}
+	else
+	{
+		gl_state().bindTexture(1, GL_TEXTURE_2D_ARRAY, textureId);
+	}
+	gl_state().uniform1i(13, textureLayer);
 
-	glUniformMatrix4fv(
-		3, 1,
+	gl_state().uniformMatrix4fv(
+		3,
 		GL_FALSE, materialPacked.v
 	);
 }
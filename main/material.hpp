@@ -6,6 +6,7 @@
 #include <glad.h>
 #include "../vmlib/vec3.hpp"
 #include "../vmlib/vec2.hpp"
+#include "../vmlib/mat44.hpp"
 
 class Material
 {
@@ -16,6 +17,8 @@ class Material
 
 	std::string textureFilepath;
 	GLuint textureId = 0;
+	// layer of textureId if it is a texture array, -1 for a plain 2D texture
+	GLint textureLayer = -1;
 	bool textureLoaded = false;
 
 public:
@@ -24,9 +27,16 @@ public:
 	void setSpecular(Vec3f aSpecular);
 	void setEmissive(Vec3f aEmissive);
 	void setTexture(std::string aPath);
+	// use a layer of an already built texture array instead of a texture file
+	void setTextureLayer(GLuint aTextureArray, GLint aLayer);
 
 	int loadTexture();
 	void useMaterial();
+
+	// material properties in the layout expected by the shaders (uMaterialData)
+	Mat44f packed() const;
+	GLuint texture() const {return textureId;}
+	GLint layer() const {return textureLayer;}
 };
 
 
@@ -0,0 +1,123 @@
+#include "memory_arena.hpp"
+
+#include <mutex>
+#include <algorithm>
+
+namespace
+{
+	std::mutex& arena_registry_mutex_()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	std::vector<const ArenaResource*>& arena_registry_()
+	{
+		static std::vector<const ArenaResource*> arenas;
+		return arenas;
+	}
+}
+
+void* LinearArena::allocate(size_t aSize, size_t aAlignment)
+{
+	while (currentBlock < blocks.size())
+	{
+		auto& block = blocks[currentBlock];
+		auto const base = reinterpret_cast<std::uintptr_t>(block.data.get());
+		size_t const aligned = ((base + offset + aAlignment - 1) & ~std::uintptr_t(aAlignment - 1)) - base;
+
+		if (aligned + aSize <= block.size)
+		{
+			offset = aligned + aSize;
+			used += aSize;
+			return block.data.get() + aligned;
+		}
+
+		currentBlock++;
+		offset = 0;
+	}
+
+	// out of blocks; oversized requests get a block of their own
+	size_t const size = std::max(kBlockSize, aSize + aAlignment);
+	blocks.push_back({ std::make_unique<std::byte[]>(size), size });
+	currentBlock = blocks.size() - 1;
+	offset = 0;
+
+	return allocate(aSize, aAlignment);
+}
+
+void LinearArena::reset()
+{
+	highWater = std::max(highWater, used);
+	resets++;
+
+	currentBlock = 0;
+	offset = 0;
+	used = 0;
+}
+
+size_t LinearArena::bytesReserved() const
+{
+	size_t total = 0;
+	for (auto const& block : blocks)
+	{
+		total += block.size;
+	}
+	return total;
+}
+
+ArenaResource::ArenaResource(std::string aName)
+	: name(std::move(aName))
+{
+	std::lock_guard<std::mutex> lock(arena_registry_mutex_());
+	arena_registry_().push_back(this);
+}
+
+ArenaResource::~ArenaResource()
+{
+	std::lock_guard<std::mutex> lock(arena_registry_mutex_());
+	auto& arenas = arena_registry_();
+	arenas.erase(std::remove(arenas.begin(), arenas.end(), this), arenas.end());
+}
+
+void* ArenaResource::do_allocate(size_t aBytes, size_t aAlignment)
+{
+	return linear.allocate(aBytes, aAlignment);
+}
+
+void ArenaResource::reset()
+{
+	// what was used is published, as after the reset there is nothing left
+	publishedUsed.store(linear.bytesUsed(), std::memory_order_relaxed);
+	linear.reset();
+	publishedHighWater.store(linear.highWaterMark(), std::memory_order_relaxed);
+	publishedReserved.store(linear.bytesReserved(), std::memory_order_relaxed);
+	publishedResets.store(linear.resetCount(), std::memory_order_relaxed);
+}
+
+ArenaStats ArenaResource::stats() const
+{
+	ArenaStats result;
+	result.name = name.c_str();
+	result.bytesUsed = publishedUsed.load(std::memory_order_relaxed);
+	result.highWater = publishedHighWater.load(std::memory_order_relaxed);
+	result.bytesReserved = publishedReserved.load(std::memory_order_relaxed);
+	result.resets = publishedResets.load(std::memory_order_relaxed);
+	return result;
+}
+
+void for_each_arena(const std::function<void(const ArenaStats&)>& aVisit)
+{
+	std::lock_guard<std::mutex> lock(arena_registry_mutex_());
+	for (auto const* arena : arena_registry_())
+	{
+		aVisit(arena->stats());
+	}
+}
+
+ArenaResource& load_scratch_arena()
+{
+	static std::atomic<int> threads{ 0 };
+	thread_local ArenaResource arena("load scratch " + std::to_string(threads++));
+	return arena;
+}
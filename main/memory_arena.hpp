@@ -0,0 +1,205 @@
+#ifndef MEMORY_ARENA_HEADER_FILE
+#define MEMORY_ARENA_HEADER_FILE
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <memory_resource>
+
+// Bump allocator for per-frame data. Memory is handed out from large blocks
+// and only given back all at once by reset(), which keeps the blocks for the
+// next frame. Destructors are never run, so only use it for trivial types.
+class LinearArena
+{
+	static constexpr size_t kBlockSize = 256 * 1024;
+
+	struct Block
+	{
+		std::unique_ptr<std::byte[]> data;
+		size_t size;
+	};
+
+	std::vector<Block> blocks;
+	size_t currentBlock = 0;
+	size_t offset = 0;
+	size_t used = 0;
+	size_t highWater = 0;
+	size_t resets = 0;
+
+public:
+	void* allocate(size_t aSize, size_t aAlignment);
+	void reset();
+
+	template< typename tType >
+	tType* allocate(size_t aCount = 1)
+	{
+		return static_cast<tType*>(allocate(aCount * sizeof(tType), alignof(tType)));
+	}
+
+	// bytes handed out since the last reset()
+	size_t bytesUsed() const { return used; }
+	size_t bytesReserved() const;
+	// most bytes handed out between two resets
+	size_t highWaterMark() const { return std::max(highWater, used); }
+	size_t resetCount() const { return resets; }
+};
+
+struct ArenaStats
+{
+	// only valid inside for_each_arena()
+	const char* name = "";
+	size_t bytesUsed = 0;
+	size_t highWater = 0;
+	size_t bytesReserved = 0;
+	size_t resets = 0;
+};
+
+// A LinearArena usable through std::pmr containers. Containers must not
+// outlive the next reset(): deallocation is a no-op and the memory is
+// reused afterwards.
+//
+// Only the owning thread may allocate or reset; the statistics are
+// published on reset() and can be read from any thread through
+// for_each_arena().
+class ArenaResource : public std::pmr::memory_resource
+{
+	std::string name;
+	LinearArena linear;
+
+	std::atomic<size_t> publishedUsed{ 0 };
+	std::atomic<size_t> publishedHighWater{ 0 };
+	std::atomic<size_t> publishedReserved{ 0 };
+	std::atomic<size_t> publishedResets{ 0 };
+
+	void* do_allocate(size_t aBytes, size_t aAlignment) override;
+	void do_deallocate(void*, size_t, size_t) override {}
+	bool do_is_equal(const std::pmr::memory_resource& aOther) const noexcept override { return this == &aOther; }
+
+public:
+	explicit ArenaResource(std::string aName);
+	~ArenaResource() override;
+
+	ArenaResource(const ArenaResource&) = delete;
+	ArenaResource& operator=(const ArenaResource&) = delete;
+
+	void reset();
+	LinearArena& arena() { return linear; }
+
+	// as of the last reset()
+	ArenaStats stats() const;
+};
+
+// visits every live ArenaResource; aVisit must not create or destroy arenas
+void for_each_arena(const std::function<void(const ArenaStats&)>& aVisit);
+
+// Scratch memory for the loader running on the calling thread, e.g. for
+// std::pmr::vector<size_t> counts(&load_scratch_arena()). Each thread gets
+// its own; a LoadScratchScope gives everything back when the load is done.
+ArenaResource& load_scratch_arena();
+
+class LoadScratchScope
+{
+public:
+	LoadScratchScope() = default;
+	~LoadScratchScope() { load_scratch_arena().reset(); }
+
+	LoadScratchScope(const LoadScratchScope&) = delete;
+	LoadScratchScope& operator=(const LoadScratchScope&) = delete;
+};
+
+// Fixed-size slots for objects that must not move once created (e.g.
+// SceneObjs waiting on an upload). Slots are allocated tSlotsPerChunk at a
+// time and reused after release(); chunks are only freed with the pool,
+// which also destroys any objects still live.
+template< typename tType, size_t tSlotsPerChunk = 64 >
+class ObjectPool
+{
+	struct Slot
+	{
+		union
+		{
+			Slot* next;
+			alignas(tType) std::byte storage[sizeof(tType)];
+		};
+		bool used = false;
+	};
+
+	std::vector<std::unique_ptr<Slot[]>> chunks;
+	Slot* freeList = nullptr;
+	size_t live = 0;
+	size_t highWater = 0;
+
+public:
+	ObjectPool() = default;
+	~ObjectPool()
+	{
+		for (auto const& chunk : chunks)
+		{
+			for (size_t i = 0; i < tSlotsPerChunk; i++)
+			{
+				if (chunk[i].used) reinterpret_cast<tType*>(chunk[i].storage)->~tType();
+			}
+		}
+	}
+
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	template< typename... tArgs >
+	tType* create(tArgs&&... aArgs)
+	{
+		if (!freeList)
+		{
+			chunks.push_back(std::make_unique<Slot[]>(tSlotsPerChunk));
+			Slot* chunk = chunks.back().get();
+			for (size_t i = 0; i < tSlotsPerChunk; i++)
+			{
+				chunk[i].next = (i + 1 < tSlotsPerChunk) ? &chunk[i + 1] : nullptr;
+			}
+			freeList = chunk;
+		}
+
+		// the object is constructed over the free list link
+		Slot* slot = freeList;
+		freeList = slot->next;
+		tType* object;
+		try
+		{
+			object = new (slot->storage) tType(std::forward<tArgs>(aArgs)...);
+		}
+		catch (...)
+		{
+			slot->next = freeList;
+			freeList = slot;
+			throw;
+		}
+		slot->used = true;
+
+		live++;
+		highWater = std::max(highWater, live);
+		return object;
+	}
+
+	void release(tType* aObject)
+	{
+		aObject->~tType();
+		// storage is the first member of the slot
+		Slot* slot = reinterpret_cast<Slot*>(aObject);
+		slot->used = false;
+		slot->next = freeList;
+		freeList = slot;
+		live--;
+	}
+
+	size_t liveCount() const { return live; }
+	size_t highWaterMark() const { return highWater; }
+	size_t capacity() const { return chunks.size() * tSlotsPerChunk; }
+	size_t bytesReserved() const { return chunks.size() * tSlotsPerChunk * sizeof(Slot); }
+};
+
+#endif//MEMORY_ARENA_HEADER_FILE
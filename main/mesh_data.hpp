@@ -2,10 +2,55 @@
 #define MESH_DATA_HEADER_FILE
 
 #include <vector>
+#include <limits>
+#include <algorithm>
 #include "material.hpp"
 #include "../vmlib/vec3.hpp"
 #include "../vmlib/vec2.hpp"
 
+// What an object keeps of its vertex data once it is on the GPU
+enum MESH_RESIDENCY
+{
+	// everything, so the data can be edited and re-uploaded
+	RESIDENCY_KEEP,
+	// only the object space bounds (e.g. for culling and picking)
+	RESIDENCY_BOUNDS_ONLY,
+	// nothing; the file is read again if the data is needed
+	RESIDENCY_DROP
+};
+
+// object space axis aligned bounding box
+struct MeshBounds
+{
+	Vec3f min{ std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+	Vec3f max{ std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+
+	void include(const std::vector<Vec3f>& aPositions)
+	{
+		for (auto const& p : aPositions)
+		{
+			min = { std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z) };
+			max = { std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z) };
+		}
+	}
+};
+
+// heap memory held by a vector
+template <typename T>
+size_t vector_bytes(const std::vector<T>& aVector)
+{
+	return aVector.capacity() * sizeof(T);
+}
+
+// vertices [first, first + count) of a mesh, which all use one material
+// (an index into the owning object's material list)
+struct MeshRange
+{
+	GLint first;
+	GLsizei count;
+	size_t materialIndex;
+};
+
 struct MeshData
 {
 	std::vector<Vec3f> positions;
@@ -13,7 +58,8 @@ struct MeshData
 	std::vector<Vec3f> normals;
 	std::vector<Vec2f> texcoords;
 
-	Material material; 
+	// ordered by material, covering all vertices
+	std::vector<MeshRange> ranges;
 
 	size_t size;
 };
@@ -0,0 +1,537 @@
+#include "obj_stream.hpp"
+
+#include <limits>
+#include <vector>
+#include <cstdio>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <charconv>
+#include <thread>
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <windows.h>
+#	include <psapi.h>
+#else
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#endif
+
+#include "../support/error.hpp"
+
+#include "defaults.hpp"
+#include "memory_arena.hpp"
+
+namespace
+{
+	// chunks are split on line boundaries after roughly this many bytes
+	constexpr size_t kChunkBytes = 4 * 1024 * 1024;
+	// chunks per worker that are mapped and parsed before their pages are
+	// released again
+	constexpr size_t kChunksPerWorker = 2;
+
+	// normals are computed in dispatches of at most 65535 work groups
+	constexpr size_t kMaxPerDispatch = 65535 * 64;
+
+	constexpr float kMaxFloat = std::numeric_limits<float>::max();
+
+	// Read-only mapping of a whole file. Pages are only brought in when
+	// touched; release() drops them from the working set again.
+	class MappedFile_
+	{
+		const char* mData = nullptr;
+		size_t mSize = 0;
+
+#	if defined(_WIN32)
+		HANDLE mFile = INVALID_HANDLE_VALUE;
+		HANDLE mMapping = nullptr;
+#	else
+		int mFd = -1;
+#	endif
+
+	public:
+		explicit MappedFile_(const std::string& aPath);
+		~MappedFile_();
+
+		MappedFile_(const MappedFile_&) = delete;
+		MappedFile_& operator=(const MappedFile_&) = delete;
+
+		const char* data() const { return mData; }
+		size_t size() const { return mSize; }
+
+		void release(size_t aBegin, size_t aEnd);
+	};
+
+#	if defined(_WIN32)
+	MappedFile_::MappedFile_(const std::string& aPath)
+	{
+		mFile = CreateFileA(aPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (mFile == INVALID_HANDLE_VALUE)
+			throw Error("Unable to open '%s'", aPath.c_str());
+
+		LARGE_INTEGER size;
+		GetFileSizeEx(mFile, &size);
+		mSize = size_t(size.QuadPart);
+
+		if (mSize > 0)
+		{
+			mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mMapping)
+				mData = static_cast<const char*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+			if (!mData)
+			{
+				if (mMapping) CloseHandle(mMapping);
+				CloseHandle(mFile);
+				throw Error("Unable to map '%s'", aPath.c_str());
+			}
+		}
+	}
+
+	MappedFile_::~MappedFile_()
+	{
+		if (mData) UnmapViewOfFile(mData);
+		if (mMapping) CloseHandle(mMapping);
+		CloseHandle(mFile);
+	}
+
+	void MappedFile_::release(size_t aBegin, size_t aEnd)
+	{
+		// unlocking pages that are not locked removes them from the working set
+		VirtualUnlock(const_cast<char*>(mData + aBegin), aEnd - aBegin);
+	}
+
+	size_t resident_bytes_()
+	{
+		PROCESS_MEMORY_COUNTERS counters{};
+		if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			return 0;
+		return counters.WorkingSetSize;
+	}
+#	else
+	MappedFile_::MappedFile_(const std::string& aPath)
+	{
+		mFd = open(aPath.c_str(), O_RDONLY);
+		if (mFd < 0)
+			throw Error("Unable to open '%s'", aPath.c_str());
+
+		struct stat info;
+		fstat(mFd, &info);
+		mSize = size_t(info.st_size);
+
+		if (mSize > 0)
+		{
+			void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, mFd, 0);
+			if (data == MAP_FAILED)
+			{
+				close(mFd);
+				throw Error("Unable to map '%s'", aPath.c_str());
+			}
+			mData = static_cast<const char*>(data);
+			madvise(data, mSize, MADV_SEQUENTIAL);
+		}
+	}
+
+	MappedFile_::~MappedFile_()
+	{
+		if (mData) munmap(const_cast<char*>(mData), mSize);
+		close(mFd);
+	}
+
+	void MappedFile_::release(size_t aBegin, size_t aEnd)
+	{
+		size_t const page = size_t(sysconf(_SC_PAGESIZE));
+		size_t const begin = aBegin / page * page;
+		madvise(const_cast<char*>(mData + begin), aEnd - begin, MADV_DONTNEED);
+	}
+
+	// the current resident set; getrusage() only has the peak since the
+	// process started, which a load below that peak does not move
+	size_t resident_bytes_()
+	{
+		std::FILE* statm = std::fopen("/proc/self/statm", "r");
+		if (!statm)
+			return 0;
+
+		unsigned long pages = 0, resident = 0;
+		bool const read = std::fscanf(statm, "%lu %lu", &pages, &resident) == 2;
+		std::fclose(statm);
+		return read ? size_t(resident) * size_t(sysconf(_SC_PAGESIZE)) : 0;
+	}
+#	endif
+
+	struct Chunk_
+	{
+		size_t begin, end;
+
+		// first pass
+		size_t vertices = 0;
+		size_t triangles = 0;
+
+		// prefix sums of the above
+		size_t firstVertex = 0;
+		size_t firstTriangle = 0;
+
+		// second pass
+		Vec3f boundsMin{ kMaxFloat, kMaxFloat, kMaxFloat };
+		Vec3f boundsMax{ -kMaxFloat, -kMaxFloat, -kMaxFloat };
+		bool malformed = false;
+	};
+
+	bool is_blank_(char aChar)
+	{
+		return aChar == ' ' || aChar == '\t' || aChar == '\r';
+	}
+
+	const char* skip_blanks_(const char* aCursor, const char* aEnd)
+	{
+		while (aCursor < aEnd && is_blank_(*aCursor)) aCursor++;
+		return aCursor;
+	}
+
+	const char* skip_token_(const char* aCursor, const char* aEnd)
+	{
+		while (aCursor < aEnd && !is_blank_(*aCursor)) aCursor++;
+		return aCursor;
+	}
+
+	// calls aLine(begin, end) for each line without its '\n'
+	template< typename tFunc >
+	void for_each_line_(const char* aBegin, const char* aEnd, tFunc&& aLine)
+	{
+		while (aBegin < aEnd)
+		{
+			auto const* newline = static_cast<const char*>(std::memchr(aBegin, '\n', size_t(aEnd - aBegin)));
+			const char* lineEnd = newline ? newline : aEnd;
+			aLine(aBegin, lineEnd);
+			aBegin = lineEnd + 1;
+		}
+	}
+
+	// 'v' and 'f' records, but not 'vn', 'vt', ...
+	bool is_record_(const char* aLine, const char* aEnd, char aType)
+	{
+		return aEnd - aLine >= 2 && aLine[0] == aType && is_blank_(aLine[1]);
+	}
+
+	void count_chunk_(const char* aFile, Chunk_& aChunk)
+	{
+		for_each_line_(aFile + aChunk.begin, aFile + aChunk.end, [&] (const char* aLine, const char* aEnd) {
+			if (is_record_(aLine, aEnd, 'v'))
+			{
+				aChunk.vertices++;
+			}
+			else if (is_record_(aLine, aEnd, 'f'))
+			{
+				size_t corners = 0;
+				for (const char* cursor = skip_blanks_(aLine + 1, aEnd); cursor < aEnd; cursor = skip_blanks_(cursor, aEnd))
+				{
+					cursor = skip_token_(cursor, aEnd);
+					corners++;
+				}
+				if (corners >= 3) aChunk.triangles += corners - 2;
+			}
+		});
+	}
+
+	void parse_chunk_(const char* aFile, Chunk_& aChunk, size_t aTotalVertices, float* aPositions, std::uint32_t* aIndices)
+	{
+		float* position = aPositions + 3 * aChunk.firstVertex;
+		std::uint32_t* index = aIndices + 3 * aChunk.firstTriangle;
+		// vertices defined before the current line, for relative indices
+		long long verticesSoFar = (long long)aChunk.firstVertex;
+
+		for_each_line_(aFile + aChunk.begin, aFile + aChunk.end, [&] (const char* aLine, const char* aEnd) {
+			if (aChunk.malformed) return;
+
+			if (is_record_(aLine, aEnd, 'v'))
+			{
+				const char* cursor = aLine + 1;
+				for (int i = 0; i < 3; i++)
+				{
+					cursor = skip_blanks_(cursor, aEnd);
+					auto const [next, error] = std::from_chars(cursor, aEnd, position[i]);
+					if (error != std::errc()) { aChunk.malformed = true; return; }
+					cursor = next;
+				}
+
+				aChunk.boundsMin = { std::min(aChunk.boundsMin.x, position[0]), std::min(aChunk.boundsMin.y, position[1]), std::min(aChunk.boundsMin.z, position[2]) };
+				aChunk.boundsMax = { std::max(aChunk.boundsMax.x, position[0]), std::max(aChunk.boundsMax.y, position[1]), std::max(aChunk.boundsMax.z, position[2]) };
+
+				position += 3;
+				verticesSoFar++;
+			}
+			else if (is_record_(aLine, aEnd, 'f'))
+			{
+				std::uint32_t first = 0, previous = 0;
+				size_t corner = 0;
+
+				for (const char* cursor = skip_blanks_(aLine + 1, aEnd); cursor < aEnd; cursor = skip_blanks_(cursor, aEnd))
+				{
+					// only the position index of "v", "v/t", "v//n" or "v/t/n"
+					long long value = 0;
+					auto const [next, error] = std::from_chars(cursor, aEnd, value);
+					if (error != std::errc() || value == 0) { aChunk.malformed = true; return; }
+					cursor = skip_token_(next, aEnd);
+
+					long long const resolved = value > 0 ? value - 1 : verticesSoFar + value;
+					if (resolved < 0 || resolved >= (long long)aTotalVertices) { aChunk.malformed = true; return; }
+					auto const vertex = std::uint32_t(resolved);
+
+					// triangle fan
+					if (corner == 0) first = vertex;
+					else if (corner >= 2)
+					{
+						index[0] = first;
+						index[1] = previous;
+						index[2] = vertex;
+						index += 3;
+					}
+					previous = vertex;
+					corner++;
+				}
+			}
+		});
+	}
+
+	// map a freshly allocated buffer of aBytes for writing
+	void* map_new_buffer_(GLuint aBuffer, size_t aBytes)
+	{
+		glBindBuffer(GL_COPY_WRITE_BUFFER, aBuffer);
+		glBufferData(GL_COPY_WRITE_BUFFER, GLsizeiptr(aBytes), nullptr, GL_STATIC_DRAW);
+		void* mapped = glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, GLsizeiptr(aBytes), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+		if (!mapped)
+			throw Error("Unable to map a %zu byte buffer", aBytes);
+		return mapped;
+	}
+
+	void unmap_buffer_(GLuint aBuffer)
+	{
+		glBindBuffer(GL_COPY_WRITE_BUFFER, aBuffer);
+		if (glUnmapBuffer(GL_COPY_WRITE_BUFFER) != GL_TRUE)
+			throw Error("Mesh buffer contents were lost while mapped");
+	}
+}
+
+StreamedMesh::~StreamedMesh()
+{
+	glDeleteVertexArrays(1, &vertexArray);
+	GLuint const buffers[] = { positionBuffer, normalBuffer, indexBuffer, constantBuffer };
+	glDeleteBuffers(4, buffers);
+}
+
+void StreamedMesh::createVertexArray()
+{
+	glGenVertexArrays(1, &vertexArray);
+	glBindVertexArray(vertexArray);
+
+	glBindBuffer(GL_ARRAY_BUFFER, positionBuffer);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
+	glEnableVertexAttribArray(0);
+
+	glBindBuffer(GL_ARRAY_BUFFER, normalBuffer);
+	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 0, 0);
+	glEnableVertexAttribArray(2);
+
+	// colour and texture coordinate: a single element, which a divisor of 1
+	// repeats for every vertex of a non-instanced draw
+	glBindBuffer(GL_ARRAY_BUFFER, constantBuffer);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, 0);
+	glVertexAttribDivisor(1, 1);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<void*>(3 * sizeof(float)));
+	glVertexAttribDivisor(3, 1);
+	glEnableVertexAttribArray(3);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+
+	// Reset state
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void StreamedMesh::submit(RenderQueue& aQueue, GLuint aProgram, GLuint aTexture, GLint aTextureLayer, const Mat44f& aModel, const Mat44f& aMaterial) const
+{
+	if (!ready()) return;
+
+	DrawItem item;
+	item.program = aProgram;
+	item.vertexArray = vertexArray;
+	item.texture = aTexture;
+	item.textureLayer = aTextureLayer;
+	item.indexType = GL_UNSIGNED_INT;
+	item.count = GLsizei(3 * triangleCount);
+	item.model = aModel;
+	item.material = aMaterial;
+
+	aQueue.submit(item);
+}
+
+ObjStreamLoader::ObjStreamLoader(size_t aWorkers)
+	: pool(aWorkers ? aWorkers : std::max(1u, std::thread::hardware_concurrency() / 2))
+{
+}
+
+ObjStreamStats ObjStreamLoader::load(const std::string& aPath, StreamedMesh& aMesh)
+{
+	auto const start = Clock::now();
+	size_t const startResident = resident_bytes_();
+	size_t peakResident = startResident;
+
+	MappedFile_ file(aPath);
+	char const* const data = file.data();
+
+	LoadScratchScope scratch;
+
+	// split into chunks that end after a newline; only the pages around the
+	// split points are touched here
+	std::pmr::vector<Chunk_> chunks(&load_scratch_arena());
+	chunks.reserve(file.size() / kChunkBytes + 1);
+	for (size_t begin = 0; begin < file.size(); )
+	{
+		size_t end = std::min(begin + kChunkBytes, file.size());
+		if (end < file.size())
+		{
+			auto const* newline = static_cast<const char*>(std::memchr(data + end, '\n', file.size() - end));
+			end = newline ? size_t(newline - data) + 1 : file.size();
+		}
+		chunks.push_back({ begin, end });
+		begin = end;
+	}
+
+	size_t const window = kChunksPerWorker * pool.workerCount();
+	auto for_each_window = [&] (auto&& aChunkFunc) {
+		for (size_t first = 0; first < chunks.size(); first += window)
+		{
+			size_t const count = std::min(window, chunks.size() - first);
+			pool.parallelFor(count, [&] (size_t, size_t aBegin, size_t aEnd) {
+				for (size_t i = aBegin; i < aEnd; i++) aChunkFunc(chunks[first + i]);
+			});
+			// the pages of a window are resident until they are released
+			peakResident = std::max(peakResident, resident_bytes_());
+			file.release(chunks[first].begin, chunks[first + count - 1].end);
+		}
+	};
+
+	// first pass: sizes
+	for_each_window([&] (Chunk_& aChunk) { count_chunk_(data, aChunk); });
+
+	size_t vertices = 0, triangles = 0;
+	for (auto& chunk : chunks)
+	{
+		chunk.firstVertex = vertices;
+		chunk.firstTriangle = triangles;
+		vertices += chunk.vertices;
+		triangles += chunk.triangles;
+	}
+
+	if (vertices == 0 || triangles == 0)
+		throw Error("'%s' contains no triangles", aPath.c_str());
+	if (vertices > std::numeric_limits<std::uint32_t>::max())
+		throw Error("'%s' has too many vertices for 32-bit indices", aPath.c_str());
+
+	// second pass: parse straight into the GPU buffers
+	glGenBuffers(1, &aMesh.positionBuffer);
+	glGenBuffers(1, &aMesh.indexBuffer);
+
+	auto* positions = static_cast<float*>(map_new_buffer_(aMesh.positionBuffer, vertices * 3 * sizeof(float)));
+	auto* indices = static_cast<std::uint32_t*>(map_new_buffer_(aMesh.indexBuffer, triangles * 3 * sizeof(std::uint32_t)));
+
+	for_each_window([&] (Chunk_& aChunk) { parse_chunk_(data, aChunk, vertices, positions, indices); });
+
+	unmap_buffer_(aMesh.positionBuffer);
+	unmap_buffer_(aMesh.indexBuffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	Vec3f boundsMin{ kMaxFloat, kMaxFloat, kMaxFloat };
+	Vec3f boundsMax{ -kMaxFloat, -kMaxFloat, -kMaxFloat };
+	for (auto const& chunk : chunks)
+	{
+		if (chunk.malformed)
+			throw Error("Malformed record in '%s' between bytes %zu and %zu", aPath.c_str(), chunk.begin, chunk.end);
+
+		boundsMin = { std::min(boundsMin.x, chunk.boundsMin.x), std::min(boundsMin.y, chunk.boundsMin.y), std::min(boundsMin.z, chunk.boundsMin.z) };
+		boundsMax = { std::max(boundsMax.x, chunk.boundsMax.x), std::max(boundsMax.y, chunk.boundsMax.y), std::max(boundsMax.z, chunk.boundsMax.z) };
+	}
+
+	aMesh.vertexCount = vertices;
+	aMesh.triangleCount = triangles;
+	aMesh.boundsMin = boundsMin;
+	aMesh.boundsMax = boundsMax;
+
+	float const constants[] = { 1.f, 1.f, 1.f, 0.f, 0.f };
+	glGenBuffers(1, &aMesh.constantBuffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, aMesh.constantBuffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, sizeof(constants), constants, GL_STATIC_DRAW);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	computeNormals(aMesh);
+
+	ObjStreamStats stats;
+	stats.fileBytes = file.size();
+	stats.vertices = vertices;
+	stats.triangles = triangles;
+	stats.seconds = std::chrono::duration_cast<Secondsf>(Clock::now() - start).count();
+	stats.megabytesPerSecond = float(file.size()) / (1024.f * 1024.f) / std::max(stats.seconds, 1e-6f);
+	peakResident = std::max(peakResident, resident_bytes_());
+	stats.peakRssGrowthBytes = peakResident - startResident;
+	return stats;
+}
+
+void ObjStreamLoader::computeNormals(StreamedMesh& aMesh)
+{
+	if (!normalsProgram)
+	{
+		normalsProgram.emplace(std::vector<ShaderProgram::ShaderSource>{
+			{ GL_COMPUTE_SHADER, "assets/mesh_normals.comp" }
+		});
+	}
+
+	GLsizeiptr const normalBytes = GLsizeiptr(aMesh.vertexCount * 3 * sizeof(float));
+
+	glGenBuffers(1, &aMesh.normalBuffer);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, aMesh.normalBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, normalBytes, nullptr, GL_STATIC_DRAW);
+
+	// fixed point sums, same size as the normals; freed again below
+	GLuint accumulated = 0;
+	glGenBuffers(1, &accumulated);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, accumulated);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, normalBytes, nullptr, GL_STREAM_COPY);
+	GLint const zero = 0;
+	glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32I, GL_RED_INTEGER, GL_INT, &zero);
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, aMesh.positionBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, aMesh.indexBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, accumulated);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, aMesh.normalBuffer);
+
+	glUseProgram(normalsProgram->programId());
+
+	auto dispatch = [] (GLuint aMode, size_t aCount) {
+		glUniform1ui(0, aMode);
+		glUniform1ui(2, GLuint(aCount));
+		for (size_t first = 0; first < aCount; first += kMaxPerDispatch)
+		{
+			size_t const count = std::min(kMaxPerDispatch, aCount - first);
+			glUniform1ui(1, GLuint(first));
+			glDispatchCompute(GLuint((count + 63) / 64), 1, 1);
+		}
+	};
+
+	dispatch(0, aMesh.triangleCount);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	dispatch(1, aMesh.vertexCount);
+	glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+
+	glUseProgram(0);
+	for (GLuint binding = 0; binding < 4; binding++)
+	{
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, 0);
+	}
+	glDeleteBuffers(1, &accumulated);
+}
@@ -0,0 +1,97 @@
+#ifndef OBJ_STREAM_HEADER_FILE
+#define OBJ_STREAM_HEADER_FILE
+
+#include <glad.h>
+
+#include <string>
+#include <cstddef>
+#include <optional>
+
+#include "../support/program.hpp"
+#include "../vmlib/vec3.hpp"
+#include "../vmlib/mat44.hpp"
+
+#include "render_queue.hpp"
+#include "worker_pool.hpp"
+
+struct ObjStreamStats
+{
+	size_t fileBytes = 0;
+	size_t vertices = 0;
+	size_t triangles = 0;
+	float seconds = 0.f;
+	float megabytesPerSecond = 0.f;
+	// largest growth of the process' resident set over the load, sampled
+	// after each window of chunks; 0 where it cannot be queried. Other
+	// threads' allocations in that time count too.
+	size_t peakRssGrowthBytes = 0;
+};
+
+// Indexed triangle mesh that lives only on the GPU: positions, indices and
+// normals, one constant colour and no texture coordinates.
+class StreamedMesh
+{
+	friend class ObjStreamLoader;
+
+	GLuint positionBuffer = 0;
+	GLuint normalBuffer = 0;
+	GLuint indexBuffer = 0;
+	// white colour and zero texture coordinate, shared by all vertices
+	GLuint constantBuffer = 0;
+	GLuint vertexArray = 0;
+
+	size_t vertexCount = 0;
+	size_t triangleCount = 0;
+	Vec3f boundsMin{ 0.f, 0.f, 0.f };
+	Vec3f boundsMax{ 0.f, 0.f, 0.f };
+
+public:
+	StreamedMesh() = default;
+	~StreamedMesh();
+
+	StreamedMesh(const StreamedMesh&) = delete;
+	StreamedMesh& operator=(const StreamedMesh&) = delete;
+
+	// VAOs are not shared between contexts, so this must be called on the
+	// main context after the buffers have been filled
+	void createVertexArray();
+	bool ready() const { return vertexArray != 0; }
+
+	Vec3f minimum() const { return boundsMin; }
+	Vec3f maximum() const { return boundsMax; }
+	size_t triangles() const { return triangleCount; }
+
+	void submit(RenderQueue& aQueue, GLuint aProgram, GLuint aTexture, GLint aTextureLayer, const Mat44f& aModel, const Mat44f& aMaterial) const;
+};
+
+// Out-of-core OBJ loader for very large meshes (scans with tens of millions
+// of triangles). The file is memory mapped and parsed in parallel chunks
+// split on line boundaries, a window of chunks at a time. A first pass
+// counts vertices and triangles per chunk; the second pass parses each
+// chunk straight into mapped GPU buffers at the offsets given by the
+// counts, and the pages of the file are released after each window. Apart
+// from the mapped window, working memory is a few counters per chunk.
+// Normals are then computed on the GPU (assets/mesh_normals.comp).
+//
+// Only v and f records are used; polygons are triangulated as fans.
+// load() makes GL calls (bypassing the state cache) and can run on any
+// context that shares objects with the main one, e.g. on an UploadThread.
+class ObjStreamLoader
+{
+	// its own threads, so that a load never holds up the renderer's pool
+	WorkerPool pool;
+	// built on first use, on whichever context load() runs on
+	std::optional<ShaderProgram> normalsProgram;
+
+	void computeNormals(StreamedMesh& aMesh);
+
+public:
+	// aWorkers includes the calling thread; 0 picks half the hardware
+	// threads, leaving the rest to the frame
+	explicit ObjStreamLoader(size_t aWorkers = 0);
+
+	// throws Error if the file cannot be read or is malformed
+	ObjStreamStats load(const std::string& aPath, StreamedMesh& aMesh);
+};
+
+#endif//OBJ_STREAM_HEADER_FILE
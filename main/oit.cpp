@@ -0,0 +1,168 @@
+#include "oit.hpp"
+
+#include "../support/error.hpp"
+#include "../support/checkpoint.hpp"
+
+#include "gl_state.hpp"
+
+WeightedBlendedOIT::WeightedBlendedOIT()
+	: accumulateProgram({
+		{ GL_VERTEX_SHADER, "assets/default.vert" },
+		{ GL_FRAGMENT_SHADER, "assets/oit_accumulate.frag" }
+	})
+	, compositeProgram({
+		{ GL_VERTEX_SHADER, "assets/oit_composite.vert" },
+		{ GL_FRAGMENT_SHADER, "assets/oit_composite.frag" }
+	})
+{
+	// the composite pass generates its vertices from gl_VertexID, but core
+	// profile still requires a vertex array to be bound
+	glGenVertexArrays(1, &emptyVertexArray);
+}
+
+WeightedBlendedOIT::~WeightedBlendedOIT()
+{
+	releaseTargets();
+	glDeleteVertexArrays(1, &emptyVertexArray);
+}
+
+void WeightedBlendedOIT::releaseTargets()
+{
+	glDeleteFramebuffers(1, &framebuffer);
+	glDeleteTextures(1, &accumTexture);
+	glDeleteTextures(1, &revealTexture);
+	glDeleteRenderbuffers(1, &depthRenderbuffer);
+
+	framebuffer = accumTexture = revealTexture = depthRenderbuffer = 0;
+	width = height = 0;
+}
+
+void WeightedBlendedOIT::resize(GLsizei aWidth, GLsizei aHeight)
+{
+	// a minimised window has no framebuffer to match; keep the old targets
+	if (aWidth <= 0 || aHeight <= 0)
+		return;
+
+	if (aWidth == width && aHeight == height && framebuffer)
+		return;
+
+	releaseTargets();
+
+	auto makeTarget = [&] (GLenum aFormat) {
+		GLuint texture = 0;
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexStorage2D(GL_TEXTURE_2D, 1, aFormat, aWidth, aHeight);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		return texture;
+	};
+
+	accumTexture = makeTarget(GL_RGBA16F);
+	// 16 bits instead of the usual 8 so that hundreds of layers do not
+	// quantise revealage to zero
+	revealTexture = makeTarget(GL_R16F);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	// must match the default framebuffer's depth format for the blit
+	glGenRenderbuffers(1, &depthRenderbuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, depthRenderbuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, aWidth, aHeight);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, accumTexture, 0);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, revealTexture, 0);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthRenderbuffer);
+
+	GLenum const drawBuffers[] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+	glDrawBuffers(2, drawBuffers);
+
+	GLenum const status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	if (GL_FRAMEBUFFER_COMPLETE != status)
+	{
+		releaseTargets();
+		throw Error("OIT framebuffer incomplete (0x%x)", status);
+	}
+
+	width = aWidth;
+	height = aHeight;
+
+	// the texture bindings above bypass the state cache
+	gl_state().invalidate();
+
+	OGL_CHECKPOINT_DEBUG();
+}
+
+void WeightedBlendedOIT::beginAccumulation()
+{
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+	glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+	static constexpr GLfloat kAccumClear[] = { 0.f, 0.f, 0.f, 0.f };
+	static constexpr GLfloat kRevealClear[] = { 1.f, 0.f, 0.f, 0.f };
+	glClearBufferfv(GL_COLOR, 0, kAccumClear);
+	glClearBufferfv(GL_COLOR, 1, kRevealClear);
+
+	// test against the opaque depth, but never write it: all translucent
+	// surfaces in front of the opaque geometry contribute
+	gl_state().enable(GL_DEPTH_TEST);
+	gl_state().depthMaskEnabled(false);
+	gl_state().enable(GL_BLEND);
+	glBlendFunci(0, GL_ONE, GL_ONE);
+	glBlendFunci(1, GL_ZERO, GL_ONE_MINUS_SRC_COLOR);
+}
+
+void WeightedBlendedOIT::endAccumulation()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	// glBlendFunci() is not tracked by the state cache
+	gl_state().invalidate();
+}
+
+void WeightedBlendedOIT::composite()
+{
+	gl_state().disable(GL_DEPTH_TEST);
+	gl_state().enable(GL_BLEND);
+	gl_state().blendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);
+
+	gl_state().useProgram(compositeProgram.programId());
+	gl_state().bindVertexArray(emptyVertexArray);
+	gl_state().bindTexture(0, GL_TEXTURE_2D, accumTexture);
+	gl_state().bindTexture(1, GL_TEXTURE_2D, revealTexture);
+
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+
+	gl_state().bindTexture(1, GL_TEXTURE_2D, 0);
+	gl_state().enable(GL_DEPTH_TEST);
+	gl_state().depthMaskEnabled(true);
+	gl_state().blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	OGL_CHECKPOINT_DEBUG();
+}
+
+GLuint WeightedBlendedOIT::accumulateProgramId() const noexcept
+{
+	return accumulateProgram.programId();
+}
+
+void WeightedBlendedOIT::reloadAsync()
+{
+	accumulateProgram.reloadAsync();
+	compositeProgram.reloadAsync();
+}
+
+bool WeightedBlendedOIT::pollReload()
+{
+	bool const accumulateReloaded = accumulateProgram.pollReload();
+	bool const compositeReloaded = compositeProgram.pollReload();
+	return accumulateReloaded || compositeReloaded;
+}
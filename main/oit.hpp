@@ -0,0 +1,66 @@
+#ifndef OIT_HEADER_FILE
+#define OIT_HEADER_FILE
+
+#include <glad.h>
+
+#include "../support/program.hpp"
+
+// Weighted blended order-independent transparency (McGuire & Bavoil 2013).
+//
+// Translucent surfaces are rendered in any order into two targets: an RGBA16F
+// accumulation target (sum of weighted, premultiplied colours) and an R16F
+// revealage target (product of 1 - alpha). A single full-screen pass then
+// blends the weighted average colour over the opaque image. No sorting is
+// needed, so the cost grows with the number of translucent fragments only.
+//
+// Usage per frame, after the opaque geometry has been drawn:
+//
+//   oit.resize(w, h);
+//   oit.beginAccumulation();
+//   ... draw translucent geometry with accumulateProgramId() ...
+//   oit.endAccumulation();
+//   oit.composite();
+class WeightedBlendedOIT
+{
+	GLuint framebuffer = 0;
+	GLuint accumTexture = 0;
+	GLuint revealTexture = 0;
+	GLuint depthRenderbuffer = 0;
+	GLuint emptyVertexArray = 0;
+
+	GLsizei width = 0;
+	GLsizei height = 0;
+
+	ShaderProgram accumulateProgram;
+	ShaderProgram compositeProgram;
+
+	void releaseTargets();
+
+public:
+	WeightedBlendedOIT();
+	~WeightedBlendedOIT();
+
+	WeightedBlendedOIT(const WeightedBlendedOIT&) = delete;
+	WeightedBlendedOIT& operator=(const WeightedBlendedOIT&) = delete;
+
+	// (re)creates the render targets if the framebuffer size changed; a
+	// zero size (minimised window) is ignored
+	void resize(GLsizei aWidth, GLsizei aHeight);
+
+	// binds and clears the OIT targets. The depth buffer of the default
+	// framebuffer is copied over so that opaque geometry still occludes.
+	void beginAccumulation();
+	// rebinds the default framebuffer
+	void endAccumulation();
+	// blends the resolved translucent layer over the default framebuffer
+	void composite();
+
+	// program to draw translucent geometry with during accumulation; same
+	// uniform layout as the regular scene shaders
+	GLuint accumulateProgramId() const noexcept;
+
+	void reloadAsync();
+	bool pollReload();
+};
+
+#endif//OIT_HEADER_FILE
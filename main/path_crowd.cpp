@@ -0,0 +1,199 @@
+#include "path_crowd.hpp"
+
+#include <cmath>
+
+#include "../support/checkpoint.hpp"
+
+#include "gl_state.hpp"
+
+PathCrowd::PathCrowd()
+	: updateProgram({
+		{ GL_COMPUTE_SHADER, "assets/crowd_update.comp" }
+	})
+	, drawProgram({
+		{ GL_VERTEX_SHADER, "assets/crowd.vert" },
+		{ GL_FRAGMENT_SHADER, "assets/correct_blinn-phong.frag" }
+	})
+{
+	GLuint buffers[4];
+	glGenBuffers(4, buffers);
+	trackControlsBuffer = buffers[0];
+	trackArcLengthBuffer = buffers[1];
+	instanceBuffer = buffers[2];
+	matrixBuffer = buffers[3];
+
+	glGenQueries(GLsizei(kQueriesInFlight), timerQueries);
+}
+
+PathCrowd::~PathCrowd()
+{
+	GLuint const buffers[] = { trackControlsBuffer, trackArcLengthBuffer, instanceBuffer, matrixBuffer };
+	glDeleteBuffers(4, buffers);
+	glDeleteQueries(GLsizei(kQueriesInFlight), timerQueries);
+}
+
+void PathCrowd::setTrack(const CatmullRomSpline& aTrack, float aHeadingOffset)
+{
+	track = aTrack;
+	headingOffset = aHeadingOffset;
+
+	// std430 pads vec3 array elements to 16 bytes
+	std::vector<float> controls;
+	controls.reserve(track.bezierControls().size() * 4);
+	for (auto const& control : track.bezierControls())
+	{
+		controls.insert(controls.end(), { control.x, control.y, control.z, 1.f });
+	}
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, trackControlsBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, controls.size() * sizeof(float), controls.data(), GL_STATIC_DRAW);
+
+	auto const& arcLength = track.arcLengths();
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, trackArcLengthBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, arcLength.size() * sizeof(float), arcLength.data(), GL_STATIC_DRAW);
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void PathCrowd::setInstanceCount(size_t aCount, float aSpeed)
+{
+	constexpr size_t kLanes = 4;
+	constexpr float kLaneWidth = 0.6f;
+
+	instances.resize(aCount);
+
+	float const trackLength = track.length();
+	for (size_t i = 0; i < aCount; i++)
+	{
+		// deterministic spread; cars in one lane keep their spacing
+		size_t const lane = i % kLanes;
+		float const laneSpeed = aSpeed * (0.8f + 0.15f * float(lane));
+
+		instances[i].offset = trackLength * float(i / kLanes) * kLanes / float(aCount);
+		instances[i].speed = laneSpeed;
+		instances[i].lateral = (float(lane) - 0.5f * float(kLanes - 1)) * kLaneWidth;
+		instances[i].scale = 0.25f;
+	}
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, instanceBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, instances.size() * sizeof(Instance), instances.data(), GL_STATIC_DRAW);
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, matrixBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, instances.size() * 16 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	staging.resize(instances.size() * 16);
+}
+
+void PathCrowd::updateOnGpu(float aTime)
+{
+	if (instances.empty() || track.empty()) return;
+
+	glBeginQuery(GL_TIME_ELAPSED, timerQueries[frame % kQueriesInFlight]);
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, trackControlsBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, trackArcLengthBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, instanceBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, matrixBuffer);
+
+	gl_state().useProgram(updateProgram.programId());
+	gl_state().uniform1f(0, aTime);
+	glUniform1ui(1, GLuint(instances.size()));
+	gl_state().uniform1i(2, GLint(CatmullRomSpline::kSamplesPerSegment));
+	gl_state().uniform1f(3, headingOffset);
+
+	glDispatchCompute(GLuint((instances.size() + 63) / 64), 1, 1);
+
+	// the vertex shader reads the matrices
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void PathCrowd::updateOnCpu(float aTime)
+{
+	if (instances.empty() || track.empty()) return;
+
+	glBeginQuery(GL_TIME_ELAPSED, timerQueries[frame % kQueriesInFlight]);
+
+	float const trackLength = track.length();
+
+	for (size_t i = 0; i < instances.size(); i++)
+	{
+		auto const& instance = instances[i];
+
+		Vec3f position, direction;
+		track.sample(std::fmod(instance.offset + aTime * instance.speed, trackLength), position, direction);
+
+		float const heading = std::atan2(direction.x, direction.z) + headingOffset;
+		float const c = std::cos(heading);
+		float const s = std::sin(heading);
+		float const k = instance.scale;
+
+		position += instance.lateral * Vec3f{ c, 0.f, -s };
+
+		// column-major, as read by the shader
+		float const matrix[16] = {
+			k * c, 0.f, -k * s, 0.f,
+			0.f, k, 0.f, 0.f,
+			k * s, 0.f, k * c, 0.f,
+			position.x, position.y, position.z, 1.f
+		};
+		std::copy(matrix, matrix + 16, staging.begin() + i * 16);
+	}
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, matrixBuffer);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, staging.size() * sizeof(float), staging.data());
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, matrixBuffer);
+}
+
+void PathCrowd::draw(SceneObj& aModel, const Mat44f& aProjCamera)
+{
+	if (instances.empty() || track.empty()) return;
+
+	gl_state().useProgram(drawProgram.programId());
+	gl_state().uniformMatrix4fv(0, GL_TRUE, aProjCamera.v);
+
+	gl_state().disable(GL_BLEND);
+	gl_state().depthMaskEnabled(true);
+
+	aModel.drawInstanced(GLsizei(instances.size()));
+
+	glEndQuery(GL_TIME_ELAPSED);
+	queryPending[frame % kQueriesInFlight] = true;
+	frame++;
+
+	// finished queries, oldest first. Queries finish in order, so the first
+	// one still running ends the search. With every query in flight, the
+	// next frame's glBeginQuery() drops the oldest result.
+	for (size_t i = 0; i < kQueriesInFlight; i++)
+	{
+		size_t const slot = (frame + i) % kQueriesInFlight;
+		if (!queryPending[slot]) continue;
+
+		GLint available = 0;
+		glGetQueryObjectiv(timerQueries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available) break;
+
+		GLuint64 elapsed = 0;
+		glGetQueryObjectui64v(timerQueries[slot], GL_QUERY_RESULT, &elapsed);
+		gpuMs = float(elapsed) / 1e6f;
+		queryPending[slot] = false;
+	}
+
+	OGL_CHECKPOINT_DEBUG();
+}
+
+void PathCrowd::reloadAsync()
+{
+	updateProgram.reloadAsync();
+	drawProgram.reloadAsync();
+}
+
+bool PathCrowd::pollReload()
+{
+	bool const updateReloaded = updateProgram.pollReload();
+	bool const drawReloaded = drawProgram.pollReload();
+	return updateReloaded || drawReloaded;
+}
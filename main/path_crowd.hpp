@@ -0,0 +1,84 @@
+#ifndef PATH_CROWD_HEADER_FILE
+#define PATH_CROWD_HEADER_FILE
+
+#include <glad.h>
+
+#include <vector>
+
+#include "../support/program.hpp"
+#include "../vmlib/mat44.hpp"
+
+#include "spline.hpp"
+#include "scene_object.hpp"
+
+// Many copies of one model driving around a closed track. The track and the
+// per-instance parameters live in shader storage buffers; every frame the
+// instance matrices are either computed by a compute shader (no per-instance
+// CPU work at all) or on the CPU and uploaded, for comparison. Each mesh of
+// the model is then drawn with a single instanced draw.
+//
+// Buffer bindings: 0 track Bezier controls, 1 track arc lengths,
+// 2 instance parameters, 3 instance matrices.
+class PathCrowd
+{
+	struct Instance
+	{
+		float offset;
+		float speed;
+		float lateral;
+		float scale;
+	};
+
+	CatmullRomSpline track;
+	float headingOffset = 0.f;
+
+	std::vector<Instance> instances;
+	std::vector<float> staging;
+
+	GLuint trackControlsBuffer = 0;
+	GLuint trackArcLengthBuffer = 0;
+	GLuint instanceBuffer = 0;
+	GLuint matrixBuffer = 0;
+
+	ShaderProgram updateProgram;
+	ShaderProgram drawProgram;
+
+	// GPU time of update + draw. Queries are used round-robin and only read
+	// once their result is available, so that reading them never stalls.
+	static constexpr size_t kQueriesInFlight = 4;
+	GLuint timerQueries[kQueriesInFlight] = {};
+	bool queryPending[kQueriesInFlight] = {};
+	size_t frame = 0;
+	float gpuMs = 0.f;
+
+public:
+	PathCrowd();
+	~PathCrowd();
+
+	PathCrowd(const PathCrowd&) = delete;
+	PathCrowd& operator=(const PathCrowd&) = delete;
+
+	// the track must be closed (see CatmullRomSpline::build())
+	void setTrack(const CatmullRomSpline& aTrack, float aHeadingOffset = 0.f);
+	// spread aCount instances over the track in a few lanes, at speeds
+	// around aSpeed
+	void setInstanceCount(size_t aCount, float aSpeed);
+
+	// compute the instance matrices for aTime seconds. Each frame calls one
+	// of these, followed by draw().
+	void updateOnGpu(float aTime);
+	void updateOnCpu(float aTime);
+
+	// per-frame uniforms of drawProgramId() (lights, camera) must be set
+	void draw(SceneObj& aModel, const Mat44f& aProjCamera);
+
+	size_t size() const { return instances.size(); }
+	GLuint drawProgramId() const noexcept { return drawProgram.programId(); }
+	// GPU time of the last completed update + draw
+	float lastGpuMs() const { return gpuMs; }
+
+	void reloadAsync();
+	bool pollReload();
+};
+
+#endif//PATH_CROWD_HEADER_FILE
@@ -1,56 +1,94 @@
 #include "path_object.hpp"
 
-void PathObj::updatePath(int speed)
+#include <cmath>
+#include <algorithm>
+
+void PathObj::setupPath(ANIMATION_STYLE aPathStyle)
+{
+	pathStyle = aPathStyle;
+
+	spline = CatmullRomSpline();
+	segmentStart.clear();
+	pathDuration = 0.f;
+
+	rotations.clear();
+	rotations.reserve(points.size());
+	for (auto const& point : points)
+	{
+		rotations.push_back(make_quat_euler(point.rotation));
+	}
+
+	if (points.size() < 2) return;
+
+	size_t const segments = (pathStyle == REPEAT) ? points.size() : points.size() - 1;
+	for (size_t i = 0; i < segments; i++)
+	{
+		segmentStart.push_back(pathDuration);
+
+		auto const& target = points[(i + 1) % points.size()];
+		pathDuration += float(std::max<size_t>(target.steps, 1)) / kAnimationStepsPerSecond;
+	}
+}
+
+void PathObj::setupSpline(float aSpeed, ANIMATION_STYLE aPathStyle, float aHeadingOffset)
 {
+	pathStyle = aPathStyle;
+	headingOffset = aHeadingOffset;
+
+	segmentStart.clear();
 
-	if (this->currentStep == 0 && this->currentPointIndex == 0)
+	std::vector<Vec3f> positions;
+	positions.reserve(points.size());
+	for (auto const& point : points)
 	{
-		this->setRotationAnchors(this->points[currentPointIndex].rotation, this->points[currentPointIndex+1].rotation);
-		this->setPositionAnchors(this->points[currentPointIndex].position, this->points[currentPointIndex+1].position);
-		this->setScaleAnchors(this->points[currentPointIndex].scale, this->points[currentPointIndex+1].scale);
-		this->setupAnimation(
-			points[currentPointIndex].steps, 
-			points[currentPointIndex].interpolationStyle
-		);
-		currentPointIndex++;
+		positions.push_back(point.position);
 	}
 
-	this->animationStyle = STOP;
-	this->updateAnimation(speed);
+	spline.build(positions, pathStyle == REPEAT);
+	splineSpeed = std::max(aSpeed, 1e-3f);
+	pathDuration = spline.length() / splineSpeed;
 
-	// check if at end of current point to point
-	if (this->currentStep >= this->totalSteps)
+	if (!points.empty())
 	{
-		currentPointIndex++;
-		// check if at end of path
-		if (currentPointIndex >= this->points.size())
-		{
-			switch (pathStyle)
-			{
-				case STOP:
-					{
-						return;
-					}
-				case BOUNCE:
-					{
-						std::reverse(points.begin(), points.end());
-						[[clang::fallthrough]];
-					}
-				case REPEAT:
-					{
-						currentPointIndex = 0;
-					}
-			}
-		}
-
-		// set next path point
-		this->setRotationAnchors(rotationEnd, this->points[currentPointIndex].rotation);
-		this->setPositionAnchors(positionEnd, this->points[currentPointIndex].position);
-		this->setScaleAnchors(scaleEnd, this->points[currentPointIndex].scale);
-
-		this->setupAnimation(
-			points[currentPointIndex].steps, 
-			points[currentPointIndex].interpolationStyle
-		);
+		this->transform.setScale(points.front().scale);
 	}
 }
+
+void PathObj::updatePath(float aTime)
+{
+	if (pathDuration <= 0.f) return;
+
+	// a BOUNCE path is traversed forwards, then the same way backwards. The
+	// points are never reordered; the time is mirrored instead.
+	bool reversed;
+	float const progress = animation_progress(pathStyle, aTime / pathDuration, reversed);
+	float const time = (reversed ? 1.f - progress : progress) * pathDuration;
+
+	if (!spline.empty())
+	{
+		Vec3f position, direction;
+		spline.sample(time * splineSpeed, position, direction);
+		if (reversed) direction = -direction;
+
+		this->transform.setPosition(position);
+		this->transform.setRotation(make_quat_rotation_y(std::atan2(direction.x, direction.z) + headingOffset));
+		return;
+	}
+
+	if (segmentStart.empty()) return;
+
+	auto const next = std::upper_bound(segmentStart.begin(), segmentStart.end(), time);
+	size_t const segment = size_t(next - segmentStart.begin()) - 1;
+
+	float const segmentEnd = (next == segmentStart.end()) ? pathDuration : *next;
+	float const segmentProgress = (time - segmentStart[segment]) / (segmentEnd - segmentStart[segment]);
+
+	auto const& from = points[segment];
+	auto const& to = points[(segment + 1) % points.size()];
+
+	this->setRotationAnchors(rotations[segment], rotations[(segment + 1) % points.size()]);
+	this->setPositionAnchors(from.position, to.position);
+	this->setScaleAnchors(from.scale, to.scale);
+
+	this->applyAnchors(ease(to.interpolationStyle, segmentProgress));
+}
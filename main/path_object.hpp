@@ -2,29 +2,60 @@
 #define PATH_OBJECT_HEADER_FILE
 
 #include "animation_object.hpp"
+#include "spline.hpp"
 
 struct PathPoint
 {
+	// Euler angles, see Transform::setRotation()
 	Vec3f rotation = {0.f, 0.f, 0.f};
 	Vec3f position = {0.f, 0.f, 0.f};
 	Vec3f scale = {1.f, 1.f, 1.f};
 
+	// length and easing of the segment that arrives at this point
 	size_t steps = 100;
 	INTERPOLATION_STYLE interpolationStyle = SINUSOIDAL;
 };
 
+// Moves through a list of points. With REPEAT the path is closed (the last
+// point leads back to the first), STOP and BOUNCE run from the first point
+// to the last.
+//
+// setupPath() interpolates every PathPoint component per segment with the
+// segment's easing. setupSpline() instead follows a Catmull-Rom spline
+// through the point positions at constant speed, facing along the curve;
+// this is the mode for long tracks with many points.
 class PathObj : public AnimationObj
 {
 	std::vector<PathPoint> points;
+	// PathPoint::rotation of each point, converted by setupPath()
+	std::vector<Quatf> rotations;
 
-	size_t currentPointIndex = 0;
+	CatmullRomSpline spline;
+	float splineSpeed = 0.f;
+	// heading added to the direction of travel
+	float headingOffset = 0.f;
+
+	// time at which each segment starts; segment i runs from point i to
+	// point (i + 1) % points.size()
+	std::vector<float> segmentStart;
+	float pathDuration = 0.f;
 
 	ANIMATION_STYLE pathStyle;
 
 public:
-	void setupPath(ANIMATION_STYLE aPathStyle = REPEAT) {pathStyle = aPathStyle;}
+	void setupPath(ANIMATION_STYLE aPathStyle = REPEAT);
+	// aSpeed in units per second. aHeadingOffset turns the model about the
+	// y-axis, for models that do not face +z.
+	void setupSpline(float aSpeed, ANIMATION_STYLE aPathStyle = REPEAT, float aHeadingOffset = 0.f);
 	void addPathPoint(const PathPoint aPathPoint) {points.push_back(aPathPoint);}
-	void updatePath(int speed);
+	// removes the points; set the path up again after adding new ones
+	void clearPathPoints() {points.clear();}
+	// evaluate the path at aTime seconds after it started, in O(log n) for
+	// n points. Call setupPath() after the last point is added.
+	void updatePath(float aTime);
+
+	// empty unless set up with setupSpline()
+	const CatmullRomSpline& getSpline() const {return spline;}
 };
 
 #endif//PATH_OBJECT_HEADER_FILE
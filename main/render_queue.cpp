@@ -0,0 +1,262 @@
+#include "render_queue.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "gl_state.hpp"
+
+namespace
+{
+	constexpr int kDepthBits = 24;
+	constexpr int kTextureBits = 17;
+	constexpr int kMaterialBits = 12;
+	constexpr int kShaderBits = 8;
+
+	constexpr std::uint64_t mask_(int aBits)
+	{
+		return (std::uint64_t(1) << aBits) - 1;
+	}
+
+	// FNV-1a over the packed material. Only used to group equal materials,
+	// so collisions cost a few extra state changes but are otherwise harmless.
+	std::uint64_t material_hash_(const Mat44f& aMaterial)
+	{
+		unsigned char bytes[sizeof(aMaterial.v)];
+		std::memcpy(bytes, aMaterial.v, sizeof(bytes));
+
+		std::uint64_t hash = 1469598103934665603ull;
+		for (auto const byte : bytes)
+		{
+			hash ^= byte;
+			hash *= 1099511628211ull;
+		}
+		return hash ^ (hash >> 32);
+	}
+
+	// LSD radix sort, one byte per pass. Passes where every key has the same
+	// byte are skipped, which is common for the upper (pass/shader) bytes.
+	void radix_sort_(std::vector<RenderQueue::SortEntry>& aEntries, std::vector<RenderQueue::SortEntry>& aScratch)
+	{
+		aScratch.resize(aEntries.size());
+
+		auto* src = &aEntries;
+		auto* dst = &aScratch;
+
+		for (int shift = 0; shift < 64; shift += 8)
+		{
+			size_t histogram[256] = {};
+			for (auto const& entry : *src)
+			{
+				histogram[(entry.key >> shift) & 0xff]++;
+			}
+
+			if (histogram[(src->front().key >> shift) & 0xff] == src->size()) continue;
+
+			size_t offset = 0;
+			for (auto& bucket : histogram)
+			{
+				size_t const count = bucket;
+				bucket = offset;
+				offset += count;
+			}
+
+			for (auto const& entry : *src)
+			{
+				(*dst)[histogram[(entry.key >> shift) & 0xff]++] = entry;
+			}
+
+			std::swap(src, dst);
+		}
+
+		if (src != &aEntries)
+		{
+			aEntries.swap(aScratch);
+		}
+	}
+}
+
+std::uint64_t make_sort_key(const DrawItem& aItem, const SortKeyContext& aContext)
+{
+	// distance from the camera to the object's origin
+	Vec3f const origin = { aItem.model(0, 3), aItem.model(1, 3), aItem.model(2, 3) };
+	float const distance = length(origin - aContext.cameraPosition) / aContext.depthRange;
+	std::uint64_t depth = std::uint64_t(std::clamp(distance, 0.f, 1.f) * float(mask_(kDepthBits)));
+
+	std::uint64_t const shader = std::uint64_t(aItem.program) & mask_(kShaderBits);
+	std::uint64_t const material = material_hash_(aItem.material) & mask_(kMaterialBits);
+	std::uint64_t const texture = std::uint64_t(aItem.texture) & mask_(kTextureBits);
+
+	std::uint64_t key = std::uint64_t(aItem.pass & 0x3) << 62;
+
+	if (!aItem.translucent)
+	{
+		key |= shader << (kMaterialBits + kTextureBits + kDepthBits);
+		key |= material << (kTextureBits + kDepthBits);
+		key |= texture << kDepthBits;
+		key |= depth;
+	}
+	else
+	{
+		// order independent blending does not need the depth
+		if (aContext.transparencyMode == TRANSPARENCY_WEIGHTED_BLENDED)
+		{
+			depth = mask_(kDepthBits);
+		}
+
+		key |= std::uint64_t(1) << 61;
+		key |= (mask_(kDepthBits) - depth) << (kShaderBits + kMaterialBits + kTextureBits);
+		key |= shader << (kMaterialBits + kTextureBits);
+		key |= material << kTextureBits;
+		key |= texture;
+	}
+
+	return key;
+}
+
+void RenderQueue::begin(Vec3f aCameraPosition, float aDepthRange)
+{
+	mergedLists.clear();
+	packets.clear();
+	entries.clear();
+	stats = RenderQueueStats();
+
+	context.cameraPosition = aCameraPosition;
+	context.depthRange = aDepthRange;
+	context.transparencyMode = transparencyMode;
+	directList.begin(context);
+}
+
+void RenderQueue::submit(const DrawItem& aItem)
+{
+	directList.record(aItem);
+}
+
+void RenderQueue::merge(const CommandList& aList)
+{
+	mergedLists.push_back(&aList);
+}
+
+void RenderQueue::sort()
+{
+	packets.clear();
+	entries.clear();
+
+	auto gather = [this] (const CommandList& aList) {
+		for (auto const& recorded : aList.recorded())
+		{
+			entries.push_back({ recorded.key, std::uint32_t(packets.size()) });
+			packets.push_back(recorded.packet);
+		}
+	};
+
+	gather(directList);
+	for (auto const* list : mergedLists)
+	{
+		gather(*list);
+	}
+
+	if (entries.size() > 1)
+	{
+		radix_sort_(entries, scratch);
+	}
+}
+
+void RenderQueue::flush(const Mat44f& aProjCamera)
+{
+	flushOpaque(aProjCamera);
+	flushTranslucent(aProjCamera);
+}
+
+void RenderQueue::flushOpaque(const Mat44f& aProjCamera)
+{
+	flushItems(false, aProjCamera, 0);
+}
+
+void RenderQueue::flushTranslucent(const Mat44f& aProjCamera, GLuint aProgramOverride)
+{
+	flushItems(true, aProjCamera, aProgramOverride);
+
+	// glClear() honours the depth mask, so leave depth writes enabled
+	gl_state().depthMaskEnabled(true);
+}
+
+void RenderQueue::flushItems(bool aTranslucent, const Mat44f& aProjCamera, GLuint aProgramOverride)
+{
+	GLuint lastProgram = 0, lastVertexArray = 0, lastTexture = 0;
+	const float* lastMaterial = nullptr;
+	bool first = true;
+
+	if (aTranslucent)
+	{
+		if (context.transparencyMode == TRANSPARENCY_SORTED)
+		{
+			gl_state().enable(GL_BLEND);
+			gl_state().blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		}
+		gl_state().depthMaskEnabled(false);
+	}
+	else
+	{
+		gl_state().disable(GL_BLEND);
+		gl_state().depthMaskEnabled(true);
+	}
+
+	for (auto const& entry : entries)
+	{
+		auto const& packet = *packets[entry.index];
+		if (packet.translucent != aTranslucent) continue;
+
+		GLuint const program = (aTranslucent && aProgramOverride) ? aProgramOverride : packet.program;
+
+		if (first || program != lastProgram) stats.programChanges++;
+		if (first || packet.vertexArray != lastVertexArray) stats.vertexArrayChanges++;
+		if (first || packet.texture != lastTexture) stats.textureChanges++;
+		if (first || std::memcmp(lastMaterial, packet.material(), 16 * sizeof(float)) != 0) stats.materialChanges++;
+
+		gl_state().useProgram(program);
+		gl_state().bindVertexArray(packet.vertexArray);
+		if (packet.textureLayer < 0)
+		{
+			gl_state().bindTexture(0, GL_TEXTURE_2D, packet.texture);
+		}
+		else
+		{
+			gl_state().bindTexture(1, GL_TEXTURE_2D_ARRAY, packet.texture);
+		}
+		gl_state().uniform1i(13, packet.textureLayer);
+
+		Mat44f model;
+		std::memcpy(model.v, packet.model(), sizeof(model.v));
+		Mat44f const projCameraModel = aProjCamera * model;
+
+		gl_state().uniformMatrix4fv(
+			0,
+			GL_TRUE, projCameraModel.v
+		);
+		gl_state().uniformMatrix4fv(
+			1,
+			GL_TRUE, packet.model()
+		);
+		gl_state().uniformMatrix4fv(
+			3,
+			GL_FALSE, packet.material()
+		);
+
+		if (packet.indexType == GL_NONE)
+		{
+			glDrawArrays(GL_TRIANGLES, packet.first, packet.count);
+		}
+		else
+		{
+			size_t const indexBytes = packet.indexType == GL_UNSIGNED_INT ? 4 : packet.indexType == GL_UNSIGNED_SHORT ? 2 : 1;
+			glDrawElements(GL_TRIANGLES, packet.count, packet.indexType, reinterpret_cast<const void*>(size_t(packet.first) * indexBytes));
+		}
+		stats.draws++;
+
+		lastProgram = program;
+		lastVertexArray = packet.vertexArray;
+		lastTexture = packet.texture;
+		lastMaterial = packet.material();
+		first = false;
+	}
+}
@@ -0,0 +1,101 @@
+#ifndef RENDER_QUEUE_HEADER_FILE
+#define RENDER_QUEUE_HEADER_FILE
+
+#include <glad.h>
+
+#include <vector>
+#include <cstdint>
+
+#include "../vmlib/vec3.hpp"
+#include "../vmlib/mat44.hpp"
+
+#include "draw_item.hpp"
+#include "command_list.hpp"
+
+struct RenderQueueStats
+{
+	size_t draws = 0;
+	size_t programChanges = 0;
+	size_t vertexArrayChanges = 0;
+	size_t textureChanges = 0;
+	size_t materialChanges = 0;
+};
+
+// Collects the draws of a frame and submits them sorted by a 64-bit key:
+//
+//   opaque:      | pass:2 | 0 | shader:8 | material:12 | texture:17 | depth:24 |
+//   translucent: | pass:2 | 1 | ~depth:24 | shader:8 | material:12 | texture:17 |
+//
+// Opaque draws are grouped by state and then sorted front-to-back (less
+// overdraw), translucent ones are drawn back-to-front after all opaques of
+// the same pass. Keys are sorted with an LSD radix sort. The shader field
+// is the low bits of the program name; like material hash collisions, a
+// clash only costs extra state changes.
+//
+// Draws are either submitted directly on the GL thread or recorded into
+// CommandLists (possibly on other threads) and merged before sort().
+//
+// With TRANSPARENCY_WEIGHTED_BLENDED the depth field of translucent keys is
+// left at zero, so translucent draws are grouped by state like opaque ones
+// and their order does not depend on the camera.
+class RenderQueue
+{
+public:
+	struct SortEntry
+	{
+		std::uint64_t key;
+		std::uint32_t index;
+	};
+
+private:
+	// receives the draws passed to submit()
+	CommandList directList;
+	std::vector<const CommandList*> mergedLists;
+
+	std::vector<const DrawPacket*> packets;
+	std::vector<SortEntry> entries;
+	std::vector<SortEntry> scratch;
+
+	SortKeyContext context;
+	TRANSPARENCY_MODE transparencyMode = TRANSPARENCY_SORTED;
+
+	RenderQueueStats stats;
+
+	void flushItems(bool aTranslucent, const Mat44f& aProjCamera, GLuint aProgramOverride);
+
+public:
+	RenderQueue() = default;
+	// directly submitted draws are packed into aFrameArena, which must be
+	// reset once per frame, outside begin() ... flush()
+	explicit RenderQueue(LinearArena& aFrameArena) : directList(aFrameArena) {}
+
+	// start collecting a new frame; depth is measured from aCameraPosition
+	// and quantised over [0, aDepthRange]
+	void begin(Vec3f aCameraPosition, float aDepthRange);
+	void submit(const DrawItem& aItem);
+	// add the draws recorded in aList; it must stay untouched until the
+	// queue has been flushed
+	void merge(const CommandList& aList);
+	void sort();
+	// issue all draws in sorted order; aProjCamera is combined with each model matrix
+	void flush(const Mat44f& aProjCamera);
+	// issue only the opaque or only the translucent draws (of all passes). If aProgramOverride
+	// is non-zero, translucent draws use it instead of their own program. In
+	// TRANSPARENCY_WEIGHTED_BLENDED mode flushTranslucent() leaves the blend
+	// state to the caller.
+	void flushOpaque(const Mat44f& aProjCamera);
+	void flushTranslucent(const Mat44f& aProjCamera, GLuint aProgramOverride = 0);
+
+	// takes effect for draws submitted after the next begin()
+	void setTransparencyMode(TRANSPARENCY_MODE aMode) { transparencyMode = aMode; }
+	TRANSPARENCY_MODE getTransparencyMode() const { return transparencyMode; }
+
+	// what CommandLists recorded for this frame must be begun with
+	const SortKeyContext& keyContext() const { return context; }
+
+	// valid after sort()
+	size_t size() const { return packets.size(); }
+	const RenderQueueStats& lastStats() const { return stats; }
+};
+
+#endif//RENDER_QUEUE_HEADER_FILE
@@ -0,0 +1,228 @@
+#include "scene_hierarchy.hpp"
+
+#include <algorithm>
+
+namespace
+{
+	// below this many changed nodes the pool is not worth waking
+	constexpr size_t kMinParallelNodes = 4096;
+	// subtrees larger than this are split into their children's subtrees
+	constexpr size_t kTaskNodes = 1024;
+}
+
+HierarchyNode SceneHierarchy::create(HierarchyNode aParent, const Mat44f& aLocal)
+{
+	std::uint32_t const index = std::uint32_t(parent.size());
+	HierarchyNode const handle = HierarchyNode(indexOf.size());
+	std::uint32_t const parentIndex = (aParent == kNoParentNode) ? kNoParentNode : indexOf[aParent];
+
+	parent.push_back(parentIndex);
+	subtreeEnd.push_back(index + 1);
+	local.push_back(aLocal);
+	world.push_back(aLocal);
+	dirty.push_back(1);
+	handleOf.push_back(handle);
+	indexOf.push_back(index);
+
+	if (parentIndex == kNoParentNode) return handle;
+
+	if (subtreeEnd[parentIndex] == index)
+	{
+		// the parent's subtree ends here, so appending keeps the order;
+		// extend it and the subtrees of all ancestors that also end here
+		for (std::uint32_t i = parentIndex; i != kNoParentNode && subtreeEnd[i] == index; i = parent[i])
+		{
+			subtreeEnd[i] = index + 1;
+		}
+	}
+	else
+	{
+		orderDirty = true;
+	}
+
+	return handle;
+}
+
+void SceneHierarchy::clear()
+{
+	parent.clear();
+	subtreeEnd.clear();
+	local.clear();
+	world.clear();
+	dirty.clear();
+	handleOf.clear();
+	indexOf.clear();
+	orderDirty = false;
+}
+
+void SceneHierarchy::setLocal(HierarchyNode aNode, const Mat44f& aLocal)
+{
+	std::uint32_t const index = indexOf[aNode];
+	local[index] = aLocal;
+	dirty[index] = 1;
+}
+
+void SceneHierarchy::rebuildOrder()
+{
+	size_t const count = parent.size();
+
+	// children of each node, in creation order, as offsets into one array
+	std::vector<std::uint32_t> childStart(count + 1, 0);
+	for (size_t i = 0; i < count; i++)
+	{
+		if (parent[i] != kNoParentNode) childStart[parent[i] + 1]++;
+	}
+	for (size_t i = 0; i < count; i++)
+	{
+		childStart[i + 1] += childStart[i];
+	}
+	std::vector<std::uint32_t> children(childStart[count]);
+	std::vector<std::uint32_t> fill(childStart.begin(), childStart.end() - 1);
+	for (size_t i = 0; i < count; i++)
+	{
+		if (parent[i] != kNoParentNode) children[fill[parent[i]]++] = std::uint32_t(i);
+	}
+
+	// depth-first order, iteratively
+	std::vector<std::uint32_t> order;
+	order.reserve(count);
+	std::vector<std::uint32_t> stack;
+	for (size_t root = 0; root < count; root++)
+	{
+		if (parent[root] != kNoParentNode) continue;
+
+		stack.push_back(std::uint32_t(root));
+		while (!stack.empty())
+		{
+			std::uint32_t const node = stack.back();
+			stack.pop_back();
+			order.push_back(node);
+
+			// reversed, so that the first child is visited first
+			for (std::uint32_t c = childStart[node + 1]; c > childStart[node]; c--)
+			{
+				stack.push_back(children[c - 1]);
+			}
+		}
+	}
+
+	std::vector<std::uint32_t> newIndex(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		newIndex[order[i]] = std::uint32_t(i);
+	}
+
+	auto permute = [&] (auto& aArray) {
+		std::remove_reference_t<decltype(aArray)> sorted(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			sorted[i] = aArray[order[i]];
+		}
+		aArray.swap(sorted);
+	};
+	permute(local);
+	permute(world);
+	permute(dirty);
+	permute(handleOf);
+	permute(parent);
+
+	for (auto& p : parent)
+	{
+		if (p != kNoParentNode) p = newIndex[p];
+	}
+	for (size_t i = 0; i < count; i++)
+	{
+		indexOf[handleOf[i]] = std::uint32_t(i);
+	}
+
+	// a subtree ends where the next node that is not a descendant starts;
+	// walking backwards, each node's end is the end of its last child
+	for (size_t i = count; i-- > 0; )
+	{
+		subtreeEnd[i] = std::uint32_t(i + 1);
+	}
+	for (size_t i = count; i-- > 0; )
+	{
+		if (parent[i] != kNoParentNode)
+		{
+			subtreeEnd[parent[i]] = std::max(subtreeEnd[parent[i]], subtreeEnd[i]);
+		}
+	}
+
+	orderDirty = false;
+}
+
+void SceneHierarchy::computeRange(std::uint32_t aBegin, std::uint32_t aEnd)
+{
+	// parents come first, so they are always up to date here
+	for (std::uint32_t i = aBegin; i < aEnd; i++)
+	{
+		world[i] = (parent[i] == kNoParentNode) ? local[i] : world[parent[i]] * local[i];
+		dirty[i] = 0;
+	}
+}
+
+size_t SceneHierarchy::update(WorkerPool* aPool)
+{
+	if (orderDirty)
+	{
+		rebuildOrder();
+	}
+
+	// a changed node invalidates its whole subtree; nested changes are
+	// covered by the outermost one
+	tasks.clear();
+	size_t total = 0;
+	std::uint32_t const count = std::uint32_t(parent.size());
+	for (std::uint32_t i = 0; i < count; )
+	{
+		if (dirty[i])
+		{
+			tasks.push_back({ i, subtreeEnd[i] });
+			total += subtreeEnd[i] - i;
+			i = subtreeEnd[i];
+		}
+		else
+		{
+			i++;
+		}
+	}
+
+	if (!aPool || aPool->workerCount() == 1 || total < kMinParallelNodes)
+	{
+		for (auto const& task : tasks)
+		{
+			computeRange(task.begin, task.end);
+		}
+		return total;
+	}
+
+	// Split large subtrees: their root is computed here, after which the
+	// subtrees of its children are independent of each other.
+	for (size_t t = 0; t < tasks.size(); )
+	{
+		Range const task = tasks[t];
+		if (task.end - task.begin <= kTaskNodes)
+		{
+			t++;
+			continue;
+		}
+
+		computeRange(task.begin, task.begin + 1);
+		tasks[t] = tasks.back();
+		tasks.pop_back();
+		for (std::uint32_t child = task.begin + 1; child < task.end; child = subtreeEnd[child])
+		{
+			tasks.push_back({ child, subtreeEnd[child] });
+		}
+	}
+
+	aPool->parallelFor(tasks.size(), [this] (size_t, size_t aBegin, size_t aEnd) {
+		for (size_t t = aBegin; t < aEnd; t++)
+		{
+			computeRange(tasks[t].begin, tasks[t].end);
+		}
+	});
+
+	return total;
+}
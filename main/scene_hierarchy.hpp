@@ -0,0 +1,69 @@
+#ifndef SCENE_HIERARCHY_HEADER_FILE
+#define SCENE_HIERARCHY_HEADER_FILE
+
+#include <vector>
+#include <cstdint>
+
+#include "../vmlib/mat44.hpp"
+
+#include "worker_pool.hpp"
+
+using HierarchyNode = std::uint32_t;
+constexpr HierarchyNode kNoParentNode = ~HierarchyNode(0);
+
+// Parent/child transforms, e.g. a car body with wheels and doors. Each node
+// has a local matrix relative to its parent; update() computes the world
+// matrices.
+//
+// Nodes are stored in depth-first order, so every parent comes before its
+// children and every subtree is one contiguous range. update() therefore
+// never chases pointers: it finds the subtrees below nodes changed by
+// setLocal() and recomputes each of them in one linear pass. Independent
+// subtrees go to a WorkerPool if one is given and there is enough work.
+//
+// HierarchyNode handles stay valid while the storage is reordered. Building
+// a tree top-down keeps the order as is; adding children to an earlier
+// subtree makes the next update() reorder everything once.
+class SceneHierarchy
+{
+	// by storage index
+	std::vector<std::uint32_t> parent;		// storage index, or kNoParentNode
+	std::vector<std::uint32_t> subtreeEnd;	// one past the last descendant
+	std::vector<Mat44f> local;
+	std::vector<Mat44f> world;
+	std::vector<std::uint8_t> dirty;
+	std::vector<HierarchyNode> handleOf;
+
+	// by handle
+	std::vector<std::uint32_t> indexOf;
+
+	bool orderDirty = false;
+
+	struct Range
+	{
+		std::uint32_t begin;
+		std::uint32_t end;
+	};
+	std::vector<Range> tasks;
+
+	void rebuildOrder();
+	void computeRange(std::uint32_t aBegin, std::uint32_t aEnd);
+
+public:
+	// aParent must already exist (or be kNoParentNode)
+	HierarchyNode create(HierarchyNode aParent, const Mat44f& aLocal = kIdentity44f);
+	void clear();
+
+	void setLocal(HierarchyNode aNode, const Mat44f& aLocal);
+	const Mat44f& getLocal(HierarchyNode aNode) const { return local[indexOf[aNode]]; }
+	// as of the last update()
+	const Mat44f& getWorld(HierarchyNode aNode) const { return world[indexOf[aNode]]; }
+
+	// recompute the world matrices below every changed node; returns the
+	// number of nodes recomputed
+	size_t update(WorkerPool* aPool = nullptr);
+
+	size_t size() const { return parent.size(); }
+};
+
+#endif//SCENE_HIERARCHY_HEADER_FILE
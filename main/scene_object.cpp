@@ -1,7 +1,70 @@
 #include "scene_object.hpp"
+
+#include <memory>
+#include <algorithm>
+
 #include "loadobj.hpp"
+#include "gl_state.hpp"
+#include "allocation_counter.hpp"
+#include "memory_arena.hpp"
 #include "../support/error.hpp"
 
+static Mat44f object_model_transform_(const SceneObject& aObject)
+{
+	Mat44f rotationTransform = make_rotation_z(aObject.rotation.z) * make_rotation_y(aObject.rotation.y) * make_rotation_x(aObject.rotation.x);
+	return make_translation(aObject.position) * make_scaling(aObject.scaling.x, aObject.scaling.y, aObject.scaling.z) * rotationTransform;
+}
+
+// vertex data is released but the vertex count is kept for drawing
+static bool simple_mesh_released_(const SimpleMeshData& aMesh)
+{
+	return aMesh.positions.empty() && aMesh.size > 0;
+}
+
+static void release_simple_mesh_(SimpleMeshData& aMesh, MESH_RESIDENCY aResidency)
+{
+	if (aResidency == RESIDENCY_KEEP) return;
+
+	// swap with empty vectors, as clear() keeps the capacity
+	std::vector<Vec3f>().swap(aMesh.positions);
+	std::vector<Vec3f>().swap(aMesh.colors);
+	std::vector<Vec3f>().swap(aMesh.normals);
+}
+
+// called once the mesh data is on the GPU
+static void apply_object_residency_(SceneObject& aObject)
+{
+	aObject.bounds.reset();
+	if (aObject.residency != RESIDENCY_DROP)
+	{
+		MeshBounds bounds;
+		bounds.include(aObject.mesh.positions);
+		aObject.bounds = bounds;
+	}
+	release_simple_mesh_(aObject.mesh, aObject.residency);
+}
+
+static void apply_complex_object_residency_(ComplexSceneObject& aObject)
+{
+	MeshBounds bounds;
+	for (auto& mesh : aObject.meshes)
+	{
+		bounds.include(mesh.positions);
+		release_simple_mesh_(mesh, aObject.object.residency);
+	}
+
+	aObject.object.bounds.reset();
+	if (aObject.object.residency != RESIDENCY_DROP)
+	{
+		aObject.object.bounds = bounds;
+	}
+}
+
+static size_t simple_mesh_bytes_(const SimpleMeshData& aMesh)
+{
+	return vector_bytes(aMesh.positions) + vector_bytes(aMesh.colors) + vector_bytes(aMesh.normals);
+}
+
 int initObject(SceneObject *aObject, char const* aPath)
 {
 	if (aObject->_initialised == true)
@@ -10,6 +73,8 @@ int initObject(SceneObject *aObject, char const* aPath)
 		return -1;
 	}
 
+	ScopedAllocationReport report(aPath);
+
 	// load object from path;
 	aObject->filepath = aPath;
 	try
@@ -27,6 +92,8 @@ int initObject(SceneObject *aObject, char const* aPath)
 	aObject->scaling = {1.f, 1.f, 1.f};
 	aObject->VAO = create_vao(aObject->mesh);
 
+	apply_object_residency_(*aObject);
+
 	aObject->_initialised = true;
 
 	return 0;
@@ -34,7 +101,18 @@ int initObject(SceneObject *aObject, char const* aPath)
 
 void updateObject(SceneObject* aObject)
 {
+	if (simple_mesh_released_(aObject->mesh))
+	{
+		aObject->mesh = load_wavefront_obj(aObject->filepath);
+	}
+
 	create_vao(aObject->mesh, aObject->VAO);
+	apply_object_residency_(*aObject);
+}
+
+size_t objectResidentBytes(const SceneObject* aObject)
+{
+	return simple_mesh_bytes_(aObject->mesh) + (aObject->bounds ? sizeof(MeshBounds) : 0);
 }
 
 void drawObject(const SceneObject* aObject, const Mat44f projCamera)
@@ -45,25 +123,40 @@ void drawObject(const SceneObject* aObject, const Mat44f projCamera)
 	Mat44f modelTransform = make_translation(aObject->position) * make_scaling(aObject->scaling.x, aObject->scaling.y, aObject->scaling.z) * rotationTransform;
 	Mat44f finalTransform = projCamera * modelTransform;
 
-	glUniformMatrix4fv(
-		0, 1,
+	gl_state().uniformMatrix4fv(
+		0,
 		GL_TRUE, finalTransform.v
 	);
 
-	glUniformMatrix4fv(
-		1, 1,
+	gl_state().uniformMatrix4fv(
+		1,
 		GL_TRUE, modelTransform.v
 	);
 
-	glBindVertexArray(aObject->VAO);
+	gl_state().bindVertexArray(aObject->VAO);
 	glDrawArrays(GL_TRIANGLES, 0, aObject->mesh.size);
+}
 
-	glBindVertexArray(0);
+void submitObject(const SceneObject* aObject, RenderQueue& aQueue, GLuint aProgram, GLuint aTexture, const Mat44f& aMaterial, GLint aTextureLayer)
+{
+	if (aObject->_initialised == false) return;
+
+	DrawItem item;
+	item.program = aProgram;
+	item.vertexArray = aObject->VAO;
+	item.texture = aTexture;
+	item.textureLayer = aTextureLayer;
+	item.count = GLsizei(aObject->mesh.size);
+	item.model = object_model_transform_(*aObject);
+	item.material = aMaterial;
+
+	aQueue.submit(item);
 }
 
-int SceneObj::loadMaterials(rapidobj::Materials aMaterials)
+int SceneObj::loadMaterials(const rapidobj::Materials& aMaterials)
 {
 	//create materials
+	this->materials.reserve(this->materials.size() + aMaterials.size() + 1);
 	for (auto const& material: aMaterials)
 	{
 		Material loadedMaterial = Material();
@@ -75,102 +168,174 @@ int SceneObj::loadMaterials(rapidobj::Materials aMaterials)
 		loadedMaterial.setTexture(material.diffuse_texname);
 		loadedMaterial.loadTexture();
 
-		this->materials.push_back(loadedMaterial);
+		this->materials.push_back(std::move(loadedMaterial));
 	}
 	return 0;
 }
 
 
-int SceneObj::loadWavefrontObj()
+int SceneObj::loadWavefrontObj(bool aReload)
 {
+	LoadScratchScope scratch;
 	auto result = rapidobj::ParseFile(this->filepath);
 
 	if (result.error)
 	{
-		throw Error("Unable to load OBJ file '%s': %s", this->filepath, result.error.code.message().c_str());
+		throw Error("Unable to load OBJ file '%s': %s", this->filepath.c_str(), result.error.code.message().c_str());
 	}
 
 	// OBJs may contain non triangle faces, rapidobj will handle this for us
 	rapidobj::Triangulate(result);
 
 	//create materials
-	this->loadMaterials(result.materials);
-	
+	if (!aReload)
+	{
+		this->loadMaterials(result.materials);
+	}
+
+	// faces without a material get a default one, added only if needed
+	size_t const defaultMaterial = result.materials.size();
+	bool defaultMaterialUsed = false;
+	MeshBounds objectBounds;
+
+	this->meshes.clear();
+	this->meshes.reserve(result.shapes.size());
+	std::pmr::vector<size_t> nextTriangle(&load_scratch_arena());
 	for (auto const& shape : result.shapes)
 	{
+		auto const& indices = shape.mesh.indices;
+		auto const& materialIds = shape.mesh.material_ids;
+		size_t const triangleCount = materialIds.size();
+
+		auto material_slot = [&] (size_t aTriangle) {
+			return materialIds[aTriangle] < 0 ? defaultMaterial : size_t(materialIds[aTriangle]);
+		};
+
+		// Counting sort of the triangles by material, so that each material
+		// gets one contiguous range and every array is allocated exactly once.
+		nextTriangle.assign(defaultMaterial + 1, 0);
+		for (size_t i = 0; i < triangleCount; i++)
+		{
+			nextTriangle[material_slot(i)]++;
+		}
+
 		MeshData loadedMesh = MeshData();
-		for (std::size_t i = 0; i < shape.mesh.indices.size(); ++i)
+		size_t first = 0;
+		for (size_t slot = 0; slot <= defaultMaterial; slot++)
 		{
-			auto const& idx = shape.mesh.indices[i];
+			size_t const count = nextTriangle[slot];
+			if (count > 0)
+			{
+				loadedMesh.ranges.push_back({ GLint(3 * first), GLsizei(3 * count), slot });
+				defaultMaterialUsed |= (slot == defaultMaterial);
+			}
+			nextTriangle[slot] = first;
+			first += count;
+		}
+
+		bool const hasTexcoords = std::any_of(indices.begin(), indices.end(), [] (auto const& aIdx) {
+			return aIdx.texcoord_index != -1;
+		});
 
-			loadedMesh.positions.emplace_back(Vec3f{
-				result.attributes.positions[idx.position_index * 3 + 0],
-				result.attributes.positions[idx.position_index * 3 + 1],
-				result.attributes.positions[idx.position_index * 3 + 2]
-				});
+		size_t const vertexCount = 3 * triangleCount;
+		loadedMesh.positions.resize(vertexCount);
+		loadedMesh.normals.resize(vertexCount);
+		if (hasTexcoords) loadedMesh.texcoords.resize(vertexCount);
+		// Just white for each vertex; the material provides the colour
+		loadedMesh.colors.assign(vertexCount, Vec3f{ 1.f, 1.f, 1.f });
 
-			loadedMesh.normals.emplace_back(Vec3f{
-				result.attributes.normals[idx.normal_index * 3 + 0],
-				result.attributes.normals[idx.normal_index * 3 + 1],
-				result.attributes.normals[idx.normal_index * 3 + 2]
-				});
+		for (size_t triangle = 0; triangle < triangleCount; triangle++)
+		{
+			// Always triangles, so the vertices of a face are consecutive
+			size_t const target = 3 * nextTriangle[material_slot(triangle)]++;
 
-			if (idx.texcoord_index != -1)
+			for (size_t corner = 0; corner < 3; corner++)
 			{
-				loadedMesh.texcoords.emplace_back(Vec2f{
-				result.attributes.texcoords[idx.texcoord_index * 2 + 0],
-				result.attributes.texcoords[idx.texcoord_index * 2 + 1]
-				});
+				auto const& idx = indices[3 * triangle + corner];
+				size_t const vertex = target + corner;
+
+				loadedMesh.positions[vertex] = Vec3f{
+					result.attributes.positions[idx.position_index * 3 + 0],
+					result.attributes.positions[idx.position_index * 3 + 1],
+					result.attributes.positions[idx.position_index * 3 + 2]
+				};
+
+				if (idx.normal_index != -1)
+				{
+					loadedMesh.normals[vertex] = Vec3f{
+						result.attributes.normals[idx.normal_index * 3 + 0],
+						result.attributes.normals[idx.normal_index * 3 + 1],
+						result.attributes.normals[idx.normal_index * 3 + 2]
+					};
+				}
+
+				if (hasTexcoords && idx.texcoord_index != -1)
+				{
+					loadedMesh.texcoords[vertex] = Vec2f{
+						result.attributes.texcoords[idx.texcoord_index * 2 + 0],
+						result.attributes.texcoords[idx.texcoord_index * 2 + 1]
+					};
+				}
 			}
+		}
 
-			
+		loadedMesh.size = vertexCount;
+		objectBounds.include(loadedMesh.positions);
+		this->meshes.push_back(std::move(loadedMesh));
+	}
 
+	if (defaultMaterialUsed && !aReload)
+	{
+		this->materials.emplace_back();
+	}
 
-			// Always triangles, so we can find the face index by dividing the vertex index by three
-			auto const& mat = result.materials[shape.mesh.material_ids[i / 3]];
-			// Just replicate the material ambient color for each vertex... 
-			loadedMesh.colors.emplace_back(Vec3f{
-				/*mat.ambient[0],
-				mat.ambient[1],
-				mat.ambient[2]*/
-				1.f, 1.f, 1.f
-				});
-			loadedMesh.material = this->materials[shape.mesh.material_ids[i/3]];
+	this->meshCount = this->meshes.size();
+	this->bounds = objectBounds;
+	this->meshDataResident = true;
 
-		}
-		loadedMesh.size = loadedMesh.positions.size();
-		//loadedMesh.material = this->materials[shape.mesh.material_ids[0]];
-		this->meshes.push_back(loadedMesh);
+	if (this->fakeTexCoords)
+	{
+		this->applyFakeTexCoords();
 	}
-	this->meshCount = this->meshes.size();
+	return 0;
 }
 
-GLuint SceneObj::createVAO(const MeshData aMeshData, std::optional<GLuint> aVAO)
+MeshBuffers SceneObj::createBuffers(const MeshData& aMeshData)
 {
+	MeshBuffers buffers;
+
 	// Simple Mesh Position VBO
-	GLuint meshPositionVBO = 0;
-	glGenBuffers(1, &meshPositionVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, meshPositionVBO);
+	glGenBuffers(1, &buffers.positions);
+	glBindBuffer(GL_ARRAY_BUFFER, buffers.positions);
 	glBufferData(GL_ARRAY_BUFFER, aMeshData.positions.size() * sizeof(Vec3f), aMeshData.positions.data(), GL_STATIC_DRAW);
 
 	// Simple mesh Color VBO
-	GLuint meshColorVBO = 0;
-	glGenBuffers(1, &meshColorVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, meshColorVBO);
+	glGenBuffers(1, &buffers.colors);
+	glBindBuffer(GL_ARRAY_BUFFER, buffers.colors);
 	glBufferData(GL_ARRAY_BUFFER, aMeshData.colors.size() * sizeof(Vec3f), aMeshData.colors.data(), GL_STATIC_DRAW);
 
 	// Normals VBO
-	GLuint meshNormalVBO = 0;
-	glGenBuffers(1, &meshNormalVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, meshNormalVBO);
+	glGenBuffers(1, &buffers.normals);
+	glBindBuffer(GL_ARRAY_BUFFER, buffers.normals);
 	glBufferData(GL_ARRAY_BUFFER, aMeshData.normals.size() * sizeof(Vec3f), aMeshData.normals.data(), GL_STATIC_DRAW);
 	
 	// Texture Coords VBO
-	GLuint meshTextureCoordVBO = 0;
-	glGenBuffers(1, &meshTextureCoordVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, meshTextureCoordVBO);
+	glGenBuffers(1, &buffers.texcoords);
+	glBindBuffer(GL_ARRAY_BUFFER, buffers.texcoords);
 	glBufferData(GL_ARRAY_BUFFER, aMeshData.texcoords.size() * sizeof(Vec2f), aMeshData.texcoords.data(), GL_STATIC_DRAW);
 
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	return buffers;
+}
+
+GLuint SceneObj::createVAO(const MeshData& aMeshData, std::optional<GLuint> aVAO)
+{
+	return createVAO(createBuffers(aMeshData), aVAO);
+}
+
+GLuint SceneObj::createVAO(const MeshBuffers& aBuffers, std::optional<GLuint> aVAO)
+{
 	// Bind VBO into VAO
 	GLuint MeshDataVAO = 0;
 	if (aVAO)
@@ -183,7 +348,7 @@ GLuint SceneObj::createVAO(const MeshData aMeshData, std::optional<GLuint> aVAO)
 		glBindVertexArray(MeshDataVAO);
 	}
 
-	glBindBuffer(GL_ARRAY_BUFFER, meshPositionVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, aBuffers.positions);
 	glVertexAttribPointer(
 		0,						// loc 0 in vert shader
 		3, GL_FLOAT, GL_FALSE,	// 3 floats, not normalized
@@ -192,7 +357,7 @@ GLuint SceneObj::createVAO(const MeshData aMeshData, std::optional<GLuint> aVAO)
 	);
 	glEnableVertexAttribArray(0);
 
-	glBindBuffer(GL_ARRAY_BUFFER, meshColorVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, aBuffers.colors);
 	glVertexAttribPointer(
 		1,						// loc 1 in vert shader
 		3, GL_FLOAT, GL_FALSE,	// 3 floats, not normalized
@@ -201,7 +366,7 @@ GLuint SceneObj::createVAO(const MeshData aMeshData, std::optional<GLuint> aVAO)
 	);
 	glEnableVertexAttribArray(1);
 
-	glBindBuffer(GL_ARRAY_BUFFER, meshNormalVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, aBuffers.normals);
 	glVertexAttribPointer(
 		2,						// loc 2 in vert shader
 		3, GL_FLOAT, GL_FALSE,	// 3 floats, not normalized
@@ -210,7 +375,7 @@ GLuint SceneObj::createVAO(const MeshData aMeshData, std::optional<GLuint> aVAO)
 	);
 	glEnableVertexAttribArray(2);
 
-	glBindBuffer(GL_ARRAY_BUFFER, meshTextureCoordVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, aBuffers.texcoords);
 	glVertexAttribPointer(
 		3,						// loc 3 in vert shader
 		2, GL_FLOAT, GL_FALSE,	// 2 floats, not normalized
@@ -229,6 +394,7 @@ GLuint SceneObj::createVAO(const MeshData aMeshData, std::optional<GLuint> aVAO)
 
 int SceneObj::generateVAOs()
 {
+	this->VAOs.reserve(this->meshes.size());
 	for (auto const& mesh : this->meshes)
 	{
 		this->VAOs.push_back(this->createVAO(mesh));
@@ -243,24 +409,119 @@ int SceneObj::initialise(std::string aPath)
 	// check object not already initialised
 	if (this->initialised) return -1;
 
-	this->filepath = aPath;
+	this->filepath = std::move(aPath);
+	ScopedAllocationReport report(this->filepath.c_str());
+
 	this->loadWavefrontObj();
 	this->generateVAOs();
+	this->applyResidency();
 
 	this->transform = Transform();
 	this->initialised = true;
 	return 0;
 }
 
+void SceneObj::initialiseAsync(std::string aPath, UploadThread& aUploader)
+{
+	// check object not already initialised
+	if (this->initialised) return;
+
+	this->filepath = std::move(aPath);
+	this->transform = Transform();
+
+	// the buffers are only touched by the upload thread until the fence
+	// has passed, and by the main thread after that
+	auto buffers = std::make_shared<std::vector<MeshBuffers>>();
+
+	aUploader.enqueue(
+		[this, buffers] {
+			this->loadWavefrontObj();
+			for (auto const& mesh : this->meshes)
+			{
+				buffers->push_back(createBuffers(mesh));
+			}
+		},
+		[this, buffers] {
+			// nothing to draw if loading failed part way
+			if (buffers->empty() || buffers->size() != this->meshes.size()) return;
+
+			for (auto const& meshBuffers : *buffers)
+			{
+				this->VAOs.push_back(createVAO(meshBuffers));
+			}
+			this->applyResidency();
+			this->initialised = true;
+		}
+	);
+}
+
 int SceneObj::updateVAO()
 {
+	if (!this->meshDataResident)
+	{
+		this->loadWavefrontObj(true);
+	}
+
 	for(int i = 0; i < this->meshCount; i++)
 	{
 		this->createVAO(this->meshes[i], this->VAOs[i]);
 	}
+
+	this->applyResidency();
 	return 0;
 }
 
+void SceneObj::setResidency(MESH_RESIDENCY aResidency)
+{
+	this->residency = aResidency;
+	if (!this->initialised) return;
+
+	// bring back whatever the new policy keeps but the old one released
+	bool const needsData = aResidency == RESIDENCY_KEEP || (aResidency == RESIDENCY_BOUNDS_ONLY && !this->bounds);
+	if (!this->meshDataResident && needsData)
+	{
+		this->loadWavefrontObj(true);
+	}
+
+	this->applyResidency();
+}
+
+void SceneObj::applyResidency()
+{
+	if (this->residency == RESIDENCY_KEEP) return;
+
+	// swap with empty vectors, as clear() keeps the capacity
+	for (auto& mesh : this->meshes)
+	{
+		std::vector<Vec3f>().swap(mesh.positions);
+		std::vector<Vec3f>().swap(mesh.colors);
+		std::vector<Vec3f>().swap(mesh.normals);
+		std::vector<Vec2f>().swap(mesh.texcoords);
+	}
+	this->meshDataResident = false;
+
+	if (this->residency == RESIDENCY_DROP)
+	{
+		this->bounds.reset();
+	}
+}
+
+size_t SceneObj::residentBytes() const
+{
+	// the ranges and vertex counts are needed for drawing, so always stay
+	size_t bytes = vector_bytes(this->meshes);
+	for (auto const& mesh : this->meshes)
+	{
+		bytes += vector_bytes(mesh.positions) + vector_bytes(mesh.colors) + vector_bytes(mesh.normals)
+			+ vector_bytes(mesh.texcoords) + vector_bytes(mesh.ranges);
+	}
+	if (this->bounds)
+	{
+		bytes += sizeof(MeshBounds);
+	}
+	return bytes;
+}
+
 int SceneObj::draw(const Mat44f aProjCamera)
 {
 	if (this->initialised == false) return -1;
@@ -268,33 +529,116 @@ int SceneObj::draw(const Mat44f aProjCamera)
 	Mat44f modelTransform = this->transform.matrix();
 	Mat44f finalTransform = aProjCamera * modelTransform;
 
-	glUniformMatrix4fv(
-		0, 1,
+	gl_state().uniformMatrix4fv(
+		0,
 		GL_TRUE, finalTransform.v
 	);
 
-	glUniformMatrix4fv(
-		1, 1,
+	gl_state().uniformMatrix4fv(
+		1,
 		GL_TRUE, modelTransform.v
 	);
 
 	for(int i = 0; i < this->meshCount; i++)
 	{
-		this->meshes[i].material.useMaterial();
+		gl_state().bindVertexArray(this->VAOs[i]);
 
-		glBindVertexArray(this->VAOs[i]);
-		glDrawArrays(GL_TRIANGLES, 0, this->meshes[i].size);
+		for (auto const& range : this->meshes[i].ranges)
+		{
+			this->materials[range.materialIndex].useMaterial();
+			glDrawArrays(GL_TRIANGLES, range.first, range.count);
+		}
 	}
-	
-
-	glBindVertexArray(0);
 
 	return 0;
 }
 
+void SceneObj::drawInstanced(GLsizei aInstances)
+{
+	if (this->initialised == false) return;
+
+	for(size_t i = 0; i < this->meshCount; i++)
+	{
+		gl_state().bindVertexArray(this->VAOs[i]);
+
+		for (auto const& range : this->meshes[i].ranges)
+		{
+			this->materials[range.materialIndex].useMaterial();
+			glDrawArraysInstanced(GL_TRIANGLES, range.first, range.count, aInstances);
+		}
+	}
+}
+
+void SceneObj::submit(RenderQueue& aQueue, GLuint aProgram)
+{
+	submit(aQueue, aProgram, this->transform.matrix());
+}
+
+void SceneObj::submit(RenderQueue& aQueue, GLuint aProgram, const Mat44f& aModel)
+{
+	if (this->initialised == false) return;
+
+	DrawItem item;
+	item.program = aProgram;
+	item.model = aModel;
+
+	for(size_t i = 0; i < this->meshCount; i++)
+	{
+		item.vertexArray = this->VAOs[i];
+
+		for (auto const& range : this->meshes[i].ranges)
+		{
+			auto const& material = this->materials[range.materialIndex];
+			item.texture = material.texture();
+			item.textureLayer = material.layer();
+			item.material = material.packed();
+			item.first = range.first;
+			item.count = range.count;
+
+			aQueue.submit(item);
+		}
+	}
+}
+
+void SceneObj::drawItems(GLuint aProgram, std::vector<DrawItem>& aItems) const
+{
+	if (this->initialised == false) return;
+
+	DrawItem item;
+	item.program = aProgram;
+
+	for(size_t i = 0; i < this->meshCount; i++)
+	{
+		item.vertexArray = this->VAOs[i];
+
+		for (auto const& range : this->meshes[i].ranges)
+		{
+			auto const& material = this->materials[range.materialIndex];
+			item.texture = material.texture();
+			item.textureLayer = material.layer();
+			item.material = material.packed();
+			item.first = range.first;
+			item.count = range.count;
+
+			aItems.push_back(item);
+		}
+	}
+}
+
 void SceneObj::forceFakeTexCoords()
 {
-	for(auto & [positions, colors, normals, texcoords, material, size] : this->meshes)
+	this->fakeTexCoords = true;
+
+	// otherwise applied when the data is next read from the file
+	if (this->meshDataResident)
+	{
+		this->applyFakeTexCoords();
+	}
+}
+
+void SceneObj::applyFakeTexCoords()
+{
+	for(auto & [positions, colors, normals, texcoords, ranges, size] : this->meshes)
 	{
 		texcoords.clear();
 		for (int j = 0; j < size; j++)
@@ -311,15 +655,23 @@ void SceneObj::forceFakeTexCoords()
 void SceneObj::forceTexture(std::string aPath)
 {
 
-	for (int i = 0; i < this->meshCount; i++)
+	for (auto& material : this->materials)
 	{
-		this->meshes[i].material.setTexture(aPath);
-		this->meshes[i].material.loadTexture();
+		material.setTexture(aPath);
+		material.loadTexture();
 	}
 
 	this->updateVAO();
 }
 
+void SceneObj::forceTextureLayer(GLuint aTextureArray, GLint aLayer)
+{
+	for (auto& material : this->materials)
+	{
+		material.setTextureLayer(aTextureArray, aLayer);
+	}
+}
+
 
 int initComplexObject(ComplexSceneObject *aObject, char const* aPath)
 {
@@ -329,6 +681,8 @@ int initComplexObject(ComplexSceneObject *aObject, char const* aPath)
 		return -1;
 	}
 
+	ScopedAllocationReport report(aPath);
+
 	// load object from path;
 	aObject->object.filepath = aPath;
 	try
@@ -345,10 +699,12 @@ int initComplexObject(ComplexSceneObject *aObject, char const* aPath)
 	aObject->object.rotation = {0.f, 0.f, 0.f};
 	aObject->object.scaling = {1.f, 1.f, 1.f};
 
+	aObject->VAOs.reserve(aObject->meshes.size());
 	for (auto const& mesh : aObject->meshes)
 	{
 		aObject->VAOs.push_back(create_vao(mesh));
 	}
+	apply_complex_object_residency_(*aObject);
 
 	aObject->objectCount = aObject->meshes.size();
 
@@ -359,10 +715,27 @@ int initComplexObject(ComplexSceneObject *aObject, char const* aPath)
 
 void updateComplexObject(ComplexSceneObject* aObject)
 {
+	bool const released = std::any_of(aObject->meshes.begin(), aObject->meshes.end(), simple_mesh_released_);
+	if (released)
+	{
+		aObject->meshes = load_wavefront_multi_obj(aObject->object.filepath);
+	}
+
 	for(int i = 0; i < aObject->objectCount; i++)
 	{
 		create_vao(aObject->meshes[i], aObject->VAOs[i]);
 	}
+	apply_complex_object_residency_(*aObject);
+}
+
+size_t complexObjectResidentBytes(const ComplexSceneObject* aObject)
+{
+	size_t bytes = vector_bytes(aObject->meshes);
+	for (auto const& mesh : aObject->meshes)
+	{
+		bytes += simple_mesh_bytes_(mesh);
+	}
+	return bytes + (aObject->object.bounds ? sizeof(MeshBounds) : 0);
 }
 
 void drawComplexObject(const ComplexSceneObject* aObject, const Mat44f projCamera)
@@ -374,22 +747,39 @@ void drawComplexObject(const ComplexSceneObject* aObject, const Mat44f projCamer
 	Mat44f finalTransform = projCamera * modelTransform;
 	Mat44f secondFinalTransform = projCamera * modelTransform * make_translation({1.f, 1.f, 1.f});
 
-	glUniformMatrix4fv(
-		0, 1,
+	gl_state().uniformMatrix4fv(
+		0,
 		GL_TRUE, finalTransform.v
 	);
 
-	glUniformMatrix4fv(
-		1, 1,
+	gl_state().uniformMatrix4fv(
+		1,
 		GL_TRUE, modelTransform.v
 	);
 
 	for(int i = 0; i < aObject->objectCount; i++)
 	{
-		glBindVertexArray(aObject->VAOs[i]);
+		gl_state().bindVertexArray(aObject->VAOs[i]);
 		glDrawArrays(GL_TRIANGLES, 0, aObject->meshes[i].size);
 	}
-	
+}
 
-	glBindVertexArray(0);
+void submitComplexObject(const ComplexSceneObject* aObject, RenderQueue& aQueue, GLuint aProgram, GLuint aTexture, const Mat44f& aMaterial, GLint aTextureLayer)
+{
+	if (aObject->object._initialised == false) return;
+
+	DrawItem item;
+	item.program = aProgram;
+	item.texture = aTexture;
+	item.textureLayer = aTextureLayer;
+	item.model = object_model_transform_(aObject->object);
+	item.material = aMaterial;
+
+	for(size_t i = 0; i < aObject->objectCount; i++)
+	{
+		item.vertexArray = aObject->VAOs[i];
+		item.count = GLsizei(aObject->meshes[i].size);
+
+		aQueue.submit(item);
+	}
 }
\ No newline at end of file
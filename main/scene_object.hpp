@@ -4,9 +4,21 @@
 #include "simple_mesh.hpp"
 #include "mesh_data.hpp"
 #include "transform.hpp"
+#include "render_queue.hpp"
+#include "upload_thread.hpp"
 #include "../vmlib/mat44.hpp"
 #include "rapidobj/rapidobj.hpp"
 
+// vertex buffers of one mesh; unlike VAOs these can be created on any
+// context that shares objects with the main one
+struct MeshBuffers
+{
+	GLuint positions = 0;
+	GLuint colors = 0;
+	GLuint normals = 0;
+	GLuint texcoords = 0;
+};
+
 class SceneObj
 {
 	std::string filepath;
@@ -18,9 +30,22 @@ class SceneObj
 
 	bool initialised = false;
 
-	int loadMaterials(rapidobj::Materials);
-	int loadWavefrontObj();
-	GLuint createVAO(MeshData aMeshData, std::optional<GLuint> aVAO = std::nullopt);
+	MESH_RESIDENCY residency = RESIDENCY_KEEP;
+	// false once the vertex arrays in meshes have been released
+	bool meshDataResident = false;
+	std::optional<MeshBounds> bounds;
+	bool fakeTexCoords = false;
+
+	int loadMaterials(const rapidobj::Materials& aMaterials);
+	// aReload reads the vertex data again for an object that is already
+	// loaded, leaving its materials alone
+	int loadWavefrontObj(bool aReload = false);
+	void applyResidency();
+	void applyFakeTexCoords();
+	static MeshBuffers createBuffers(const MeshData& aMeshData);
+	// main context only
+	static GLuint createVAO(const MeshBuffers& aBuffers, std::optional<GLuint> aVAO = std::nullopt);
+	GLuint createVAO(const MeshData& aMeshData, std::optional<GLuint> aVAO = std::nullopt);
 	int generateVAOs();
 
 protected:
@@ -28,13 +53,38 @@ protected:
 
 public:
 	int initialise(std::string aPath);
+	// load and upload on aUploader's thread; the object is not drawn until
+	// aUploader.poll() has completed it, and must not move until then
+	void initialiseAsync(std::string aPath, UploadThread& aUploader);
+	bool isInitialised() const { return initialised; }
+	// takes effect after the upload, or straight away if already uploaded
+	void setResidency(MESH_RESIDENCY aResidency);
+	MESH_RESIDENCY getResidency() const { return residency; }
+	// CPU memory held for the meshes (vertex arrays, ranges and bounds)
+	size_t residentBytes() const;
+	// object space bounds; empty if the residency policy dropped them
+	std::optional<MeshBounds> getBounds() const { return bounds; }
+	// re-uploads the vertex data, reading the file again if it was released
 	int updateVAO();
 	void scale(Vec3f aVec) {transform.setScale(aVec);}
 	void move(Vec3f aVec) {transform.setPosition(aVec);}
 	void rotate(Vec3f aVec) {transform.setRotation(aVec);}
 	int draw(Mat44f aProjCamera);
+	// draw aInstances copies of every mesh with its material; the program
+	// must place the instances itself
+	void drawInstanced(GLsizei aInstances);
+	// queue the meshes for drawing with aProgram, using their own materials
+	void submit(RenderQueue& aQueue, GLuint aProgram);
+	// as above, but placed with aModel instead of the object's own transform
+	void submit(RenderQueue& aQueue, GLuint aProgram, const Mat44f& aModel);
+	Mat44f modelMatrix() { return transform.matrix(); }
+	// the draws submit() would queue, without model matrices, appended to
+	// aItems (e.g. for an EntityStore render component)
+	void drawItems(GLuint aProgram, std::vector<DrawItem>& aItems) const;
+	// derive texture coordinates from the positions; kept across reloads
 	void forceFakeTexCoords();
 	void forceTexture(std::string aPath);
+	void forceTextureLayer(GLuint aTextureArray, GLint aLayer);
 };
 
 typedef struct _sceneObject
@@ -48,6 +98,10 @@ typedef struct _sceneObject
 
 	bool _initialised = false;
 	GLuint VAO;
+
+	// applied after initObject() and each updateObject()
+	MESH_RESIDENCY residency = RESIDENCY_KEEP;
+	std::optional<MeshBounds> bounds;
 } SceneObject;
 
 typedef struct _complexSceneObject
@@ -62,19 +116,35 @@ typedef struct _complexSceneObject
 // load object and create VAO, must be called before sending to GPU
 int initObject(SceneObject *aObject, char const* aPath);
 
-// update VAO data with modified mesh data
+// update VAO data with modified mesh data, reloading it from the file if
+// the residency policy released it
 void updateObject(SceneObject* aObject);
 
+// CPU memory held for the mesh
+size_t objectResidentBytes(const SceneObject* aObject);
+
 // send object data to GPU, must call initObject() before this can be used, must come after glUseProgram()
 void drawObject(const SceneObject* aObject, const Mat44f projCamera);
 
+// queue object for drawing; these objects have no material of their own
+// aTextureLayer >= 0 selects a layer of aTexture, which is then a texture array
+void submitObject(const SceneObject* aObject, RenderQueue& aQueue, GLuint aProgram, GLuint aTexture, const Mat44f& aMaterial, GLint aTextureLayer = -1);
+
 // load object and create VAO, must be called before sending to GPU
+// (aObject->object.residency applies to all meshes)
 int initComplexObject(ComplexSceneObject *aObject, char const* aPath);
 
-// update VAO data with modified mesh data
+// update VAO data with modified mesh data, reloading it from the file if
+// the residency policy released it
 void updateComplexObject(ComplexSceneObject* aObject);
 
+// CPU memory held for the meshes
+size_t complexObjectResidentBytes(const ComplexSceneObject* aObject);
+
 // send object data to GPU, must call initObject() before this can be used, must come after glUseProgram()
 void drawComplexObject(const ComplexSceneObject* aObject, const Mat44f projCamera);
 
+// queue object for drawing; these objects have no material of their own
+void submitComplexObject(const ComplexSceneObject* aObject, RenderQueue& aQueue, GLuint aProgram, GLuint aTexture, const Mat44f& aMaterial, GLint aTextureLayer = -1);
+
 #endif//SCENE_OBJECT_HEADER_FILE
\ No newline at end of file
@@ -13,7 +13,7 @@ struct ScreenshotData
 	GLsizei channels, stride;
 };
 
-void saveScreenshot(ScreenshotData aData, std::string aFilepath)
+void saveScreenshot(const ScreenshotData& aData, const std::string& aFilepath)
 {
 
 
@@ -0,0 +1,127 @@
+#include "shader_watcher.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#if defined(__linux__)
+#	include <unistd.h>
+#	include <sys/inotify.h>
+#endif
+
+namespace
+{
+	bool is_shader_source_(std::filesystem::path const& aPath)
+	{
+		auto const ext = aPath.extension();
+		return ext == ".vert" || ext == ".frag" || ext == ".comp";
+	}
+}
+
+#if defined(__linux__)
+
+ShaderWatcher::ShaderWatcher(std::string aDirectory)
+	: directory(std::move(aDirectory))
+{
+	inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotifyFd < 0)
+	{
+		printf("Warning: inotify unavailable, shader hot-reload disabled\n");
+		return;
+	}
+
+	// Editors commonly save by writing a temporary file and renaming it over
+	// the original, so IN_MOVED_TO is needed in addition to IN_CLOSE_WRITE.
+	watchFd = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+	if (watchFd < 0)
+	{
+		printf("Warning: unable to watch '%s', shader hot-reload disabled\n", directory.c_str());
+	}
+}
+
+ShaderWatcher::~ShaderWatcher()
+{
+	if (inotifyFd >= 0)
+	{
+		close(inotifyFd);
+	}
+}
+
+bool ShaderWatcher::poll()
+{
+	if (watchFd < 0) return false;
+
+	bool changed = false;
+
+	alignas(inotify_event) char buffer[4096];
+	for (;;)
+	{
+		auto const bytes = read(inotifyFd, buffer, sizeof(buffer));
+		if (bytes <= 0) break; // EAGAIN: no more events queued
+
+		for (ssize_t offset = 0; offset < bytes; )
+		{
+			inotify_event event;
+			std::memcpy(&event, buffer + offset, sizeof(event));
+
+			if (event.len > 0 && is_shader_source_(buffer + offset + sizeof(inotify_event)))
+			{
+				changed = true;
+			}
+
+			offset += sizeof(inotify_event) + event.len;
+		}
+	}
+
+	return changed;
+}
+
+#else // ~ __linux__
+
+ShaderWatcher::ShaderWatcher(std::string aDirectory)
+	: directory(std::move(aDirectory))
+	, lastScan(Clock::now())
+{
+	scan();
+}
+
+ShaderWatcher::~ShaderWatcher() = default;
+
+bool ShaderWatcher::scan()
+{
+	std::error_code ec;
+	bool changed = false;
+
+	std::vector<std::pair<std::filesystem::path, std::filesystem::file_time_type>> current;
+	current.reserve(sources.size());
+
+	for (auto const& entry : std::filesystem::directory_iterator(directory, ec))
+	{
+		if (!is_shader_source_(entry.path())) continue;
+
+		auto const time = std::filesystem::last_write_time(entry.path(), ec);
+		if (ec) continue;
+
+		current.emplace_back(entry.path(), time);
+	}
+
+	if (current != sources)
+	{
+		changed = !sources.empty();
+		sources = std::move(current);
+	}
+
+	return changed;
+}
+
+bool ShaderWatcher::poll()
+{
+	// stat()-ing every source each frame is wasteful; a few times per second
+	// is plenty for interactive editing
+	auto const now = Clock::now();
+	if (now - lastScan < std::chrono::milliseconds(250)) return false;
+
+	lastScan = now;
+	return scan();
+}
+
+#endif // ~ __linux__
@@ -0,0 +1,39 @@
+#ifndef SHADER_WATCHER_HEADER_FILE
+#define SHADER_WATCHER_HEADER_FILE
+
+#include <string>
+#include <vector>
+#include <filesystem>
+
+#include "defaults.hpp"
+
+// Watches a directory for changes to shader sources (*.vert, *.frag,
+// *.comp). On Linux this uses inotify; elsewhere the modification times of
+// the sources are compared at most a few times per second. poll() never
+// blocks, so it can be called once per frame.
+class ShaderWatcher
+{
+	std::string directory;
+
+#if defined(__linux__)
+	int inotifyFd = -1;
+	int watchFd = -1;
+#else
+	std::vector<std::pair<std::filesystem::path, std::filesystem::file_time_type>> sources;
+	Clock::time_point lastScan;
+
+	bool scan();
+#endif
+
+public:
+	explicit ShaderWatcher(std::string aDirectory);
+	~ShaderWatcher();
+
+	ShaderWatcher(const ShaderWatcher&) = delete;
+	ShaderWatcher& operator=(const ShaderWatcher&) = delete;
+
+	// returns true if any shader source was modified since the last call
+	bool poll();
+};
+
+#endif//SHADER_WATCHER_HEADER_FILE
@@ -1,12 +1,5 @@
 #include "simple_mesh.hpp"
 
-SimpleMeshData concatenate( SimpleMeshData aM, SimpleMeshData const& aN )
-{
-	aM.positions.insert( aM.positions.end(), aN.positions.begin(), aN.positions.end() );
-	aM.colors.insert( aM.colors.end(), aN.colors.begin(), aN.colors.end() );
-	return aM;
-}
-
 // VBO for positions and VBO for colours, combined into one VAO that we return
 GLuint create_vao( SimpleMeshData const& aMeshData, std::optional<GLuint> VAO)
 {
@@ -30,8 +30,6 @@ struct SimpleMeshData
 	size_t size;
 };
 
-SimpleMeshData concatenate( SimpleMeshData, SimpleMeshData const& );
-
 GLuint create_vao( SimpleMeshData const&, std::optional<GLuint> = std::nullopt );
 
 #endif // SIMPLE_MESH_HPP_C6B749D6_C83B_434C_9E58_F05FC27FEFC9
@@ -0,0 +1,154 @@
+#include "simulation.hpp"
+
+#include <chrono>
+
+#include "../vmlib/constants.hpp"
+
+SceneSimulation::SceneSimulation(PathObj& aF1, AnimationObj& aArm2, AnimationObj& aMuscleCar, Vec3f aCameraPosition)
+	: f1(aF1), arm2(aArm2), muscleCar(aMuscleCar), cameraPosition(aCameraPosition)
+{
+}
+
+void SceneSimulation::step(const SimulationInput& aInput, float aDt, FrameSnapshot& aSnapshot)
+{
+	auto const stepStart = Clock::now();
+
+	if (!aInput.animationPause) {
+		animationTime += aDt * float(aInput.animationFactor);
+	}
+
+	if (aInput.cameraScripted) {
+		cameraPosition = aInput.scriptedCameraPosition;
+	}
+
+	// flying
+	cameraControl const* camera = &aInput.camera;
+	float const distance = aDt * aInput.flightSpeed;
+	if (camera->actionForwards)		cameraPosition += distance * cam_forwards(camera);
+	if (camera->actionBackwards)	cameraPosition += distance * cam_backwards(camera);
+	if (camera->actionLeft)			cameraPosition += distance * cam_left(camera);
+	if (camera->actionRight)		cameraPosition += distance * cam_right(camera);
+	if (camera->actionUp)			cameraPosition += distance * cam_up(camera);
+	if (camera->actionDown)			cameraPosition += distance * cam_down(camera);
+
+	if (animationChannelsBuilt != aInput.extraAnimationChannels)
+	{
+		animationSystem.clear();
+		arm2Animation = animationSystem.add(arm2.channel());
+		muscleCarAnimation = animationSystem.add(muscleCar.channel());
+
+		// spread the extra channels over all easing curves and phases
+		for (int i = 0; i < aInput.extraAnimationChannels; i++)
+		{
+			AnimationChannel channel;
+			channel.positionEnd = { float(i % 100), 0.f, float(i / 100) };
+			channel.rotationEnd = make_quat_rotation_y(0.5f * kPi);
+			channel.duration = float(100 + i % 300) / kAnimationStepsPerSecond;
+			channel.interpolationStyle = INTERPOLATION_STYLE(size_t(i) % kInterpolationStyleCount);
+			channel.animationStyle = (i % 2) ? BOUNCE : REPEAT;
+			animationSystem.add(channel);
+		}
+		animationChannelsBuilt = aInput.extraAnimationChannels;
+	}
+
+	{
+		auto const animationStart = Clock::now();
+		animationSystem.update(animationTime);
+		aSnapshot.animationUpdateMs = std::chrono::duration<float, std::milli>(Clock::now() - animationStart).count();
+	}
+
+	f1.updatePath(animationTime);
+	arm2.applyAnimation(animationSystem.get(arm2Animation));
+	muscleCar.applyAnimation(animationSystem.get(muscleCarAnimation));
+
+	aSnapshot.sequence = ++sequence;
+
+	aSnapshot.cameraPosition = cameraPosition;
+	aSnapshot.cameraTheta = camera->theta;
+	aSnapshot.cameraPhi = camera->phi;
+	// move camera forwards slightly when passed to renderer to enhance specular lighting
+	aSnapshot.lightingCameraPosition = cameraPosition + cam_forwards(camera) * 3.0f;
+
+	for (size_t i = 0; i < kSimulationLightCount; i++)
+	{
+		aSnapshot.lights[i] = aInput.lights[i];
+	}
+
+	aSnapshot.animationTime = animationTime;
+	aSnapshot.f1Model = f1.modelMatrix();
+	aSnapshot.arm2Model = arm2.modelMatrix();
+	aSnapshot.muscleCarModel = muscleCar.modelMatrix();
+
+	aSnapshot.animationChannels = animationSystem.size();
+	aSnapshot.simulationMs = std::chrono::duration<float, std::milli>(Clock::now() - stepStart).count();
+}
+
+SimulationThread::SimulationThread(SceneSimulation& aSimulation)
+	: simulation(aSimulation)
+{
+	thread = std::thread([this] { run(); });
+}
+
+SimulationThread::~SimulationThread()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+	}
+	wake.notify_all();
+	thread.join();
+}
+
+void SimulationThread::request(const SimulationInput& aInput)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		input = aInput;
+		requested++;
+	}
+	wake.notify_all();
+}
+
+const FrameSnapshot& SimulationThread::latest()
+{
+	if (!snapshots.acquire() && snapshots.front().sequence == 0)
+	{
+		// nothing has been simulated yet; wait for the first step
+		std::unique_lock<std::mutex> lock(mutex);
+		wake.wait(lock, [this] { return snapshots.acquire(); });
+	}
+	return snapshots.front();
+}
+
+void SimulationThread::run()
+{
+	std::uint64_t stepped = 0;
+	auto lastStep = Clock::now();
+
+	while (true)
+	{
+		SimulationInput stepInput;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [&] { return quit || requested != stepped; });
+			if (quit) return;
+
+			stepInput = input;
+			stepped = requested;
+		}
+
+		auto const now = Clock::now();
+		float const dt = stepInput.timeStep > 0.f ? stepInput.timeStep : std::chrono::duration_cast<Secondsf>(now - lastStep).count();
+		lastStep = now;
+
+		simulation.step(stepInput, dt, snapshots.back());
+
+		{
+			// publish under the lock so that a consumer waiting in latest()
+			// cannot miss the wakeup
+			std::lock_guard<std::mutex> lock(mutex);
+			snapshots.publish();
+		}
+		wake.notify_all();
+	}
+}
@@ -0,0 +1,121 @@
+#ifndef SIMULATION_HEADER_FILE
+#define SIMULATION_HEADER_FILE
+
+#include <mutex>
+#include <thread>
+#include <cstdint>
+#include <condition_variable>
+
+#include "../vmlib/mat44.hpp"
+
+#include "defaults.hpp"
+#include "camera.hpp"
+#include "point_light.hpp"
+#include "path_object.hpp"
+#include "animation_system.hpp"
+#include "triple_buffer.hpp"
+
+constexpr size_t kSimulationLightCount = 3;
+
+// Everything the simulation needs from input handling and the GUI. Copied
+// once per frame, so the simulation never reads state that the main thread
+// is changing.
+struct SimulationInput
+{
+	cameraControl camera{};
+	float flightSpeed = 0.f;
+
+	int animationFactor = 1;
+	bool animationPause = false;
+	int extraAnimationChannels = 0;
+
+	// seconds per step on a SimulationThread; 0 measures the time between
+	// steps instead
+	float timeStep = 0.f;
+	// replaces the flown camera position, e.g. on a scripted path
+	bool cameraScripted = false;
+	Vec3f scriptedCameraPosition{};
+
+	pointLight lights[kSimulationLightCount]{};
+};
+
+// Immutable result of one simulation step: all the scene state that
+// rendering needs.
+struct FrameSnapshot
+{
+	std::uint64_t sequence = 0;
+
+	Vec3f cameraPosition{};
+	float cameraTheta = 0.f, cameraPhi = 0.f;
+	// position passed to the shaders for specular lighting
+	Vec3f lightingCameraPosition{};
+
+	pointLight lights[kSimulationLightCount]{};
+
+	float animationTime = 0.f;
+	Mat44f f1Model = kIdentity44f;
+	Mat44f arm2Model = kIdentity44f;
+	Mat44f muscleCarModel = kIdentity44f;
+
+	size_t animationChannels = 0;
+	float animationUpdateMs = 0.f;
+	float simulationMs = 0.f;
+};
+
+// Camera integration and animation of the scene. The animated objects are
+// only written to by step(); rendering must take their transforms from the
+// snapshot instead of reading the objects.
+class SceneSimulation
+{
+	PathObj& f1;
+	AnimationObj& arm2;
+	AnimationObj& muscleCar;
+
+	AnimationSystem animationSystem;
+	AnimationHandle arm2Animation = 0, muscleCarAnimation = 0;
+	int animationChannelsBuilt = -1;
+
+	Vec3f cameraPosition;
+	float animationTime = 0.f;
+	std::uint64_t sequence = 0;
+
+public:
+	SceneSimulation(PathObj& aF1, AnimationObj& aArm2, AnimationObj& aMuscleCar, Vec3f aCameraPosition);
+
+	// advance by aDt seconds and write the new state to aSnapshot
+	void step(const SimulationInput& aInput, float aDt, FrameSnapshot& aSnapshot);
+};
+
+// Runs a SceneSimulation on its own thread, one step per request(), so that
+// simulating the next frame overlaps with rendering the current one. The
+// results are handed over through a triple buffer; the renderer always
+// takes the latest complete snapshot.
+class SimulationThread
+{
+	SceneSimulation& simulation;
+	TripleBuffer<FrameSnapshot> snapshots;
+
+	std::mutex mutex;
+	std::condition_variable wake;
+	SimulationInput input;
+	std::uint64_t requested = 0;
+	bool quit = false;
+
+	std::thread thread;
+
+	void run();
+
+public:
+	explicit SimulationThread(SceneSimulation& aSimulation);
+	~SimulationThread();
+
+	SimulationThread(const SimulationThread&) = delete;
+	SimulationThread& operator=(const SimulationThread&) = delete;
+
+	// hand over the input for the next step and let the thread run it
+	void request(const SimulationInput& aInput);
+	// latest snapshot; blocks only until the very first one exists
+	const FrameSnapshot& latest();
+};
+
+#endif//SIMULATION_HEADER_FILE
@@ -0,0 +1,96 @@
+#include "spline.hpp"
+
+#include <algorithm>
+
+void CatmullRomSpline::build(const std::vector<Vec3f>& aPoints, bool aClosed)
+{
+	controls.clear();
+	arcLength.clear();
+
+	size_t const count = aPoints.size();
+	if (count < 2) return;
+
+	// neighbour of point i, with the ends of an open curve extended by
+	// reflection
+	auto point = [&] (std::ptrdiff_t aIndex) -> Vec3f {
+		std::ptrdiff_t const n = std::ptrdiff_t(count);
+		if (aClosed) return aPoints[size_t(((aIndex % n) + n) % n)];
+		if (aIndex < 0) return 2.f * aPoints[0] - aPoints[1];
+		if (aIndex >= n) return 2.f * aPoints[count - 1] - aPoints[count - 2];
+		return aPoints[size_t(aIndex)];
+	};
+
+	size_t const segments = aClosed ? count : count - 1;
+	controls.reserve(segments * 3 + 1);
+
+	for (size_t i = 0; i < segments; i++)
+	{
+		std::ptrdiff_t const index = std::ptrdiff_t(i);
+		Vec3f const p0 = point(index - 1);
+		Vec3f const p1 = point(index);
+		Vec3f const p2 = point(index + 1);
+		Vec3f const p3 = point(index + 2);
+
+		// uniform Catmull-Rom to Bezier
+		controls.push_back(p1);
+		controls.push_back(p1 + (p2 - p0) / 6.f);
+		controls.push_back(p2 - (p3 - p1) / 6.f);
+	}
+	controls.push_back(point(std::ptrdiff_t(segments)));
+
+	arcLength.reserve(segments * kSamplesPerSegment + 1);
+	arcLength.push_back(0.f);
+
+	Vec3f previous = controls.front();
+	for (size_t segment = 0; segment < segments; segment++)
+	{
+		for (size_t sample = 1; sample <= kSamplesPerSegment; sample++)
+		{
+			Vec3f const current = position(segment, float(sample) / float(kSamplesPerSegment));
+			arcLength.push_back(arcLength.back() + ::length(current - previous));
+			previous = current;
+		}
+	}
+}
+
+Vec3f CatmullRomSpline::position(size_t aSegment, float aU) const
+{
+	Vec3f const* b = &controls[aSegment * 3];
+	float const v = 1.f - aU;
+
+	return (v * v * v) * b[0]
+		+ (3.f * v * v * aU) * b[1]
+		+ (3.f * v * aU * aU) * b[2]
+		+ (aU * aU * aU) * b[3];
+}
+
+Vec3f CatmullRomSpline::tangent(size_t aSegment, float aU) const
+{
+	Vec3f const* b = &controls[aSegment * 3];
+	float const v = 1.f - aU;
+
+	return (3.f * v * v) * (b[1] - b[0])
+		+ (6.f * v * aU) * (b[2] - b[1])
+		+ (3.f * aU * aU) * (b[3] - b[2]);
+}
+
+void CatmullRomSpline::sample(float aDistance, Vec3f& aPosition, Vec3f& aTangent) const
+{
+	float const distance = std::clamp(aDistance, 0.f, length());
+
+	// first sample at or past the distance
+	auto const next = std::lower_bound(arcLength.begin() + 1, arcLength.end() - 1, distance);
+	size_t const index = size_t(next - arcLength.begin()) - 1;
+
+	float const span = arcLength[index + 1] - arcLength[index];
+	float const fraction = span > 0.f ? (distance - arcLength[index]) / span : 0.f;
+
+	size_t const segment = index / kSamplesPerSegment;
+	float const u = (float(index % kSamplesPerSegment) + fraction) / float(kSamplesPerSegment);
+
+	aPosition = position(segment, u);
+
+	Vec3f const direction = tangent(segment, u);
+	float const directionLength = ::length(direction);
+	aTangent = directionLength > 0.f ? direction / directionLength : Vec3f{ 0.f, 0.f, 1.f };
+}
@@ -0,0 +1,46 @@
+#ifndef SPLINE_HEADER_FILE
+#define SPLINE_HEADER_FILE
+
+#include <vector>
+
+#include "../vmlib/vec3.hpp"
+
+// Catmull-Rom spline through a list of points, stored as one cubic Bezier
+// per segment. An arc-length table (a few samples per segment) maps distance
+// along the curve back to the curve parameter, so the curve can be travelled
+// at constant speed; lookups are a binary search, O(log n) in the number of
+// points.
+class CatmullRomSpline
+{
+public:
+	static constexpr size_t kSamplesPerSegment = 8;
+
+private:
+	// 3 * segments + 1 Bezier control points; segment i uses [3i, 3i + 3]
+	std::vector<Vec3f> controls;
+	// arc length at each sample, kSamplesPerSegment per segment plus the end
+	std::vector<float> arcLength;
+
+public:
+	// aClosed connects the last point back to the first. Needs at least two
+	// points; with fewer the spline is empty.
+	void build(const std::vector<Vec3f>& aPoints, bool aClosed);
+
+	bool empty() const { return controls.empty(); }
+	size_t segmentCount() const { return controls.empty() ? 0 : (controls.size() - 1) / 3; }
+	float length() const { return arcLength.empty() ? 0.f : arcLength.back(); }
+
+	// raw tables, e.g. for evaluation on the GPU
+	const std::vector<Vec3f>& bezierControls() const { return controls; }
+	const std::vector<float>& arcLengths() const { return arcLength; }
+
+	Vec3f position(size_t aSegment, float aU) const;
+	// derivative with respect to the segment parameter (not normalised)
+	Vec3f tangent(size_t aSegment, float aU) const;
+
+	// position and unit tangent at aDistance along the curve, clamped to
+	// [0, length()]
+	void sample(float aDistance, Vec3f& aPosition, Vec3f& aTangent) const;
+};
+
+#endif//SPLINE_HEADER_FILE
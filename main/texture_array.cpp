@@ -0,0 +1,101 @@
+#include "texture_array.hpp"
+
+#include <algorithm>
+#include <stb_image.h>
+
+#include "../support/error.hpp"
+#include "../support/checkpoint.hpp"
+
+#include "gl_state.hpp"
+
+TextureArray::TextureArray(GLsizei aWidth, GLsizei aHeight)
+	: width(aWidth), height(aHeight)
+{
+}
+
+TextureArray::~TextureArray()
+{
+	glDeleteTextures(1, &texture);
+}
+
+GLint TextureArray::add(std::string aPath)
+{
+	paths.push_back(std::move(aPath));
+	return GLint(paths.size() - 1);
+}
+
+void TextureArray::build()
+{
+	glDeleteTextures(1, &texture);
+
+	GLsizei levels = 1;
+	for (GLsizei size = std::max(width, height); size > 1; size /= 2) levels++;
+
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+	glTexStorage3D(GL_TEXTURE_2D_ARRAY, levels, GL_RGBA8, width, height, GLsizei(paths.size()));
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	// images of a different size go through a temporary texture and are
+	// scaled into their layer with a framebuffer blit
+	GLuint scratchTexture = 0;
+	GLuint framebuffers[2] = {};
+
+	for (size_t layer = 0; layer < paths.size(); layer++)
+	{
+		int imageWidth, imageHeight, imageChannels;
+		stbi_set_flip_vertically_on_load(false);
+		unsigned char* imageData = stbi_load(paths[layer].c_str(), &imageWidth, &imageHeight, &imageChannels, 4);
+		if (!imageData)
+		{
+			glDeleteTextures(1, &scratchTexture);
+			glDeleteFramebuffers(2, framebuffers);
+			throw Error("Unable to load texture '%s': %s", paths[layer].c_str(), stbi_failure_reason());
+		}
+
+		if (imageWidth == width && imageHeight == height)
+		{
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, GLint(layer), width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, imageData);
+		}
+		else
+		{
+			if (!framebuffers[0])
+			{
+				glGenFramebuffers(2, framebuffers);
+			}
+
+			glDeleteTextures(1, &scratchTexture);
+			glGenTextures(1, &scratchTexture);
+			glBindTexture(GL_TEXTURE_2D, scratchTexture);
+			glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, imageWidth, imageHeight);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, imageWidth, imageHeight, GL_RGBA, GL_UNSIGNED_BYTE, imageData);
+
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[0]);
+			glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, scratchTexture, 0);
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffers[1]);
+			glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, texture, 0, GLint(layer));
+
+			glBlitFramebuffer(0, 0, imageWidth, imageHeight, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		}
+
+		stbi_image_free(imageData);
+	}
+
+	glDeleteTextures(1, &scratchTexture);
+	glDeleteFramebuffers(2, framebuffers);
+
+	glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+	glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	// bindings above bypass the state cache
+	gl_state().invalidate();
+
+	OGL_CHECKPOINT_DEBUG();
+}
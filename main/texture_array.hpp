@@ -0,0 +1,43 @@
+#ifndef TEXTURE_ARRAY_HEADER_FILE
+#define TEXTURE_ARRAY_HEADER_FILE
+
+#include <glad.h>
+
+#include <string>
+#include <vector>
+
+// A GL_TEXTURE_2D_ARRAY built from a set of image files. Every image becomes
+// one layer; images that are not the size of the array are rescaled on the
+// GPU when the array is built. Draws that reference textures by layer can
+// share a single binding, so switching between them costs a uniform update
+// instead of a texture bind.
+//
+// Shaders sample it through `layout(binding = 1) uniform sampler2DArray
+// uTextureArray`, with the layer in uniform location 13 (-1 selects the
+// regular uTexture on unit 0).
+class TextureArray
+{
+	GLuint texture = 0;
+	GLsizei width;
+	GLsizei height;
+
+	std::vector<std::string> paths;
+
+public:
+	TextureArray(GLsizei aWidth, GLsizei aHeight);
+	~TextureArray();
+
+	TextureArray(const TextureArray&) = delete;
+	TextureArray& operator=(const TextureArray&) = delete;
+
+	// queue an image; returns the layer it will occupy
+	GLint add(std::string aPath);
+	// load all queued images and create the texture. Throws if an image
+	// cannot be loaded.
+	void build();
+
+	GLuint textureId() const { return texture; }
+	GLsizei layerCount() const { return GLsizei(paths.size()); }
+};
+
+#endif//TEXTURE_ARRAY_HEADER_FILE
@@ -2,13 +2,21 @@
 
 Mat44f Transform::matrix()
 {
-	Mat44f rotationTransform = make_rotation_z(this->rotation.z)
-							 * make_rotation_y(this->rotation.y)
-							 * make_rotation_x(this->rotation.x);
+	// translation * scaling * rotation, filled in directly: each row of the
+	// rotation is scaled, then the translation goes in the last column
+	Mat44f finalTransform = make_rotation(this->rotation);
 
-	Mat44f finalTransform =  make_translation(this->position)
-						  *  make_scaling(this->scale.x, this->scale.y, this->scale.z)
-						  *  rotationTransform;
+	float const scales[] = { this->scale.x, this->scale.y, this->scale.z };
+	for (int row = 0; row < 3; row++)
+	{
+		for (int col = 0; col < 3; col++)
+		{
+			finalTransform(row, col) *= scales[row];
+		}
+	}
+	finalTransform(0, 3) = this->position.x;
+	finalTransform(1, 3) = this->position.y;
+	finalTransform(2, 3) = this->position.z;
 
 	return finalTransform;
 }
@@ -19,6 +27,11 @@ void Transform::setPosition(Vec3f aPosition)
 }
 
 void Transform::setRotation(Vec3f aRotation)
+{
+	rotation = make_quat_euler(aRotation);
+}
+
+void Transform::setRotation(Quatf aRotation)
 {
 	rotation = aRotation;
 }
@@ -27,4 +40,3 @@ void Transform::setScale(Vec3f aScale)
 {
 	scale = aScale;
 }
-
@@ -3,17 +3,23 @@
 
 #include "../vmlib/vec3.hpp"
 #include "../vmlib/mat44.hpp"
+#include "../vmlib/quat.hpp"
 
 class Transform
 {
 	Vec3f position = {0.f, 0.f, 0.f};
-	Vec3f rotation = {0.f, 0.f, 0.f};
+	Quatf rotation = kIdentityQuatf;
 	Vec3f scale =	 {1.f, 1.f, 1.f};
 
 public:
 	Mat44f matrix();
+	Vec3f getPosition() const {return position;}
+	Quatf getRotation() const {return rotation;}
+	Vec3f getScale() const {return scale;}
 	void setPosition(Vec3f aPosition);
+	// Euler angles in radians, applied about x, then y, then z
 	void setRotation(Vec3f aRotation);
+	void setRotation(Quatf aRotation);
 	void setScale(Vec3f aScale);
 };
 
@@ -0,0 +1,47 @@
+#ifndef TRIPLE_BUFFER_HEADER_FILE
+#define TRIPLE_BUFFER_HEADER_FILE
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer, single-consumer triple buffer. The producer
+// fills back() and publish()es it; the consumer acquire()s the most recently
+// published value and reads it through front(). Neither side ever waits for
+// the other: a value that is published before the previous one was acquired
+// simply replaces it.
+template< typename tValue >
+class TripleBuffer
+{
+	static constexpr std::uint8_t kIndexMask = 0x3;
+	static constexpr std::uint8_t kFresh = 0x4;
+
+	std::array<tValue, 3> buffers{};
+
+	// index of the buffer between producer and consumer, plus kFresh if it
+	// holds a value the consumer has not seen yet
+	std::atomic<std::uint8_t> middle{ 1 };
+
+	std::uint8_t frontIndex = 0;	// consumer only
+	std::uint8_t backIndex = 2;		// producer only
+
+public:
+	// producer
+	tValue& back() { return buffers[backIndex]; }
+	void publish()
+	{
+		backIndex = middle.exchange(std::uint8_t(backIndex | kFresh), std::memory_order_acq_rel) & kIndexMask;
+	}
+
+	// consumer; returns false (and keeps the current front) if nothing new
+	// was published
+	bool acquire()
+	{
+		if (!(middle.load(std::memory_order_acquire) & kFresh)) return false;
+		frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & kIndexMask;
+		return true;
+	}
+	const tValue& front() const { return buffers[frontIndex]; }
+};
+
+#endif//TRIPLE_BUFFER_HEADER_FILE
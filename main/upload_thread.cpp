@@ -0,0 +1,122 @@
+#include "upload_thread.hpp"
+
+#include <GLFW/glfw3.h>
+
+#include <cstdio>
+
+#include "../support/error.hpp"
+#include "../support/debug_output.hpp"
+
+UploadThread::UploadThread(GLFWwindow* aShared)
+{
+	// context hints (version, profile, debug) are still those of the main window
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	window = glfwCreateWindow(1, 1, "upload", nullptr, aShared);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+
+	if (!window)
+	{
+		char const* msg = nullptr;
+		int ecode = glfwGetError(&msg);
+		throw Error("Unable to create upload context: '%s' (%d)", msg, ecode);
+	}
+
+	thread = std::thread([this] { run(); });
+}
+
+UploadThread::~UploadThread()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+		jobs.clear();
+	}
+	wake.notify_all();
+	thread.join();
+
+	for (auto& done : completed) glDeleteSync(done.fence);
+	for (auto& done : waiting) glDeleteSync(done.fence);
+
+	glfwDestroyWindow(window);
+}
+
+void UploadThread::enqueue(std::function<void()> aUpload, std::function<void()> aOnComplete)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		jobs.emplace_back(std::move(aUpload), std::move(aOnComplete));
+	}
+	outstanding++;
+	wake.notify_one();
+}
+
+size_t UploadThread::poll()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (auto& done : completed)
+		{
+			waiting.push_back(std::move(done));
+		}
+		completed.clear();
+	}
+
+	// fences are signalled in order, so stop at the first unfinished one
+	size_t finished = 0;
+	while (finished < waiting.size())
+	{
+		GLenum const status = glClientWaitSync(waiting[finished].fence, 0, 0);
+		if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) break;
+
+		glDeleteSync(waiting[finished].fence);
+		waiting[finished].onComplete();
+		finished++;
+	}
+
+	waiting.erase(waiting.begin(), waiting.begin() + finished);
+	outstanding -= finished;
+	return finished;
+}
+
+void UploadThread::run()
+{
+	glfwMakeContextCurrent(window);
+
+	// debug output is per context; the main context's callback does not
+	// see errors in uploads
+#	if !defined(NDEBUG) || defined(OGL_PROFILE)
+	setup_gl_debug_output();
+#	endif // ~ !NDEBUG, OGL_PROFILE
+
+	while (true)
+	{
+		std::function<void()> upload, onComplete;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this] { return quit || !jobs.empty(); });
+			if (quit) break;
+
+			upload = std::move(jobs.front().first);
+			onComplete = std::move(jobs.front().second);
+			jobs.pop_front();
+		}
+
+		try
+		{
+			upload();
+		}
+		catch (std::exception const& eErr)
+		{
+			std::fprintf(stderr, "Background upload failed:\n%s\n", eErr.what());
+		}
+
+		// the fence must reach the GPU before another context waits on it
+		GLsync const fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		glFlush();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		completed.push_back({ fence, std::move(onComplete) });
+	}
+
+	glfwMakeContextCurrent(nullptr);
+}
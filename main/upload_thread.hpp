@@ -0,0 +1,67 @@
+#ifndef UPLOAD_THREAD_HEADER_FILE
+#define UPLOAD_THREAD_HEADER_FILE
+
+#include <glad.h>
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+struct GLFWwindow;
+
+// Runs asset loading and GL uploads on a background thread. The thread owns
+// a hidden window whose context shares objects with the main one, so the
+// buffers and textures it creates can be used for drawing once the upload
+// has finished. Container objects (VAOs, FBOs) are not shared between
+// contexts and must still be created on the main thread.
+//
+// Each job is followed by a fence. poll(), called once per frame on the main
+// thread, runs the completion callback of every job whose fence has been
+// signalled.
+class UploadThread
+{
+	struct Completed
+	{
+		GLsync fence;
+		std::function<void()> onComplete;
+	};
+
+	GLFWwindow* window = nullptr;
+
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::deque<std::pair<std::function<void()>, std::function<void()>>> jobs;
+	std::vector<Completed> completed;
+	bool quit = false;
+
+	// main thread only: jobs that were enqueued but not completed yet
+	size_t outstanding = 0;
+	std::vector<Completed> waiting;
+
+	std::thread thread;
+
+	void run();
+
+public:
+	// must be called on the main thread, with aShared's context current
+	explicit UploadThread(GLFWwindow* aShared);
+	// jobs that have not started yet are dropped
+	~UploadThread();
+
+	UploadThread(const UploadThread&) = delete;
+	UploadThread& operator=(const UploadThread&) = delete;
+
+	// aUpload runs on the upload thread and may make GL calls;
+	// aOnComplete runs on the main thread from poll() once the GPU has
+	// finished with everything aUpload submitted
+	void enqueue(std::function<void()> aUpload, std::function<void()> aOnComplete);
+	// never blocks; returns the number of completion callbacks run
+	size_t poll();
+
+	size_t pending() const { return outstanding; }
+};
+
+#endif//UPLOAD_THREAD_HEADER_FILE
@@ -0,0 +1,118 @@
+#include "vehicle_fleet.hpp"
+
+#include <cmath>
+#include <chrono>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	float elapsed_ms_(Clock::time_point aStart)
+	{
+		return std::chrono::duration<float, std::milli>(Clock::now() - aStart).count();
+	}
+
+	Mat44f box_(Vec3f aCentre, Vec3f aHalfSize)
+	{
+		return make_translation(aCentre) * make_scaling(aHalfSize.x, aHalfSize.y, aHalfSize.z);
+	}
+
+	constexpr float kWheelRadius = 0.04f;
+
+	Vec3f const kWheelAxles[4] = {
+		{ -0.09f, kWheelRadius, 0.1f }, { 0.09f, kWheelRadius, 0.1f },
+		{ -0.09f, kWheelRadius, -0.1f }, { 0.09f, kWheelRadius, -0.1f }
+	};
+	Vec3f const kDoorHinges[2] = {
+		{ -0.082f, 0.08f, 0.06f }, { 0.082f, 0.08f, 0.06f }
+	};
+}
+
+void VehicleFleet::build(size_t aVehicles, GLint aBodyLayer, GLint aWheelLayer)
+{
+	hierarchy.clear();
+	vehicles.clear();
+	parts.clear();
+
+	vehicles.reserve(aVehicles);
+	for (size_t i = 0; i < aVehicles; i++)
+	{
+		Vehicle vehicle;
+		vehicle.radius = 3.f + 15.f * float(i) / float(aVehicles);
+		vehicle.phase = float(i) * 2.399963f; // golden angle, spreads them out
+		vehicle.root = hierarchy.create(kNoParentNode);
+
+		// scaled parts are leaves, so that the scale is not inherited
+		parts.push_back({ hierarchy.create(vehicle.root, box_({ 0.f, 0.08f, 0.f }, { 0.08f, 0.04f, 0.16f })), aBodyLayer });
+
+		for (size_t w = 0; w < 4; w++)
+		{
+			vehicle.wheels[w] = hierarchy.create(vehicle.root, make_translation(kWheelAxles[w]));
+			parts.push_back({ hierarchy.create(vehicle.wheels[w], box_({ 0.f, 0.f, 0.f }, { 0.01f, kWheelRadius, kWheelRadius })), aWheelLayer });
+			HierarchyNode const hub = hierarchy.create(vehicle.wheels[w], make_translation({ kWheelAxles[w].x < 0.f ? -0.012f : 0.012f, 0.f, 0.f }));
+			parts.push_back({ hierarchy.create(hub, box_({ 0.f, 0.f, 0.f }, { 0.004f, 0.015f, 0.015f })), aBodyLayer });
+		}
+
+		// doors hinge at their front edge
+		for (size_t d = 0; d < 2; d++)
+		{
+			float const side = d == 0 ? -1.f : 1.f;
+			vehicle.doors[d] = hierarchy.create(vehicle.root, make_translation(kDoorHinges[d]));
+			parts.push_back({ hierarchy.create(vehicle.doors[d], box_({ 0.f, 0.f, -0.05f }, { 0.004f, 0.03f, 0.05f })), aBodyLayer });
+			HierarchyNode const handle = hierarchy.create(vehicle.doors[d], make_translation({ side * 0.006f, 0.01f, -0.08f }));
+			parts.push_back({ hierarchy.create(handle, box_({ 0.f, 0.f, 0.f }, { 0.003f, 0.003f, 0.01f })), aWheelLayer });
+		}
+
+		vehicles.push_back(vehicle);
+	}
+}
+
+VehicleFleetStats VehicleFleet::run(float aTime, WorkerPool* aPool, const Frustum& aFrustum, RenderQueue& aQueue, const DrawItem& aCube)
+{
+	VehicleFleetStats stats;
+	stats.nodes = hierarchy.size();
+
+	auto const start = Clock::now();
+	for (auto const& vehicle : vehicles)
+	{
+		float const speed = 1.f / vehicle.radius;
+		float const angle = vehicle.phase + speed * aTime;
+		Vec3f const position = { vehicle.radius * std::cos(angle), 0.f, vehicle.radius * std::sin(angle) };
+		hierarchy.setLocal(vehicle.root, make_translation(position) * make_rotation_y(-angle));
+
+		float const spin = aTime / kWheelRadius;
+		for (size_t w = 0; w < 4; w++)
+		{
+			hierarchy.setLocal(vehicle.wheels[w], make_translation(kWheelAxles[w]) * make_rotation_x(spin));
+		}
+
+		float const open = 0.5f * (0.5f + 0.5f * std::sin(aTime + vehicle.phase));
+		for (size_t d = 0; d < 2; d++)
+		{
+			hierarchy.setLocal(vehicle.doors[d], make_translation(kDoorHinges[d]) * make_rotation_y(d == 0 ? -open : open));
+		}
+	}
+	stats.animateMs = elapsed_ms_(start);
+
+	auto const updateStart = Clock::now();
+	stats.recomputed = hierarchy.update(aPool);
+	stats.updateMs = elapsed_ms_(updateStart);
+
+	auto const submitStart = Clock::now();
+	DrawItem item = aCube;
+	for (auto const& part : parts)
+	{
+		Mat44f const& model = hierarchy.getWorld(part.node);
+		Vec3f const centre = { model(0, 3), model(1, 3), model(2, 3) };
+		// the parts are small; a fixed radius covers all of them
+		if (!sphere_in_frustum(aFrustum, centre, 0.2f)) continue;
+
+		item.model = model;
+		item.textureLayer = part.textureLayer;
+		aQueue.submit(item);
+		stats.drawn++;
+	}
+	stats.submitMs = elapsed_ms_(submitStart);
+
+	return stats;
+}
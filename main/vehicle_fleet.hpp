@@ -0,0 +1,55 @@
+#ifndef VEHICLE_FLEET_HEADER_FILE
+#define VEHICLE_FLEET_HEADER_FILE
+
+#include <vector>
+
+#include "scene_hierarchy.hpp"
+#include "render_queue.hpp"
+#include "frustum.hpp"
+
+struct VehicleFleetStats
+{
+	size_t nodes = 0;
+	size_t recomputed = 0;
+	size_t drawn = 0;
+	float animateMs = 0.f;
+	float updateMs = 0.f;
+	float submitMs = 0.f;
+};
+
+// Stress test for SceneHierarchy: cube cars driving in circles, each a
+// small assembly (body, wheels with hubs, doors with handles) four levels
+// deep. Every frame moves all cars and spins all wheels, so every subtree
+// is recomputed.
+class VehicleFleet
+{
+	struct Part
+	{
+		HierarchyNode node;
+		GLint textureLayer;
+	};
+
+	struct Vehicle
+	{
+		HierarchyNode root;
+		HierarchyNode wheels[4];
+		HierarchyNode doors[2];
+		float radius;
+		float phase;
+	};
+
+	SceneHierarchy hierarchy;
+	std::vector<Vehicle> vehicles;
+	std::vector<Part> parts;
+
+public:
+	// aBodyLayer and aWheelLayer are texture array layers for the parts
+	void build(size_t aVehicles, GLint aBodyLayer, GLint aWheelLayer);
+	size_t size() const { return vehicles.size(); }
+
+	// aCube draws a cube of unit half-size; its model matrix is ignored.
+	// aPool may be null to update on the calling thread only.
+	VehicleFleetStats run(float aTime, WorkerPool* aPool, const Frustum& aFrustum, RenderQueue& aQueue, const DrawItem& aCube);
+};
+
+#endif//VEHICLE_FLEET_HEADER_FILE
@@ -0,0 +1,91 @@
+#include "worker_pool.hpp"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool(size_t aWorkers)
+{
+	if (aWorkers == 0)
+	{
+		aWorkers = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	for (size_t i = 1; i < aWorkers; i++)
+	{
+		threads.emplace_back([this, i] { run(i); });
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+	}
+	wake.notify_all();
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+void WorkerPool::runRange(const Job& aJob, size_t aWorker, size_t aCount) const
+{
+	size_t const workers = workerCount();
+	size_t const begin = aCount * aWorker / workers;
+	size_t const end = aCount * (aWorker + 1) / workers;
+	aJob(aWorker, begin, end);
+}
+
+void WorkerPool::parallelFor(size_t aCount, const Job& aJob)
+{
+	if (threads.empty())
+	{
+		aJob(0, 0, aCount);
+		return;
+	}
+
+	std::lock_guard<std::mutex> caller(callerMutex);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		job = &aJob;
+		jobSize = aCount;
+		pending = threads.size();
+		generation++;
+	}
+	wake.notify_all();
+
+	runRange(aJob, 0, aCount);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	finished.wait(lock, [this] { return pending == 0; });
+	job = nullptr;
+}
+
+void WorkerPool::run(size_t aWorker)
+{
+	size_t seen = 0;
+
+	while (true)
+	{
+		const Job* current;
+		size_t count;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [&] { return quit || generation != seen; });
+			if (quit) return;
+
+			seen = generation;
+			current = job;
+			count = jobSize;
+		}
+
+		runRange(*current, aWorker, count);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			pending--;
+		}
+		finished.notify_one();
+	}
+}
@@ -0,0 +1,53 @@
+#ifndef WORKER_POOL_HEADER_FILE
+#define WORKER_POOL_HEADER_FILE
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include <condition_variable>
+
+// Fixed set of threads for data-parallel work within a frame. The calling
+// thread takes part as worker 0, so a pool of one worker runs everything
+// inline. Several threads may share a pool; their parallelFor() calls take
+// turns.
+class WorkerPool
+{
+public:
+	using Job = std::function<void(size_t aWorker, size_t aBegin, size_t aEnd)>;
+
+private:
+	std::vector<std::thread> threads;
+
+	// held for a whole parallelFor()
+	std::mutex callerMutex;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable finished;
+
+	const Job* job = nullptr;
+	size_t jobSize = 0;
+	size_t generation = 0;
+	size_t pending = 0;
+	bool quit = false;
+
+	void run(size_t aWorker);
+	void runRange(const Job& aJob, size_t aWorker, size_t aCount) const;
+
+public:
+	// aWorkers includes the calling thread; 0 picks one per hardware thread
+	explicit WorkerPool(size_t aWorkers = 0);
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	size_t workerCount() const { return threads.size() + 1; }
+
+	// split [0, aCount) into one contiguous range per worker and run aJob on
+	// each (ranges may be empty); returns once all of them are done
+	void parallelFor(size_t aCount, const Job& aJob);
+};
+
+#endif//WORKER_POOL_HEADER_FILE
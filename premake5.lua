@@ -1,3 +1,15 @@
+-- premake5 gmake2 --count-allocs: count heap allocations while loading
+newoption {
+	trigger = "count-allocs",
+	description = "Replace global operator new/delete to report allocations per asset load"
+}
+
+-- premake5 gmake2 --gl-profile: release-like GL timings with error reporting
+newoption {
+	trigger = "gl-profile",
+	description = "Compile out glGetError() checkpoints and collect GL debug messages asynchronously"
+}
+
 workspace "COMP3811-cw2"
 	language "C++"
 	cppdialect "C++17"
@@ -32,6 +44,12 @@ workspace "COMP3811-cw2"
 		defines { "_CRT_SECURE_NO_WARNINGS=1" }
 		defines { "_SCL_SECURE_NO_WARNINGS=1" }
 	
+	filter "options:count-allocs"
+		defines { "COUNT_ALLOCATIONS=1" }
+
+	filter "options:gl-profile"
+		defines { "OGL_PROFILE=1" }
+
 	filter "*"
 
 	-- default libraries
@@ -91,6 +109,27 @@ project "main"
 
 	files( sources )
 
+project "bench"
+	local sources = { 
+		"bench/**.cpp",
+		"bench/**.hpp"
+	}
+
+	-- Headless micro-benchmarks. Only CPU code from main/ is built in, so
+	-- this runs without a window or GL context.
+	kind "ConsoleApp"
+	location "bench"
+
+	files( sources )
+	files {
+		"main/easing.cpp",
+		"main/animation_system.cpp",
+		"main/loadobj.cpp"
+	}
+
+	links "vmlib"
+	links "support"
+
 project "main-shaders"
 	local shaders = { 
 		"assets/*.vert",
@@ -1,12 +1,19 @@
 #ifndef CHECKPOINT_HPP_3DFDA796_469C_4D37_B904_1C8D8FAE207B
 #define CHECKPOINT_HPP_3DFDA796_469C_4D37_B904_1C8D8FAE207B
 
-#define OGL_CHECKPOINT_ALWAYS() do {                                \
+// glGetError() waits for the driver to catch up. Profiling builds (premake
+// --gl-profile, OGL_PROFILE) compile the checkpoints out and rely on the
+// asynchronous debug output instead, see setup_gl_debug_output().
+#if defined(OGL_PROFILE)
+#	define OGL_CHECKPOINT_ALWAYS()  do {} while(0)
+#else
+#	define OGL_CHECKPOINT_ALWAYS() do {                                \
 		::detail::check_gl_error( __FILE__, __LINE__ );             \
 	} while(0)                                                      \
 	/*ENDM*/
+#endif
 
-#if defined(NDEBUG)
+#if defined(NDEBUG) || defined(OGL_PROFILE)
 #	define OGL_CHECKPOINT_DEBUG()   do {} while(0)
 #else
 #	define OGL_CHECKPOINT_DEBUG()   OGL_CHECKPOINT_ALWAYS()
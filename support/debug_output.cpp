@@ -3,6 +3,14 @@
 #include <cstdio>
 #include <cassert>
 
+#if defined(OGL_PROFILE)
+#	include <atomic>
+#	include <vector>
+#	include <cstdint>
+#	include <cstring>
+#	include <algorithm>
+#endif // ~ OGL_PROFILE
+
 #include <glad.h>
 #include <GLFW/glfw3.h>
 
@@ -12,14 +20,136 @@
 namespace
 {
 	// Debug callback
-#	if !defined(NDEBUG)
+#	if defined(OGL_PROFILE)
+	void GLAPIENTRY callback_gldebug_async_( GLenum, GLenum, GLuint, GLenum, GLsizei, GLchar const*, void const* );
+#	elif !defined(NDEBUG)
 	void GLAPIENTRY callback_gldebug_( GLenum, GLenum, GLuint, GLenum, GLsizei, GLchar const*, void const* );
-#	endif // ~ !NDEBUG
+#	endif // ~ OGL_PROFILE, !NDEBUG
+
+#	if defined(OGL_PROFILE)
+	char const* type_str_( GLenum ) noexcept;
+	char const* severity_str_( GLenum ) noexcept;
+
+	constexpr std::size_t kDebugTextLength = 192;
+	constexpr std::uint32_t kDebugRingSize = 256; // power of two
+
+	struct DebugMessage_
+	{
+		GLenum source, type, severity;
+		GLuint id;
+		char text[kDebugTextLength];
+	};
+
+	// Bounded queue after Vyukov: any number of threads may push (drivers
+	// call back from their own threads), one thread pops. A slot's sequence
+	// says whether it is free for the push at that position or holds the
+	// message for the pop at that position. Nothing blocks; messages that
+	// do not fit are counted and dropped.
+	class DebugRing_
+	{
+		struct Slot_
+		{
+			std::atomic<std::uint32_t> sequence;
+			DebugMessage_ message;
+		};
+
+		Slot_ slots[kDebugRingSize];
+		std::atomic<std::uint32_t> pushPos{ 0 };
+		std::uint32_t popPos = 0;
+
+	public:
+		std::atomic<std::uint64_t> dropped{ 0 };
+
+		DebugRing_()
+		{
+			for( std::uint32_t i = 0; i < kDebugRingSize; ++i )
+				slots[i].sequence.store( i, std::memory_order_relaxed );
+		}
+
+		void push( GLenum aSource, GLenum aType, GLuint aId, GLenum aSeverity, GLsizei aLength, GLchar const* aText ) noexcept
+		{
+			std::uint32_t pos = pushPos.load( std::memory_order_relaxed );
+			Slot_* slot;
+			for( ;; )
+			{
+				slot = &slots[pos & (kDebugRingSize-1)];
+				auto const diff = std::int32_t( slot->sequence.load( std::memory_order_acquire ) - pos );
+				if( 0 == diff )
+				{
+					if( pushPos.compare_exchange_weak( pos, pos+1, std::memory_order_relaxed ) )
+						break;
+				}
+				else if( diff < 0 )
+				{
+					// full
+					dropped.fetch_add( 1, std::memory_order_relaxed );
+					return;
+				}
+				else
+				{
+					pos = pushPos.load( std::memory_order_relaxed );
+				}
+			}
+
+			auto& msg = slot->message;
+			msg.source = aSource;
+			msg.type = aType;
+			msg.id = aId;
+			msg.severity = aSeverity;
+
+			std::size_t const length = aLength < 0 ? std::strlen( aText ) : std::size_t(aLength);
+			std::size_t const copied = std::min( length, kDebugTextLength-1 );
+			std::memcpy( msg.text, aText, copied );
+			msg.text[copied] = '\0';
+
+			slot->sequence.store( pos+1, std::memory_order_release );
+		}
+
+		template< typename tHandler >
+		unsigned drain( tHandler&& aHandle )
+		{
+			unsigned count = 0;
+			for( ;; )
+			{
+				Slot_& slot = slots[popPos & (kDebugRingSize-1)];
+				if( std::int32_t( slot.sequence.load( std::memory_order_acquire ) - (popPos+1) ) < 0 )
+					return count;
+
+				aHandle( slot.message );
+				slot.sequence.store( popPos + kDebugRingSize, std::memory_order_release );
+				++popPos;
+				++count;
+			}
+		}
+	};
+
+	// one entry per distinct message, with the text of its first occurrence
+	struct DebugCount_
+	{
+		DebugMessage_ first;
+		std::uint64_t count;
+	};
+
+	DebugRing_ gDebugRing_;
+	std::vector<DebugCount_> gDebugCounts_; // drain thread only
+#	endif // ~ OGL_PROFILE
 }
 
 void setup_gl_debug_output()
 {
-#	if !defined(NDEBUG)
+#	if defined(OGL_PROFILE)
+#	if !defined(__APPLE__)
+	glDebugMessageCallback( &callback_gldebug_async_, nullptr );
+	// Notifications are frequent and not interesting when profiling.
+	glDebugMessageControl( GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE );
+	glEnable( GL_DEBUG_OUTPUT );
+
+	// Let the driver report from wherever it detects the problem, rather
+	// than serialising every call.
+	glDisable( GL_DEBUG_OUTPUT_SYNCHRONOUS );
+#	endif // ~ __APPLE__
+
+#	elif !defined(NDEBUG)
 	OGL_CHECKPOINT_ALWAYS();
 
 	// glDebugMessageCallback() was standardized in 4.3, so it's not available
@@ -35,12 +165,49 @@ void setup_gl_debug_output()
 #	endif // ~ __APPLE__
 
 	OGL_CHECKPOINT_ALWAYS();
-#	endif // ~ !NDEBUG
+#	endif // ~ OGL_PROFILE, !NDEBUG
+}
+
+unsigned drain_gl_debug_output()
+{
+#	if defined(OGL_PROFILE)
+	return gDebugRing_.drain( [] (DebugMessage_ const& aMsg) {
+		auto const it = std::find_if( gDebugCounts_.begin(), gDebugCounts_.end(), [&aMsg] (DebugCount_ const& aCount) {
+			return aCount.first.id == aMsg.id && aCount.first.type == aMsg.type && aCount.first.source == aMsg.source;
+		} );
+
+		if( gDebugCounts_.end() != it )
+		{
+			++it->count;
+			return;
+		}
+
+		gDebugCounts_.push_back( { aMsg, 1 } );
+		std::fprintf( stderr, "OpenGL Debug: %s [%s] #%u: %s\n", severity_str_(aMsg.severity), type_str_(aMsg.type), aMsg.id, aMsg.text );
+	} );
+#	else
+	return 0;
+#	endif // ~ OGL_PROFILE
+}
+
+void report_gl_debug_output()
+{
+#	if defined(OGL_PROFILE)
+	drain_gl_debug_output();
+
+	std::uint64_t const dropped = gDebugRing_.dropped.load( std::memory_order_relaxed );
+	std::fprintf( stderr, "OpenGL Debug: %zu distinct messages, %llu dropped\n", gDebugCounts_.size(), static_cast<unsigned long long>(dropped) );
+	for( auto const& count : gDebugCounts_ )
+	{
+		std::fprintf( stderr, "  %8llu x %s [%s] #%u: %s\n", static_cast<unsigned long long>(count.count),
+			severity_str_(count.first.severity), type_str_(count.first.type), count.first.id, count.first.text );
+	}
+#	endif // ~ OGL_PROFILE
 }
 
 namespace
 {
-#	if !defined(NDEBUG)
+#	if defined(OGL_PROFILE) || !defined(NDEBUG)
 	char const* type_str_( GLenum aType ) noexcept
 	{
 		switch( aType )
@@ -70,7 +237,19 @@ namespace
 
 		return "<unknown severity>";
 	}
+#	endif // ~ OGL_PROFILE, !NDEBUG
+
+#	if defined(OGL_PROFILE)
+	void GLAPIENTRY callback_gldebug_async_( GLenum aSource, GLenum aType, GLuint aId, GLenum aSeverity, GLsizei aLength, GLchar const* aMessage, void const* /*aUser*/ )
+	{
+		// see callback_gldebug_()
+		if( GL_DEBUG_TYPE_OTHER == aType )
+			return;
+
+		gDebugRing_.push( aSource, aType, aId, aSeverity, aLength, aMessage );
+	}
 
+#	elif !defined(NDEBUG)
 	void GLAPIENTRY callback_gldebug_( GLenum, GLenum aType, GLuint, GLenum aSeverity, GLsizei, GLchar const* aMessage, void const* /*aUser*/ )
 	{
 		// "Other" can be a bit spammy at times. However, it can include fairly
@@ -86,6 +265,6 @@ namespace
 		if( GL_DEBUG_SEVERITY_HIGH == aSeverity )
 			assert( false );
 	}
-#	endif // ~ !NDEBUG
+#	endif // ~ OGL_PROFILE, !NDEBUG
 }
 
@@ -1,6 +1,19 @@
 #ifndef DEBUG_OUTPUT_HPP_91C7C3DF_B7F1_4025_B682_2456DFD7C05D
 #define DEBUG_OUTPUT_HPP_91C7C3DF_B7F1_4025_B682_2456DFD7C05D
 
+// Debug builds get a synchronous callback that prints each message and
+// asserts on errors. Profiling builds (OGL_PROFILE) get an asynchronous one
+// that only copies messages into a lock-free ring, so the driver is not
+// slowed down; drain_gl_debug_output() collects them once per frame and
+// prints each message the first time it is seen. Other builds leave debug
+// output off.
 void setup_gl_debug_output();
 
+// returns the number of messages drained; always 0 outside of profiling
+// builds
+unsigned drain_gl_debug_output();
+
+// prints how often each message was seen
+void report_gl_debug_output();
+
 #endif // DEBUG_OUTPUT_HPP_91C7C3DF_B7F1_4025_B682_2456DFD7C05D
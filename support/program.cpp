@@ -11,6 +11,12 @@
 #include "error.hpp"
 #include "checkpoint.hpp"
 
+// GL_KHR_parallel_shader_compile is not part of the glad configuration, so
+// the few bits that we need are defined here.
+#if !defined(GL_COMPLETION_STATUS_KHR)
+#	define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace
 {
 	GLuint load_shader_( 
@@ -18,6 +24,13 @@ namespace
 		char const* aSourcePath
 	);
 
+	std::vector<GLchar> read_source_( char const* aSourcePath );
+	GLuint compile_shader_( GLenum aShaderType, std::vector<GLchar> const& aSource );
+	void check_shader_( GLuint aShader, GLenum aShaderType, char const* aSourcePath );
+	void check_program_( GLuint aProgram );
+
+	bool parallel_compile_supported_();
+
 	// lightweight std::experimental::scope_exit alternative
 	// Not the most complete or convenient implementation...
 	template< typename tFunc >
@@ -40,12 +53,15 @@ namespace
 ShaderProgram::ShaderProgram( std::vector<ShaderSource> aShaderSources )
 	: mProgram( 0 )
 	, mSources( std::move(aShaderSources) )
+	, mPendingProgram( 0 )
 {
 	reload();
 }
 
 ShaderProgram::~ShaderProgram()
 {
+	discardPending_();
+
 	if( 0 != mProgram )
 		glDeleteProgram( mProgram );
 }
@@ -53,11 +69,15 @@ ShaderProgram::~ShaderProgram()
 ShaderProgram::ShaderProgram( ShaderProgram&& aOther ) noexcept
 	: mProgram( std::exchange( aOther.mProgram, 0 ) )
 	, mSources( std::move(aOther.mSources) )
+	, mPendingProgram( std::exchange( aOther.mPendingProgram, 0 ) )
+	, mPendingShaders( std::move(aOther.mPendingShaders) )
 {}
 ShaderProgram& ShaderProgram::operator= (ShaderProgram&& aOther) noexcept
 {
 	std::swap( mProgram, aOther.mProgram );
 	std::swap( mSources, aOther.mSources );
+	std::swap( mPendingProgram, aOther.mPendingProgram );
+	std::swap( mPendingShaders, aOther.mPendingShaders );
 	return *this;
 }
 
@@ -109,38 +129,124 @@ void ShaderProgram::reload()
 
 	glLinkProgram( prog );
 
-	{
-		// Get info log
-		GLint logLength = 0;
-		glGetProgramiv( prog, GL_INFO_LOG_LENGTH, &logLength );
+	check_program_( prog );
+	
+	OGL_CHECKPOINT_ALWAYS();
 
-		std::vector<GLchar> log;
-		if( logLength )
-		{
-			log.resize( logLength );
-			glGetProgramInfoLog( prog, GLsizei(log.size()), nullptr, log.data() );
-		}
+	// Replace the old shader program (if any) with the new one
+	std::swap( mProgram, prog );
+}
 
-		// Check link status
-		GLint status = 0;
-		glGetProgramiv( prog, GL_LINK_STATUS, &status );
+void ShaderProgram::reloadAsync()
+{
+	// A reload that is still in flight is superseded by this one
+	discardPending_();
 
-		if( GL_TRUE != status )
-			throw Error( "Shader program linking failed: \n%s\n", log.data() );
+	// Read all sources first. This may throw (e.g., if an editor is in the
+	// middle of saving a file), in which case nothing has been created yet.
+	std::vector<std::vector<GLchar>> sources;
+	sources.reserve( mSources.size() );
 
-		if( !log.empty() )
-			std::fprintf( stderr, "Note: shader program linking log:\n%s\n", log.data() );
+	for( auto const& source : mSources )
+		sources.emplace_back( read_source_( source.sourcePath.c_str() ) );
+
+	OGL_CHECKPOINT_DEBUG();
+
+	// Submit compilation and linking. With parallel shader compilation, none
+	// of these calls wait for the compiler. The status is only inspected in
+	// pollReload().
+	mPendingShaders.reserve( mSources.size() );
+	for( std::size_t i = 0; i < mSources.size(); ++i )
+		mPendingShaders.emplace_back( compile_shader_( mSources[i].type, sources[i] ) );
+
+	mPendingProgram = glCreateProgram();
+
+	for( auto const shader : mPendingShaders )
+		glAttachShader( mPendingProgram, shader );
+
+	glLinkProgram( mPendingProgram );
+
+	OGL_CHECKPOINT_DEBUG();
+}
+
+bool ShaderProgram::pollReload()
+{
+	if( 0 == mPendingProgram )
+		return false;
+
+	// Without the extension, querying the link status below may block until
+	// the driver is done. That is no worse than reload().
+	if( parallel_compile_supported_() )
+	{
+		GLint done = GL_FALSE;
+		glGetProgramiv( mPendingProgram, GL_COMPLETION_STATUS_KHR, &done );
+
+		if( GL_FALSE == done )
+			return false;
 	}
-	
+
+	// Make sure that the pending objects are released, regardless of whether
+	// the new program is accepted or an exception is thrown.
+	auto const scopePending_ = scope_exit_( [this] {
+		discardPending_();
+	} );
+
+	for( std::size_t i = 0; i < mPendingShaders.size(); ++i )
+		check_shader_( mPendingShaders[i], mSources[i].type, mSources[i].sourcePath.c_str() );
+
+	check_program_( mPendingProgram );
+
 	OGL_CHECKPOINT_ALWAYS();
 
-	// Replace the old shader program (if any) with the new one
-	std::swap( mProgram, prog );
+	// Swap in the new program; the old one is deleted by discardPending_()
+	std::swap( mProgram, mPendingProgram );
+	return true;
+}
+
+bool ShaderProgram::reloadPending() const noexcept
+{
+	return 0 != mPendingProgram;
+}
+
+void ShaderProgram::discardPending_() noexcept
+{
+	for( auto const shader : mPendingShaders )
+		glDeleteShader( shader );
+
+	mPendingShaders.clear();
+
+	if( 0 != mPendingProgram )
+		glDeleteProgram( mPendingProgram );
+
+	mPendingProgram = 0;
 }
 
 namespace
 {
 	GLuint load_shader_( GLenum aShaderType, char const* aSourcePath )
+	{
+		auto const source = read_source_( aSourcePath );
+
+		OGL_CHECKPOINT_ALWAYS();
+
+		GLuint shader = compile_shader_( aShaderType, source );
+
+		OGL_CHECKPOINT_ALWAYS();
+
+		try
+		{
+			check_shader_( shader, aShaderType, aSourcePath );
+		}
+		catch( ... )
+		{
+			glDeleteShader( shader );
+			throw;
+		}
+
+		return shader;
+	}
+
+	std::vector<GLchar> read_source_( char const* aSourcePath )
 	{
 		// Load the shader source code from file
 		std::vector<GLchar> source;
@@ -176,38 +282,45 @@ namespace
 			throw Error( "load_shader_(): unable to open input file '%s'", aSourcePath );
 		}
 
-		// Create shader object
-		OGL_CHECKPOINT_ALWAYS();
+		return source;
+	}
 
+	GLuint compile_shader_( GLenum aShaderType, std::vector<GLchar> const& aSource )
+	{
+		// Create shader object. This does not wait for the compiler; see
+		// check_shader_() for that.
 		GLuint shader = glCreateShader( aShaderType );
 
 		// Compile shader
 		GLchar const* sources[] = {
-			source.data()
+			aSource.data()
 		};
 		GLsizei lengths[] = {
-			GLsizei(source.size())
+			GLsizei(aSource.size())
 		};
 
 		glShaderSource( shader, sizeof(sources)/sizeof(sources[0]), sources, lengths );
 
 		glCompileShader( shader );
 
-		OGL_CHECKPOINT_ALWAYS();
+		return shader;
+	}
 
+	void check_shader_( GLuint aShader, GLenum aShaderType, char const* aSourcePath )
+	{
 		// Get compile info log
 		/* The compile log is mainly relevant if there is an error. However, on some
 		 * systems, it can include additional information even if compilation was
 		 * successful. This might include warnings and/or usage hints.
 		 */
 		GLint logLength = 0;
-		glGetShaderiv( shader, GL_INFO_LOG_LENGTH, &logLength );
+		glGetShaderiv( aShader, GL_INFO_LOG_LENGTH, &logLength );
 
 		std::vector<GLchar> log;
 		if( logLength )
 		{
 			log.resize( logLength );
-			glGetShaderInfoLog( shader, GLsizei(log.size()), nullptr, log.data() );
+			glGetShaderInfoLog( aShader, GLsizei(log.size()), nullptr, log.data() );
 		}
 
 		char const* shaderTypeName = "unknown shader";
@@ -223,11 +336,10 @@ namespace
 
 		// Check compile status
 		GLint status = 0;
-		glGetShaderiv( shader, GL_COMPILE_STATUS, &status );
+		glGetShaderiv( aShader, GL_COMPILE_STATUS, &status );
 
 		if( GL_TRUE != status )
 		{
-			glDeleteShader( shader );
 			throw Error( "%s \"%s\" compilation failed:\n%s\n", shaderTypeName, aSourcePath, log.data() );
 		}
 
@@ -235,7 +347,53 @@ namespace
 			std::fprintf( stderr, "Note: %s \"%s\" log:\n%s\n", shaderTypeName, aSourcePath, log.data() );
 
 		OGL_CHECKPOINT_ALWAYS();
+	}
 
-		return shader;
+	void check_program_( GLuint aProgram )
+	{
+		// Get info log
+		GLint logLength = 0;
+		glGetProgramiv( aProgram, GL_INFO_LOG_LENGTH, &logLength );
+
+		std::vector<GLchar> log;
+		if( logLength )
+		{
+			log.resize( logLength );
+			glGetProgramInfoLog( aProgram, GLsizei(log.size()), nullptr, log.data() );
+		}
+
+		// Check link status
+		GLint status = 0;
+		glGetProgramiv( aProgram, GL_LINK_STATUS, &status );
+
+		if( GL_TRUE != status )
+			throw Error( "Shader program linking failed: \n%s\n", log.data() );
+
+		if( !log.empty() )
+			std::fprintf( stderr, "Note: shader program linking log:\n%s\n", log.data() );
+	}
+
+	bool parallel_compile_supported_()
+	{
+		// Checked once, with the first context that asks. The extension was
+		// also published as ARB_parallel_shader_compile, with identical enums.
+		static bool const supported = [] {
+			using MaxThreadsFn_ = void (APIENTRYP)( GLuint );
+
+			MaxThreadsFn_ maxThreads = nullptr;
+			if( glfwExtensionSupported( "GL_KHR_parallel_shader_compile" ) )
+				maxThreads = reinterpret_cast<MaxThreadsFn_>(glfwGetProcAddress( "glMaxShaderCompilerThreadsKHR" ));
+			else if( glfwExtensionSupported( "GL_ARB_parallel_shader_compile" ) )
+				maxThreads = reinterpret_cast<MaxThreadsFn_>(glfwGetProcAddress( "glMaxShaderCompilerThreadsARB" ));
+
+			if( !maxThreads )
+				return false;
+
+			// Let the implementation pick the number of compiler threads
+			maxThreads( 0xFFFFFFFFu );
+			return true;
+		}();
+
+		return supported;
 	}
 }
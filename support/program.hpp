@@ -36,9 +36,28 @@ class ShaderProgram final
 
 		void reload();
 
+		// Non-blocking variant of reload(). reloadAsync() submits the sources
+		// for compilation and linking, but does not wait for the results. The
+		// current program stays in use until pollReload() finds that the new
+		// program has finished linking, at which point it is swapped in and
+		// pollReload() returns true. Where GL_KHR_parallel_shader_compile is
+		// available, the driver compiles on its own threads and pollReload()
+		// never stalls. On failure, pollReload() throws (and the old program
+		// is kept).
+		void reloadAsync();
+		bool pollReload();
+
+		bool reloadPending() const noexcept;
+
+	private:
+		void discardPending_() noexcept;
+
 	private:
 		GLuint mProgram;
 		std::vector<ShaderSource> mSources;
+
+		GLuint mPendingProgram;
+		std::vector<GLuint> mPendingShaders;
 };
 
 #endif // PROGRAM_HPP_39793FD2_7845_47A7_9E21_6DDAD42C9A09
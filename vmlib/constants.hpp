@@ -0,0 +1,12 @@
+#ifndef CONSTANTS_HPP_52ADB60B_41B5_4BE7_AACF_B1A996450430
+#define CONSTANTS_HPP_52ADB60B_41B5_4BE7_AACF_B1A996450430
+
+/** Numeric constants
+ *
+ * Written out to more digits than a float holds, so that each is the float
+ * nearest to the exact value. (3.1415926f, for example, rounds down to the
+ * float below pi.)
+ */
+constexpr float kPi = 3.14159265358979f;
+
+#endif // CONSTANTS_HPP_52ADB60B_41B5_4BE7_AACF_B1A996450430
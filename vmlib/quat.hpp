@@ -0,0 +1,168 @@
+#ifndef QUAT_HPP_3C0E58A1_92D4_4B7E_8F16_0D5A2B64E9C7
+#define QUAT_HPP_3C0E58A1_92D4_4B7E_8F16_0D5A2B64E9C7
+
+#include <cmath>
+#include <cassert>
+#include <cstdlib>
+
+#include "vec3.hpp"
+#include "mat44.hpp"
+
+/** Quatf: rotation quaternion with floats
+ *
+ * x, y, z is the vector part and w the scalar part, so that the rotation by
+ * aAngle about the unit axis a is
+ *    { a.x * sin(aAngle/2), a.y * sin(aAngle/2), a.z * sin(aAngle/2), cos(aAngle/2) }
+ *
+ * q and -q describe the same rotation. nlerp() and slerp() pick whichever of
+ * the two is closer, so they always blend along the shorter way round.
+ *
+ * Only unit quaternions are rotations; make_rotation() assumes its argument
+ * is one.
+ */
+struct Quatf
+{
+	float x, y, z, w;
+};
+
+constexpr Quatf kIdentityQuatf = { 0.f, 0.f, 0.f, 1.f };
+
+
+constexpr
+Quatf operator-( Quatf aQuat ) noexcept
+{
+	return { -aQuat.x, -aQuat.y, -aQuat.z, -aQuat.w };
+}
+
+constexpr
+Quatf operator+( Quatf aLeft, Quatf aRight ) noexcept
+{
+	return Quatf{
+		aLeft.x + aRight.x,
+		aLeft.y + aRight.y,
+		aLeft.z + aRight.z,
+		aLeft.w + aRight.w
+	};
+}
+
+constexpr
+Quatf operator*( float aScalar, Quatf aQuat ) noexcept
+{
+	return Quatf{
+		aScalar * aQuat.x,
+		aScalar * aQuat.y,
+		aScalar * aQuat.z,
+		aScalar * aQuat.w
+	};
+}
+
+// Rotation by aRight, then by aLeft (same order as for matrices).
+constexpr
+Quatf operator*( Quatf aLeft, Quatf aRight ) noexcept
+{
+	return Quatf{
+		aLeft.w * aRight.x + aLeft.x * aRight.w + aLeft.y * aRight.z - aLeft.z * aRight.y,
+		aLeft.w * aRight.y - aLeft.x * aRight.z + aLeft.y * aRight.w + aLeft.z * aRight.x,
+		aLeft.w * aRight.z + aLeft.x * aRight.y - aLeft.y * aRight.x + aLeft.z * aRight.w,
+		aLeft.w * aRight.w - aLeft.x * aRight.x - aLeft.y * aRight.y - aLeft.z * aRight.z
+	};
+}
+
+
+constexpr
+float dot( Quatf aLeft, Quatf aRight ) noexcept
+{
+	return aLeft.x * aRight.x
+		+ aLeft.y * aRight.y
+		+ aLeft.z * aRight.z
+		+ aLeft.w * aRight.w
+	;
+}
+
+inline
+Quatf normalize( Quatf aQuat ) noexcept
+{
+	return (1.f / std::sqrt( dot( aQuat, aQuat ) )) * aQuat;
+}
+
+
+inline
+Quatf make_quat_rotation_x( float aAngle ) noexcept
+{
+	return { std::sin(0.5f * aAngle), 0.f, 0.f, std::cos(0.5f * aAngle) };
+}
+
+inline
+Quatf make_quat_rotation_y( float aAngle ) noexcept
+{
+	return { 0.f, std::sin(0.5f * aAngle), 0.f, std::cos(0.5f * aAngle) };
+}
+
+inline
+Quatf make_quat_rotation_z( float aAngle ) noexcept
+{
+	return { 0.f, 0.f, std::sin(0.5f * aAngle), std::cos(0.5f * aAngle) };
+}
+
+// Same rotation as
+//    make_rotation_z(aAngles.z) * make_rotation_y(aAngles.y) * make_rotation_x(aAngles.x)
+inline
+Quatf make_quat_euler( Vec3f aAngles ) noexcept
+{
+	return make_quat_rotation_z(aAngles.z) * make_quat_rotation_y(aAngles.y) * make_quat_rotation_x(aAngles.x);
+}
+
+
+// Rotation matrix of a unit quaternion; no trigonometry involved.
+constexpr
+Mat44f make_rotation( Quatf aQuat ) noexcept
+{
+	float const x2 = aQuat.x + aQuat.x, y2 = aQuat.y + aQuat.y, z2 = aQuat.z + aQuat.z;
+	float const xx = aQuat.x * x2, yy = aQuat.y * y2, zz = aQuat.z * z2;
+	float const xy = aQuat.x * y2, xz = aQuat.x * z2, yz = aQuat.y * z2;
+	float const wx = aQuat.w * x2, wy = aQuat.w * y2, wz = aQuat.w * z2;
+
+	return { {
+		1.f - (yy + zz), xy - wz,         xz + wy,         0.f,
+		xy + wz,         1.f - (xx + zz), yz - wx,         0.f,
+		xz - wy,         yz + wx,         1.f - (xx + yy), 0.f,
+		0.f,             0.f,             0.f,             1.f
+	} };
+}
+
+
+// Normalized linear interpolation. Cheap, but the angular speed is not
+// constant; fine for small steps or when only the end points matter.
+inline
+Quatf nlerp( Quatf aFrom, Quatf aTo, float aT ) noexcept
+{
+	if (dot(aFrom, aTo) < 0.f) aTo = -aTo;
+	return normalize( (1.f - aT) * aFrom + aT * aTo );
+}
+
+// Spherical linear interpolation: constant angular speed along the shorter
+// arc from aFrom to aTo.
+inline
+Quatf slerp( Quatf aFrom, Quatf aTo, float aT ) noexcept
+{
+	float cosAngle = dot(aFrom, aTo);
+	if (cosAngle < 0.f)
+	{
+		aTo = -aTo;
+		cosAngle = -cosAngle;
+	}
+
+	// nearly equal: sin(angle) is too small to divide by, and the arc is
+	// so short that nlerp() is just as good
+	if (cosAngle > 0.9995f)
+	{
+		return normalize( (1.f - aT) * aFrom + aT * aTo );
+	}
+
+	float const angle = std::acos(cosAngle);
+	float const inverseSin = 1.f / std::sin(angle);
+	return (std::sin((1.f - aT) * angle) * inverseSin) * aFrom
+		+ (std::sin(aT * angle) * inverseSin) * aTo;
+}
+
+#endif // QUAT_HPP_3C0E58A1_92D4_4B7E_8F16_0D5A2B64E9C7
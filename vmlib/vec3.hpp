@@ -151,7 +151,7 @@ float length( Vec3f aVec ) noexcept
 	return std::sqrt( dot( aVec, aVec ) );
 }
 
-constexpr
+inline
 Vec3f normalize( Vec3f aVector ) noexcept
 {
 	return aVector / length(aVector);